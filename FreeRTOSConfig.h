@@ -48,13 +48,17 @@
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES		( 4 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) 1024 )
 #define configMAX_TASK_NAME_LEN		( 8 )
 #define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 #define configQUEUE_REGISTRY_SIZE 	0
 
+/* Stop with interrupts off when an assertion fails, so a debugger attached
+to the board shows where. */
+#define configASSERT( x )	if( ( x ) == 0 ) { portDISABLE_INTERRUPTS(); for( ;; ); }
+
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -67,12 +71,73 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
 #define configUSE_EDF_SCHEDULER			1
+/* The periods and deadlines of the tasks are fixed at compile time, see
+edf_task_set.h. Set to 0 to change them at run time. */
+#define configUSE_EDF_STATIC_TASK_SET		1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 1
 #define configUSE_APPLICATION_TASK_TAG  1
 
+/* TCBs and stacks of dynamically created tasks come from fixed size slabs
+instead of the heap. Sized for what main.c creates: six tasks with 100 word
+stacks and the idle task (configMINIMAL_STACK_SIZE words). No task needs a
+deeper stack, so the large stack slab is empty. Messages go through the
+static ring and pool in main.c, so the heap above only holds the UART transmit
+stream buffer, about 300 bytes with its header for UART_TX_BUFFER_SIZE 256, and
+with MESSAGE_BENCHMARK set the queue it is timed against, about 120 more. 1K
+leaves room for a larger UART buffer. */
+#define configUSE_TASK_SLAB_ALLOCATOR			1
+#define configTASK_SLAB_TCBS							7
+#define configTASK_SLAB_SMALL_STACK_DEPTH	100
+#define configTASK_SLAB_SMALL_STACKS			7
+#define configTASK_SLAB_LARGE_STACK_DEPTH	200
+#define configTASK_SLAB_LARGE_STACKS			0
+
+/* Keep log-linear response time and start jitter histograms for each EDF
+task, in ticks. The LPC2129 has 16K of RAM. With the settings in this file
+tasks.c takes about 5.5K of it, most of that the slabs above, main.c about
+1.1K and the heap 1K, which leaves the rest for the port, the C library and the
+interrupt stacks. Each histogram costs configJOB_HISTOGRAM_BUCKETS words in
+every TCB, so setting this to 1 adds 208 bytes per slab TCB, about 1.5K for
+the seven above. Cut configJOB_HISTOGRAM_BUCKETS or the slabs first. */
+#define configUSE_JOB_HISTOGRAMS					0
+#define configJOB_HISTOGRAM_SUB_BUCKET_BITS	2
+#define configJOB_HISTOGRAM_BUCKETS				24
+
+/* Set to 1 to send every completed job over the UART in place of the task
+table, for tools/edf_analyzer.c. The kernel then keeps the last
+configJOB_TRACE_LENGTH jobs, with their execution times, until main.c sends
+them. The ring costs about 28 bytes a job, so it is only kept when it is sent. */
+#define JOB_TRACE_OUTPUT							0
+#if ( JOB_TRACE_OUTPUT == 1 )
+	#define configJOB_TRACE_LENGTH					16
+#else
+	#define configJOB_TRACE_LENGTH					0
+#endif
+
+/* Set to 1 to time each phase of a context switch, see
+vTaskGetSwitchProfile(). Timer 0 drives the tick and counts PCLK, which is
+the CPU clock as VPBDIV is set to 1, and restarts on each tick match.
+The LPC2000 port does not call vTaskProfilePortSample(), so eTaskSwitchPort
+stays empty on the board. Its portRESTORE_CONTEXT() returns straight into the
+task, so the most it could time is the save: read T0TC before
+portSAVE_CONTEXT() in vPortYieldProcessor() and vPreemptiveTick(), and pass
+the counts since then, allowing for the restart of the timer, to
+vTaskProfilePortSample() just before portRESTORE_CONTEXT(). */
+#define configUSE_SWITCH_PROFILER					0
+#define portPROFILER_GET_CYCLES()					(T0TC)
+#define configPROFILER_COUNTER_PERIOD			(T0MR0 + 1UL)
+
 #define configGENERATE_RUN_TIME_STATS 1
+/* Timer 1 is 32 bits and wraps in under a day, so main.c extends it to 64 bits
+in software. Task run times, the idle percentage and release latencies all use
+the extended count. */
+#define configRUN_TIME_COUNTER_TYPE				uint64_t
+extern uint64_t ullGetRunTimeCounterValue( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	
-#define portGET_RUN_TIME_COUNTER_VALUE()	(T1TC)
+#define portGET_RUN_TIME_COUNTER_VALUE()	ullGetRunTimeCounterValue()
+/* Timer 1 counts PCLK divided by T1PR + 1, see configTimer1() in main.c. Used
+by load_generator.c to turn counts into microseconds. */
+#define configRUN_TIME_COUNTER_HZ			( configCPU_CLOCK_HZ / 1001UL )
 /*-----------------------------------------------------------*/
 
 /*Set Tasks IDs*/
@@ -93,18 +158,22 @@ to exclude the API function. */
 #define B1_TRACE_PIN                 	PIN8
 #define B2_TRACE_PIN                 	PIN9
 
-/*extern tasks time variables*/
-extern unsigned int LD1_InTime,		LD1_OutTime,	LD1_TotalTime;
-extern unsigned int LD2_InTime,		LD2_OutTime,	LD2_TotalTime;
-extern unsigned int B1_InTime,		B1_OutTime,		B1_TotalTime;
-extern unsigned int B2_InTime,		B2_OutTime,		B2_TotalTime;
-extern unsigned int PeriodicTransmitter_InTime,	PeriodicTransmitter_OutTime,	PeriodicTransmitter_TotalTime;
-extern unsigned int Uart_Receiver_InTime,				Uart_Receiver_OutTime,				Uart_Receiver_TotalTime;
-extern unsigned int totalExecution,							totalTime;
+/*extern tasks time variables, in extended timer 1 counts*/
+extern uint64_t LD1_InTime,		LD1_OutTime,	LD1_TotalTime;
+extern uint64_t LD2_InTime,		LD2_OutTime,	LD2_TotalTime;
+extern uint64_t B1_InTime,		B1_OutTime,		B1_TotalTime;
+extern uint64_t B2_InTime,		B2_OutTime,		B2_TotalTime;
+extern uint64_t PeriodicTransmitter_InTime,	PeriodicTransmitter_OutTime,	PeriodicTransmitter_TotalTime;
+extern uint64_t Uart_Receiver_InTime,				Uart_Receiver_OutTime,				Uart_Receiver_TotalTime;
+extern uint64_t totalExecution,							totalTime;
 extern float CPU_Load;
 
 /*-----------------------------------------------------------*/
 
+/* The kernel reads the run time counter into ulTotalRunTime once per context
+switch, before either hook runs, so both hooks reuse it. The switched out hook
+only adds the time the task ran to its total and to totalExecution; the
+Uart_Receiver task turns those into CPU_Load, away from the switch path. */
 #define traceTASK_SWITCHED_IN() do\
 {\
 			if(TASK_ID ==0)\
@@ -114,32 +183,32 @@ extern float CPU_Load;
 			else if(TASK_ID ==LD1_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,LD1_TRACE_PIN,PIN_IS_HIGH);\
-					LD1_InTime=T1TC;\
+					LD1_InTime=ulTotalRunTime;\
 			}\
 			else if(TASK_ID ==LD2_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,LD2_TRACE_PIN,PIN_IS_HIGH);\
-					LD2_InTime=T1TC;\
+					LD2_InTime=ulTotalRunTime;\
 			}\
 			else if(TASK_ID ==B1_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,B1_TRACE_PIN,PIN_IS_HIGH);\
-					B1_InTime=T1TC;\
+					B1_InTime=ulTotalRunTime;\
 			}\
 			else if(TASK_ID ==B2_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,B2_TRACE_PIN,PIN_IS_HIGH);\
-					B2_InTime=T1TC;\
+					B2_InTime=ulTotalRunTime;\
 			}\
 			else if(TASK_ID ==TRANSMITTER_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,TRANSMIT_TRACE_PIN,PIN_IS_HIGH);\
-					PeriodicTransmitter_InTime=T1TC;\
+					PeriodicTransmitter_InTime=ulTotalRunTime;\
 			}\
 			else if(TASK_ID ==UARTRECIEVER_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,UART_TRACE_PIN,PIN_IS_HIGH);\
-					Uart_Receiver_InTime=T1TC;\
+					Uart_Receiver_InTime=ulTotalRunTime;\
 			}\
 }while(0)
 
@@ -153,42 +222,46 @@ extern float CPU_Load;
 			else if(TASK_ID ==LD1_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,LD1_TRACE_PIN,PIN_IS_LOW);\
-					LD1_OutTime=T1TC;\
+					LD1_OutTime=ulTotalRunTime;\
 					LD1_TotalTime+=(LD1_OutTime-LD1_InTime);\
+					totalExecution+=(LD1_OutTime-LD1_InTime);\
 			}\
 			else if(TASK_ID ==LD2_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,LD2_TRACE_PIN,PIN_IS_LOW);\
-					LD2_OutTime=T1TC;\
+					LD2_OutTime=ulTotalRunTime;\
 					LD2_TotalTime+=(LD2_OutTime-LD2_InTime);\
+					totalExecution+=(LD2_OutTime-LD2_InTime);\
 			}\
 			else if(TASK_ID ==B1_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,B1_TRACE_PIN,PIN_IS_LOW);\
-					B1_OutTime=T1TC;\
+					B1_OutTime=ulTotalRunTime;\
 					B1_TotalTime+=(B1_OutTime-B1_InTime);\
+					totalExecution+=(B1_OutTime-B1_InTime);\
 			}\
 			else if(TASK_ID ==B2_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,B2_TRACE_PIN,PIN_IS_LOW);\
-					B2_OutTime=T1TC;\
+					B2_OutTime=ulTotalRunTime;\
 					B2_TotalTime+=(B2_OutTime-B2_InTime);\
+					totalExecution+=(B2_OutTime-B2_InTime);\
 			}\
 			else if(TASK_ID ==TRANSMITTER_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,TRANSMIT_TRACE_PIN,PIN_IS_LOW);\
-					PeriodicTransmitter_OutTime=T1TC;\
+					PeriodicTransmitter_OutTime=ulTotalRunTime;\
 					PeriodicTransmitter_TotalTime+=(PeriodicTransmitter_OutTime-PeriodicTransmitter_InTime);\
+					totalExecution+=(PeriodicTransmitter_OutTime-PeriodicTransmitter_InTime);\
 			}\
 			else if(TASK_ID ==UARTRECIEVER_TASK_ID)\
 			{\
 					GPIO_write(PORT_0,UART_TRACE_PIN,PIN_IS_LOW);\
-					Uart_Receiver_OutTime=T1TC;\
+					Uart_Receiver_OutTime=ulTotalRunTime;\
 					Uart_Receiver_TotalTime+=(Uart_Receiver_OutTime-Uart_Receiver_InTime);\
+					totalExecution+=(Uart_Receiver_OutTime-Uart_Receiver_InTime);\
 			}\
-			totalExecution=(LD1_TotalTime+LD2_TotalTime+B1_TotalTime+B2_TotalTime+PeriodicTransmitter_TotalTime+Uart_Receiver_TotalTime);\
-			totalTime=T1TC;\
-			CPU_Load=(float)(totalExecution)/(float)totalTime*100;\
+			totalTime=ulTotalRunTime;\
 }while(0)
 
 #endif /* FREERTOS_CONFIG_H */
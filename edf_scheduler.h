@@ -0,0 +1,1007 @@
+/*
+ * EDF scheduler extensions to the FreeRTOS task API.
+ *
+ * xPeriodicTaskCreate() is declared in task.h next to xTaskCreate().  The
+ * functions below build on it and are only available when
+ * configUSE_EDF_SCHEDULER is set to 1 in FreeRTOSConfig.h.  The task slab
+ * allocator statistics are only available when configUSE_TASK_SLAB_ALLOCATOR
+ * is set to 1, and the job histograms when configUSE_JOB_HISTOGRAMS is also
+ * set to 1.  The job trace needs configJOB_TRACE_LENGTH to be more than 0,
+ * and the context switch profile configUSE_SWITCH_PROFILER set to 1.
+ */
+
+#ifndef EDF_SCHEDULER_H
+#define EDF_SCHEDULER_H
+
+#ifndef INC_TASK_H
+#error "include task.h must appear in source files before include edf_scheduler.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if (configUSE_EDF_SCHEDULER == 1)
+
+/* The task set is only fixed at compile time if enabled in FreeRTOSConfig.h.
+ * Every periodic and sporadic task must then be listed in edf_task_set.h and
+ * be created in the order and with the timing given there, or it is not
+ * created and the scheduler does not start.  The functions that change the
+ * timing of a task after it is created, or the set of tasks (xTaskSetPeriod(),
+ * xTaskSetRelativeDeadline(), xTaskSetElastic(), xTaskSetCriticality() and
+ * xTaskModeChange()), are not available. */
+#ifndef configUSE_EDF_STATIC_TASK_SET
+#define configUSE_EDF_STATIC_TASK_SET 0
+#endif
+
+/**
+ * BaseType_t xPeriodicTaskCreateWithOffset( TaskFunction_t pxTaskCode,
+ *                                           const char * const pcName,
+ *                                           const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                           void * const pvParameters,
+ *                                           UBaseType_t uxPriority,
+ *                                           TaskHandle_t * const pxCreatedTask,
+ *                                           TickType_t period,
+ *                                           TickType_t offset );
+ *
+ * Create a periodic EDF task whose first job is released offset ticks after
+ * the task is created (after the scheduler is started for tasks created
+ * before vTaskStartScheduler()).  Until then the task is held in the Blocked
+ * state.  offset must be less than period.
+ *
+ * xPeriodicTaskCreate() is the same as calling this function with an offset
+ * of 0.
+ *
+ * @return pdPASS if the task was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ */
+BaseType_t xPeriodicTaskCreateWithOffset(TaskFunction_t pxTaskCode,
+                                         const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                         const configSTACK_DEPTH_TYPE usStackDepth,
+                                         void *const pvParameters,
+                                         UBaseType_t uxPriority,
+                                         TaskHandle_t *const pxCreatedTask,
+                                         TickType_t period,
+                                         TickType_t offset) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTaskComputeReleaseOffsets( const TickType_t * const pxPeriods,
+ *                                        TickType_t * const pxOffsets,
+ *                                        const UBaseType_t uxNumberOfTasks,
+ *                                        uint8_t * const pucReleaseCount,
+ *                                        const TickType_t xReleaseCountLength );
+ *
+ * Choose a release offset for each of uxNumberOfTasks periodic tasks so the
+ * peak number of jobs released on the same tick is kept low, instead of
+ * every task being released together at tick 0.  Tasks are placed greedily,
+ * shortest period first, and each offset is less than the task's period.
+ *
+ * pucReleaseCount is a work buffer used to count releases over one
+ * hyperperiod (the least common multiple of the periods), so it must be at
+ * least that many bytes long.  This function does not access any kernel
+ * state and can be called before the scheduler is started.
+ *
+ * @param pxPeriods The period of each task, in ticks.
+ *
+ * @param pxOffsets Array of uxNumberOfTasks entries the offsets are written
+ * to, in the same order as pxPeriods.
+ *
+ * @return pdPASS if the offsets were computed.  pdFAIL if the hyperperiod is
+ * longer than xReleaseCountLength, in which case every offset is set to 0.
+ */
+BaseType_t xTaskComputeReleaseOffsets(const TickType_t *const pxPeriods,
+                                      TickType_t *const pxOffsets,
+                                      const UBaseType_t uxNumberOfTasks,
+                                      uint8_t *const pucReleaseCount,
+                                      const TickType_t xReleaseCountLength) PRIVILEGED_FUNCTION;
+
+#if (INCLUDE_vTaskSuspend == 1)
+
+/**
+ * BaseType_t xSporadicTaskCreate( TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask,
+ *                                 TickType_t xMinInterArrivalTime,
+ *                                 TickType_t xRelativeDeadline );
+ *
+ * Create a sporadic EDF task.  Instead of being released every period, a job
+ * of the task is released each time xTaskReleaseSporadic() or
+ * xTaskReleaseSporadicFromISR() is called, and must complete within
+ * xRelativeDeadline ticks of that release.  The task does not run until its
+ * first release.
+ *
+ * Releases are never closer together than xMinInterArrivalTime ticks: a
+ * release that arrives earlier is deferred by the kernel until the minimum
+ * inter-arrival time has elapsed, so the task can be accounted for like a
+ * periodic task of period xMinInterArrivalTime.
+ *
+ * The task calls xTaskWaitForRelease() at the end of each job:
+ * @code{c}
+ * void vSporadicTask( void * pvParameters )
+ * {
+ *     for( ;; )
+ *     {
+ *         // Serve the event that released this job.
+ *
+ *         xTaskWaitForRelease();
+ *     }
+ * }
+ * @endcode
+ *
+ * @return pdPASS if the task was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ */
+BaseType_t xSporadicTaskCreate(TaskFunction_t pxTaskCode,
+                               const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                               const configSTACK_DEPTH_TYPE usStackDepth,
+                               void *const pvParameters,
+                               UBaseType_t uxPriority,
+                               TaskHandle_t *const pxCreatedTask,
+                               TickType_t xMinInterArrivalTime,
+                               TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTaskWaitForRelease( void );
+ *
+ * Called by a sporadic task to complete its current job and wait in the
+ * Blocked state for the next release.  If releases arrived while the job was
+ * running the next one is served straight away, subject to the minimum
+ * inter-arrival time.
+ *
+ * @return pdPASS when a new job has been released.  pdFAIL if the wait was
+ * ended without a release, for example by vTaskSuspend() followed by
+ * vTaskResume(), or by xTaskAbortDelay().
+ */
+BaseType_t xTaskWaitForRelease(void) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTaskReleaseSporadic( TaskHandle_t xTask );
+ *
+ * Release a job of the sporadic task xTask.  The deadline of the job is
+ * xRelativeDeadline ticks after the tick on which it is actually released.
+ *
+ * @return pdPASS if the release was accepted.  pdFAIL if it was dropped
+ * because too many releases are already waiting to be served.
+ */
+BaseType_t xTaskReleaseSporadic(TaskHandle_t xTask) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTask,
+ *                                         BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * A version of xTaskReleaseSporadic() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the released job has an
+ * earlier deadline than the task that was running when the interrupt
+ * occurred, in which case a context switch should be requested before the
+ * interrupt is exited.
+ */
+BaseType_t xTaskReleaseSporadicFromISR(TaskHandle_t xTask,
+                                       BaseType_t *pxHigherPriorityTaskWoken) PRIVILEGED_FUNCTION;
+
+#endif /* INCLUDE_vTaskSuspend */
+
+#if (INCLUDE_xTaskResumeFromISR == 1) && (INCLUDE_vTaskSuspend == 1)
+
+/**
+ * BaseType_t xTaskReleaseJobFromISR( TaskHandle_t xTaskToRelease,
+ *                                    TickType_t xRelativeDeadline );
+ *
+ * Release a job of a task that is in the Suspended state from an interrupt,
+ * with a deadline xRelativeDeadline ticks after the current tick.  The job is
+ * inserted into the EDF ready list at the position of that deadline.  The
+ * period and relative deadline the task was created with are not changed.
+ *
+ * This is intended for deferred interrupt handling: the handler task calls
+ * vTaskSuspend( NULL ) at the end of each job and the interrupt releases the
+ * next one.  If the task is not suspended (its previous job has not
+ * finished) the release has no effect.  If the scheduler is suspended the
+ * task is held in the pending ready list with its deadline until the
+ * scheduler is resumed.
+ *
+ * @return pdTRUE if the released job has an earlier deadline than the job
+ * of the interrupted task, in which case a context switch should be
+ * requested with portYIELD_FROM_ISR() before the interrupt is exited,
+ * otherwise pdFALSE.
+ */
+BaseType_t xTaskReleaseJobFromISR(TaskHandle_t xTaskToRelease,
+                                  TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
+
+#endif /* ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) */
+
+/**
+ * BaseType_t xTaskSetWCET( TaskHandle_t xTask, TickType_t xWCET );
+ *
+ * Set the worst case execution time of a job of xTask, in ticks, and admit
+ * the task's share of the processor: xWCET divided by the shorter of its
+ * period and relative deadline.  The new WCET is only accepted if the shares
+ * of all tasks still add up to no more than the whole processor, the
+ * sufficient EDF schedulability test for such task sets.  Once HI criticality
+ * tasks exist the bound is the EDF-VD limit instead, see
+ * xTaskSetCriticality().
+ *
+ * Tasks start with a WCET of 0, which admits no share at all.  Passing NULL
+ * as xTask sets the WCET of the calling task.  The budgets of a HI task are
+ * set with xTaskSetCriticality() only.
+ *
+ * @return pdPASS if the WCET was accepted, pdFAIL if it would make the task
+ * set unschedulable or xTask is a HI task, in which case the old WCET is kept.
+ */
+BaseType_t xTaskSetWCET(TaskHandle_t xTask,
+                        TickType_t xWCET) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulTaskGetTotalUtilisation( void );
+ *
+ * @return The sum of the admitted shares of all tasks, in 16.16 fixed point
+ * (0x10000 is the whole processor).
+ */
+uint32_t ulTaskGetTotalUtilisation(void) PRIVILEGED_FUNCTION;
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+
+/**
+ * BaseType_t xTaskSetPeriod( TaskHandle_t xTask, TickType_t xPeriod );
+ *
+ * Change the period (the minimum inter-arrival time of a sporadic task) of
+ * xTask.  If the relative deadline of xTask equals its period it is changed
+ * too.  The new timing applies from the next release: a job of xTask that is
+ * released but not yet complete keeps its deadline, and its next job is still
+ * released one old period after it.  The change is only made if the task set
+ * passes the admission test of xTaskSetWCET() with it.
+ *
+ * Periodic tasks only pick up a new period if they wait for their next release
+ * with xTaskDelayUntilNextPeriod() rather than a fixed vTaskDelayUntil()
+ * increment.  Passing NULL as xTask changes the calling task.
+ *
+ * @return pdPASS if the period was changed, pdFAIL if it would make the task
+ * set unschedulable or xTask is an elastic task (see xTaskSetElastic()) or a
+ * HI criticality task.
+ */
+BaseType_t xTaskSetPeriod(TaskHandle_t xTask,
+                          TickType_t xPeriod) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTaskSetRelativeDeadline( TaskHandle_t xTask,
+ *                                      TickType_t xRelativeDeadline );
+ *
+ * Change the relative deadline of xTask.  A job of xTask that is released but
+ * not yet complete keeps its deadline, later jobs are released with the new
+ * relative deadline.  The change is only made if the task set passes the
+ * admission test of xTaskSetWCET() with it.  Passing NULL as xTask changes the
+ * calling task.
+ *
+ * @return pdPASS if the deadline was changed, pdFAIL if it would make the task
+ * set unschedulable or xTask is an elastic or HI criticality task.
+ */
+BaseType_t xTaskSetRelativeDeadline(TaskHandle_t xTask,
+                                    TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+
+/**
+ * TickType_t xTaskGetPeriod( TaskHandle_t xTask );
+ * TickType_t xTaskGetRelativeDeadline( TaskHandle_t xTask );
+ *
+ * @return The period or the relative deadline of xTask, in ticks, including a
+ * change that only applies from its next release.  Passing NULL as xTask
+ * queries the calling task.
+ */
+TickType_t xTaskGetPeriod(TaskHandle_t xTask) PRIVILEGED_FUNCTION;
+TickType_t xTaskGetRelativeDeadline(TaskHandle_t xTask) PRIVILEGED_FUNCTION;
+
+/* Used to pass information about the elastic tasks out of
+ * vTaskGetElasticStats().  Utilisations are in the 16.16 fixed point format
+ * of ulTaskGetTotalUtilisation(). */
+typedef struct xELASTIC_STATS
+{
+    uint32_t ulTargetUtilisation;  /* The utilisation the periods are compressed to fit, see vTaskSetElasticTarget(). */
+    uint32_t ulElasticUtilisation; /* The utilisation of the elastic tasks at their current periods. */
+    UBaseType_t uxElasticTasks;    /* The number of elastic tasks. */
+    UBaseType_t uxSaturatedTasks;  /* Elastic tasks stretched to their longest period, or with no elasticity. */
+    UBaseType_t uxLastPasses;      /* Passes over the elastic tasks the last compression took. */
+    uint32_t ulCompressions;       /* The number of times the elastic periods have been recomputed. */
+} ElasticStats_t;
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+
+/**
+ * BaseType_t xTaskSetElastic( TaskHandle_t xTask,
+ *                             TickType_t xMinPeriod,
+ *                             TickType_t xMaxPeriod,
+ *                             UBaseType_t uxElasticity );
+ *
+ * Make xTask an elastic task: the kernel chooses its period between
+ * xMinPeriod, its nominal period, and xMaxPeriod.  Elastic tasks are admitted
+ * at their longest period.  Whenever the admitted task set changes (through
+ * this function, xTaskSetWCET() or xTaskModeChange()) the utilisation the
+ * other tasks leave below the target of vTaskSetElasticTarget() is shared
+ * between the elastic tasks.  If it is not enough to run them all at their
+ * nominal periods, each gives up utilisation in proportion to uxElasticity,
+ * never stretching beyond its longest period (Buttazzo's elastic task model).
+ * A task with an uxElasticity of 0 always runs at xMinPeriod.
+ *
+ * Periods and relative deadlines of elastic tasks are kept equal and are
+ * changed as by xTaskSetPeriod(), which can no longer be used on them.
+ * Compression takes a bounded number of passes over the elastic tasks, at
+ * most one more than there are elastic tasks, and always runs in the context
+ * of the calling task with the scheduler suspended.  Set the WCET of xTask
+ * first.  Passing NULL as xTask makes the calling task elastic.
+ *
+ * @return pdPASS if the task was made elastic, pdFAIL if even at xMaxPeriod
+ * it would make the task set unschedulable, or xTask is a HI criticality task.
+ */
+BaseType_t xTaskSetElastic(TaskHandle_t xTask,
+                           TickType_t xMinPeriod,
+                           TickType_t xMaxPeriod,
+                           UBaseType_t uxElasticity) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+
+/**
+ * void vTaskSetElasticTarget( uint32_t ulTargetUtilisation );
+ *
+ * Set the total utilisation, 16.16 fixed point and at most 0x10000, that the
+ * elastic tasks are compressed to fit, and recompute their periods.  The
+ * default is 0x10000: the whole processor.
+ */
+void vTaskSetElasticTarget(uint32_t ulTargetUtilisation) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskElasticUpdate( void );
+ *
+ * Recompute the periods of the elastic tasks.  Deleting a task does not do
+ * this itself, call it to hand the utilisation that was freed back to the
+ * elastic tasks.
+ */
+void vTaskElasticUpdate(void) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetElasticStats( ElasticStats_t * const pxElasticStats );
+ *
+ * Fill *pxElasticStats with the state of the elastic tasks.  The current
+ * period of each is returned by xTaskGetPeriod().
+ */
+void vTaskGetElasticStats(ElasticStats_t *const pxElasticStats) PRIVILEGED_FUNCTION;
+
+/* Used to pass the job accounting of a task out of vTaskGetJobStats().  A job
+ * completes when the task calls vTaskDelayUntil() or xTaskWaitForRelease(). */
+typedef struct xTASK_JOB_STATS
+{
+    uint32_t ulJobsCompleted;  /* Jobs that ran to completion, on time or late. */
+    uint32_t ulJobsSkipped;    /* Jobs of an (m,k)-firm task that were never released. */
+    uint32_t ulDeadlineMisses; /* Completed jobs that finished after their deadline, not the virtual deadline of a HI task in LO mode. */
+    uint32_t ulFirmFailures;   /* Jobs that left fewer than m of the last k jobs on time. */
+    uint32_t ulJobHistory;     /* One bit per job, the latest in bit 0: set if it met its deadline, clear if it was late or skipped. */
+    TickType_t xLastLateness;  /* Ticks the last late job finished after its deadline. */
+    TickType_t xMaxLateness;   /* The largest xLastLateness. */
+} TaskJobStats_t;
+
+/* The largest window of an (m,k)-firm constraint, the width of ulJobHistory. */
+#define taskEDF_FIRM_MAX_WINDOW (32U)
+
+/**
+ * BaseType_t xTaskSetFirmConstraint( TaskHandle_t xTask,
+ *                                    UBaseType_t uxM,
+ *                                    UBaseType_t uxK );
+ *
+ * Make the periodic task xTask (m,k)-firm: of any uxK consecutive jobs, the
+ * kernel may skip up to uxK - uxM.  When a job of xTask is due while the EDF
+ * ready queue is overloaded, and skipping it stays within that budget, the job
+ * is never released: xTask stays blocked until its next period and the skip is
+ * recorded in its job history.  This sheds the load of soft tasks during a
+ * transient overload, so that hard tasks keep their deadlines.
+ *
+ * The queue is taken to be overloaded when a ready job is already late, when a
+ * job of any task missed its deadline during the last period of xTask, or when
+ * the WCETs (see xTaskSetWCET()) of the ready jobs due no later than the new
+ * job, plus its own, do not fit before its deadline.  The test runs in the
+ * tick interrupt, so it gives up and takes the queue to be overloaded once it
+ * has looked at configFIRM_OVERLOAD_SCAN_LIMIT (default 8) other ready jobs.
+ * Jobs of xTask that are already due when its previous job completes are
+ * skipped in the same way.
+ * Those that are not are released with the deadline of their release time.
+ *
+ * xTask must wait for its next release with xTaskDelayUntilNextPeriod() or
+ * vTaskDelayUntil(), which move the wake time past skipped jobs.  uxM equal to
+ * uxK turns skipping off.  Passing NULL as xTask changes the calling task.
+ *
+ * @return pdPASS, or pdFAIL if uxM is 0, uxM is more than uxK, uxK is more
+ * than taskEDF_FIRM_MAX_WINDOW or xTask is a sporadic task.
+ */
+BaseType_t xTaskSetFirmConstraint(TaskHandle_t xTask,
+                                  UBaseType_t uxM,
+                                  UBaseType_t uxK) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetJobStats( TaskHandle_t xTask,
+ *                        TaskJobStats_t * const pxJobStats );
+ *
+ * Fill *pxJobStats with the job accounting of xTask.  Passing NULL as xTask
+ * queries the calling task.
+ */
+void vTaskGetJobStats(TaskHandle_t xTask,
+                      TaskJobStats_t *const pxJobStats) PRIVILEGED_FUNCTION;
+
+/* Criticality of a task, and the criticality mode of the system. */
+typedef enum
+{
+    eTaskCriticalityLO = 0, /* Jobs may be dropped to keep the HI tasks on time. */
+    eTaskCriticalityHI      /* Safety tasks, with a second, pessimistic WCET. */
+} eTaskCriticality;
+
+/* Used to pass information about mixed criticality scheduling out of
+ * vTaskGetCriticalityStats().  Utilisations are in the 16.16 fixed point
+ * format of ulTaskGetTotalUtilisation(). */
+typedef struct xCRITICALITY_STATS
+{
+    eTaskCriticality eMode;           /* The current criticality mode. */
+    uint32_t ulVirtualDeadlineFactor; /* In LO mode HI tasks run to their relative deadline scaled by this. */
+    uint32_t ulUtilisationLimit;      /* The most total utilisation, at LO mode WCETs, that can be admitted. */
+    uint32_t ulSwitchesToHI;          /* The number of HI task budget overruns that switched to HI mode. */
+    uint32_t ulReturnsToLO;           /* The number of switches back to LO mode. */
+    uint32_t ulDroppedJobs;           /* LO jobs dropped in HI mode. */
+    TickType_t xLastSwitchTime;       /* When the mode last changed. */
+} CriticalityStats_t;
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+
+/**
+ * BaseType_t xTaskSetCriticality( TaskHandle_t xTask,
+ *                                 eTaskCriticality eCriticality,
+ *                                 TickType_t xWCETLO,
+ *                                 TickType_t xWCETHI );
+ *
+ * Set the criticality of xTask and its WCETs, and admit it with the EDF-VD
+ * test.  xWCETLO replaces the WCET set by xTaskSetWCET().  A HI task also has
+ * xWCETHI, a more pessimistic WCET that is at least xWCETLO; it is ignored for
+ * a LO task.
+ *
+ * The system starts in LO mode, where every job is expected to complete
+ * within its LO mode WCET and HI tasks are scheduled by virtual deadlines:
+ * their relative deadlines scaled by a factor below 1 that the kernel derives
+ * from the utilisations of the HI tasks.  The kernel counts the ticks each job
+ * runs for.  When a HI job runs past its LO mode WCET the system switches to
+ * HI mode: HI jobs get their real deadlines back and LO jobs are dropped, they
+ * do not run until the processor next idles, when the system returns to LO
+ * mode and releases the dropped jobs again.
+ *
+ * The admission test keeps the HI tasks on time in both modes, with the LO
+ * tasks admitted at their LO mode WCETs only, so more LO work fits than if
+ * every task were admitted at its pessimistic WCET.  Elastic tasks are always
+ * LO.  Once a task is HI its WCETs are only changed by this function, and its
+ * period and relative deadline cannot be changed.  Passing NULL as xTask sets
+ * the calling task.
+ *
+ * @return pdPASS if the criticality was set, pdFAIL if the task set would not
+ * be schedulable, xTask is an elastic task, or the WCETs of a HI task are 0 or
+ * in the wrong order.
+ */
+BaseType_t xTaskSetCriticality(TaskHandle_t xTask,
+                               eTaskCriticality eCriticality,
+                               TickType_t xWCETLO,
+                               TickType_t xWCETHI) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+
+/**
+ * eTaskCriticality eTaskGetCriticalityMode( void );
+ *
+ * @return The current criticality mode of the system.
+ */
+eTaskCriticality eTaskGetCriticalityMode(void) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetCriticalityStats( CriticalityStats_t * const pxCriticalityStats );
+ *
+ * Fill *pxCriticalityStats with the state of mixed criticality scheduling.
+ */
+void vTaskGetCriticalityStats(CriticalityStats_t *const pxCriticalityStats) PRIVILEGED_FUNCTION;
+
+/* Background work queued with xTaskRunInSlack(). */
+typedef void (*TaskSlackFunction_t)(void *pvParameter);
+
+/* Used to pass information about slack stealing out of
+ * vTaskGetSlackStats(). */
+typedef struct xSLACK_STATS
+{
+    UBaseType_t uxWaiting;   /* Work items queued and not yet started. */
+    uint32_t ulItemsRun;     /* Work items that have completed. */
+    uint32_t ulItemsRefused; /* Calls to xTaskRunInSlack() that found the queue full. */
+    uint32_t ulGrants;       /* Times enough slack was found to run an item ahead of the jobs. */
+    uint32_t ulTicksStolen;  /* Ticks work items ran for ahead of the jobs. */
+    uint32_t ulOverruns;     /* Items still running when the slack granted to them ran out. */
+    TickType_t xLastSlack;   /* The slack found by the last computation, in ticks. */
+} SlackStats_t;
+
+/**
+ * BaseType_t xTaskRunInSlack( TaskSlackFunction_t pxFunction,
+ *                             void *pvParameter,
+ *                             TickType_t xCost );
+ *
+ * Queue pxFunction( pvParameter ) to be run by the idle task as best effort
+ * background work, for example flushing a log or formatting statistics.
+ * Items are run one at a time, in the order they were queued.
+ *
+ * An item does not wait for the processor to go idle.  While jobs are ready
+ * the kernel computes the slack of the EDF schedule on each tick: how many
+ * ticks of work can run ahead of every ready and future job, up to the
+ * deadline of the next job of every task, before any of them would miss its
+ * deadline at its WCET (see xTaskSetWCET()).  Once the slack covers xCost,
+ * the item runs straight away, ahead of all jobs, for up to xCost ticks.  An
+ * item that runs for longer carries on in the background, so the jobs are not
+ * delayed by more than the slack found.  Tasks with no WCET set are not
+ * accounted for, so their deadlines are not protected.  The computation
+ * checks the demand at no more than configSLACK_MAX_CHECKPOINTS (default 64)
+ * deadlines, which bounds its time in the tick interrupt.  A task set with
+ * more deadlines than that before the horizon is taken to have no slack.
+ *
+ * pxFunction runs in the context of the idle task, so like an idle hook it
+ * must never block.  The queue holds configSLACK_QUEUE_LENGTH items.
+ *
+ * @return pdPASS if the item was queued, pdFAIL if the queue is full.
+ */
+BaseType_t xTaskRunInSlack(TaskSlackFunction_t pxFunction,
+                           void *pvParameter,
+                           TickType_t xCost) PRIVILEGED_FUNCTION;
+
+/**
+ * TickType_t xTaskGetAvailableSlack( void );
+ *
+ * @return The number of ticks of work that could be run now, ahead of every
+ * job, without a job missing its deadline.  0 in HI criticality mode, or if
+ * the computation ran out of checkpoints, see xTaskRunInSlack().  Suspends
+ * the scheduler while it computes.
+ */
+TickType_t xTaskGetAvailableSlack(void) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetSlackStats( SlackStats_t * const pxSlackStats );
+ *
+ * Fill *pxSlackStats with the state of the slack stealing server.
+ */
+void vTaskGetSlackStats(SlackStats_t *const pxSlackStats) PRIVILEGED_FUNCTION;
+
+#if (INCLUDE_xTaskDelayUntil == 1)
+
+/**
+ * BaseType_t xTaskDelayUntilNextPeriod( TickType_t * const pxPreviousWakeTime );
+ *
+ * Complete the current job of a periodic task and wait for its next release:
+ * the same as calling vTaskDelayUntil() with the current period of the
+ * calling task as the increment.
+ *
+ * A task suspended while it waits and resumed after its next release does
+ * not catch up on the releases it missed: it waits for the next period
+ * boundary, or is released at once if vTaskResume() is called on one, and
+ * *pxPreviousWakeTime is moved on to that release when the job completes.  A
+ * task suspended while its job was running resumes that job, with its
+ * deadline.  Either way a resumed job only preempts the running one if its
+ * deadline is nearer.
+ *
+ * @return As xTaskDelayUntil().
+ */
+BaseType_t xTaskDelayUntilNextPeriod(TickType_t *const pxPreviousWakeTime) PRIVILEGED_FUNCTION;
+
+#endif /* INCLUDE_xTaskDelayUntil */
+
+#if (INCLUDE_vTaskDelete == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
+
+/* Describes one periodic task of the mode xTaskModeChange() switches to.  The
+ * first seven members are the parameters of xPeriodicTaskCreateWithOffset().
+ * pxCreatedTask must not be NULL: the handles are needed to leave the mode
+ * again. */
+typedef struct xEDF_TASK_PARAMETERS
+{
+    TaskFunction_t pxTaskCode;
+    const char *pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    configSTACK_DEPTH_TYPE usStackDepth;
+    void *pvParameters;
+    UBaseType_t uxPriority;
+    TaskHandle_t *pxCreatedTask;
+    TickType_t xPeriod;
+    TickType_t xOffset; /* First release, relative to the start of the mode.  Less than xPeriod. */
+    TickType_t xWCET;   /* As passed to xTaskSetWCET(). */
+} EDFTaskParameters_t;
+
+/* Used to pass information about the last mode change out of
+ * vTaskGetModeChangeStats().  All times are in ticks. */
+typedef struct xMODE_CHANGE_STATS
+{
+    TickType_t xRequestTime;     /* When xTaskModeChange() was called. */
+    TickType_t xReleaseTime;     /* When the new mode starts releasing jobs. */
+    TickType_t xRetiredTime;     /* When the last old task was deleted.  Only valid once uxRetiringTasks is 0. */
+    TickType_t xLastLatency;     /* xReleaseTime - xRequestTime. */
+    TickType_t xMaxLatency;      /* The largest xLastLatency of all mode changes. */
+    UBaseType_t uxRetiringTasks; /* Old tasks still completing their last job. */
+} ModeChangeStats_t;
+
+/**
+ * BaseType_t xTaskModeChange( const TaskHandle_t * const pxOldTasks,
+ *                             const UBaseType_t uxOldTasks,
+ *                             const EDFTaskParameters_t * const pxNewTasks,
+ *                             const UBaseType_t uxNewTasks,
+ *                             const BaseType_t xAbortOldJobs );
+ *
+ * Switch from one set of periodic tasks to another.  The uxOldTasks tasks in
+ * pxOldTasks are deleted and the uxNewTasks tasks described by pxNewTasks are
+ * created, as one step that no other task can observe half done.  Tasks in
+ * neither array are not affected.
+ *
+ * The mode change is only made if the new task set, together with the tasks
+ * that are not affected, passes the same admission test as xTaskSetWCET().
+ *
+ * If xAbortOldJobs is pdFALSE, old tasks whose job has completed are deleted
+ * at once and the others are deleted when their job completes (when they
+ * next call vTaskDelayUntil()).  The new mode starts at the latest deadline
+ * of those unfinished jobs, so the old and new tasks never compete for the
+ * processor and the switch takes no longer than the longest relative deadline
+ * of the old tasks.  If xAbortOldJobs is pdTRUE all old tasks are deleted at
+ * once and the new mode starts straight away.  Each new task releases its
+ * first job xOffset ticks after the start of the new mode.
+ *
+ * The calling task may be one of the old tasks.  Its job is never aborted
+ * before this function returns.  With xAbortOldJobs set to pdTRUE this
+ * function does not return to it.
+ *
+ * Only one mode change can be in progress at a time.
+ *
+ * @return pdPASS if the mode change was made.  pdFAIL if the new task set is
+ * not schedulable, or old tasks of the previous mode change are still
+ * completing their jobs.  errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if a new task
+ * could not be created.  Unless pdPASS is returned nothing was changed.
+ */
+BaseType_t xTaskModeChange(const TaskHandle_t *const pxOldTasks,
+                           const UBaseType_t uxOldTasks,
+                           const EDFTaskParameters_t *const pxNewTasks,
+                           const UBaseType_t uxNewTasks,
+                           const BaseType_t xAbortOldJobs) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetModeChangeStats( ModeChangeStats_t * const pxModeChangeStats );
+ *
+ * Fill *pxModeChangeStats with the timing of the last mode change.
+ */
+void vTaskGetModeChangeStats(ModeChangeStats_t *const pxModeChangeStats) PRIVILEGED_FUNCTION;
+
+#endif /* ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_STATIC_TASK_SET == 0 ) */
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+
+/**
+ * void vTaskGetReleaseLatency( TaskHandle_t xTask,
+ *                              configRUN_TIME_COUNTER_TYPE * const pulLastLatency,
+ *                              configRUN_TIME_COUNTER_TYPE * const pulMaxLatency );
+ *
+ * Retrieve the time, in run time counter units, from the release of a job of
+ * xTask by an event (xTaskReleaseJobFromISR() or a sporadic release) until
+ * xTask was switched in to run it.  Both the latency of the last such job and
+ * the largest latency seen are returned.  Either pointer can be NULL.
+ * Passing NULL as xTask queries the calling task.
+ */
+void vTaskGetReleaseLatency(TaskHandle_t xTask,
+                            configRUN_TIME_COUNTER_TYPE *const pulLastLatency,
+                            configRUN_TIME_COUNTER_TYPE *const pulMaxLatency) PRIVILEGED_FUNCTION;
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+#if (configUSE_TRACE_FACILITY == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0)
+
+/* Characters needed for the longest line xTaskStatsIteratorNext() writes,
+ * including the terminating null. */
+#define taskEDF_STATS_LINE_LENGTH (configMAX_TASK_NAME_LEN + 112U)
+
+/* Position of an xTaskStatsIteratorNext() walk over the task table.  Members
+ * should not be accessed directly. */
+typedef struct xTASK_STATS_ITERATOR
+{
+    UBaseType_t uxLastTaskNumber; /* The task number of the last row written. */
+    BaseType_t xHeaderWritten;
+} TaskStatsIterator_t;
+
+/**
+ * void vTaskStatsIteratorInit( TaskStatsIterator_t * const pxIterator );
+ *
+ * Start, or restart, a walk over the task table with pxIterator.
+ */
+void vTaskStatsIteratorInit(TaskStatsIterator_t *const pxIterator) PRIVILEGED_FUNCTION;
+
+/**
+ * size_t xTaskStatsIteratorNext( TaskStatsIterator_t * const pxIterator,
+ *                                char * const pcBuffer,
+ *                                size_t xBufferLength );
+ *
+ * Write the next line of the task table into pcBuffer, as a null terminated
+ * string.  The first call after vTaskStatsIteratorInit() writes the column
+ * headings, each later call one task: its name, state (as vTaskList()), period,
+ * the absolute deadline of its current job ('-' for the idle task and for a
+ * job dropped in HI criticality mode), the number of deadline misses, the
+ * lateness of the last late job and the largest lateness, all in ticks, then
+ * with configGENERATE_RUN_TIME_STATS the run time and its share of the total.
+ *
+ * Nothing is allocated and no other task is held up for longer than it takes
+ * to find one task, so a periodic job can send one line per release.  Tasks
+ * are visited in the order they were created; a task created or deleted
+ * during the walk is listed or left out, but no task is listed twice.
+ *
+ * A line is cut short if pcBuffer is shorter than
+ * taskEDF_STATS_LINE_LENGTH.
+ *
+ * @return The length of the line written, or 0 when every task has been
+ * listed.
+ */
+size_t xTaskStatsIteratorNext(TaskStatsIterator_t *const pxIterator,
+                              char *const pcBuffer,
+                              size_t xBufferLength) PRIVILEGED_FUNCTION;
+
+#endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+
+#if (configUSE_JOB_HISTOGRAMS == 1)
+
+/* Each power of two range of a histogram is split into
+ * 2^configJOB_HISTOGRAM_SUB_BUCKET_BITS buckets of equal width, so a bucket
+ * is never wider than that fraction of the values it holds.  Values below
+ * 2^configJOB_HISTOGRAM_SUB_BUCKET_BITS get a bucket each.  The last of the
+ * configJOB_HISTOGRAM_BUCKETS buckets also counts every value too large for
+ * the buckets before it. */
+#ifndef configJOB_HISTOGRAM_SUB_BUCKET_BITS
+#define configJOB_HISTOGRAM_SUB_BUCKET_BITS 2
+#endif
+
+#ifndef configJOB_HISTOGRAM_BUCKETS
+#define configJOB_HISTOGRAM_BUCKETS 24
+#endif
+
+/* The histograms kept for each EDF task, in ticks. */
+typedef enum
+{
+    eTaskHistogramResponse = 0, /* Release to completion time of each job. */
+    eTaskHistogramStart         /* Release to first switch in time of each job, its start jitter. */
+} eTaskHistogram;
+
+/* Used to pass a histogram out of vTaskGetHistogram(). */
+typedef struct xTASK_HISTOGRAM
+{
+    uint32_t ulSamples;                                /* The number of values recorded. */
+    TickType_t xMaxValue;                              /* The largest value recorded. */
+    uint32_t ulBuckets[configJOB_HISTOGRAM_BUCKETS];   /* The number of values recorded in each bucket. */
+} TaskHistogram_t;
+
+/* Longest line written by xTaskHistogramFormat(), with its terminating
+ * null. */
+#define taskEDF_HISTOGRAM_LINE_LENGTH (configMAX_TASK_NAME_LEN + 64U)
+
+/**
+ * void vTaskGetHistogram( TaskHandle_t xTask,
+ *                         eTaskHistogram eHistogram,
+ *                         TaskHistogram_t * const pxHistogram );
+ *
+ * Copy histogram eHistogram of xTask to *pxHistogram.  The histograms are
+ * updated in constant time as each job starts and completes, and never
+ * reset.  Passing NULL as xTask queries the calling task.
+ */
+void vTaskGetHistogram(TaskHandle_t xTask,
+                       eTaskHistogram eHistogram,
+                       TaskHistogram_t *const pxHistogram) PRIVILEGED_FUNCTION;
+
+/**
+ * TickType_t xTaskHistogramBucketLimit( UBaseType_t uxBucket );
+ *
+ * @return The largest value counted in bucket uxBucket, or portMAX_DELAY for
+ * the last bucket.
+ */
+TickType_t xTaskHistogramBucketLimit(UBaseType_t uxBucket) PRIVILEGED_FUNCTION;
+
+/**
+ * TickType_t xTaskHistogramPercentile( const TaskHistogram_t * const pxHistogram,
+ *                                      uint32_t ulPerMille );
+ *
+ * @return A value no more than ulPerMille thousandths of the values in
+ * *pxHistogram exceed, so 990 gives the 99th percentile and 999 the 99.9th.
+ * It is the limit of the bucket the percentile falls in, capped at the
+ * largest value recorded, so it overestimates by less than a bucket width.
+ * 0 if nothing has been recorded.
+ */
+TickType_t xTaskHistogramPercentile(const TaskHistogram_t *const pxHistogram,
+                                    uint32_t ulPerMille) PRIVILEGED_FUNCTION;
+
+/**
+ * size_t xTaskHistogramFormat( TaskHandle_t xTask,
+ *                              eTaskHistogram eHistogram,
+ *                              char * const pcBuffer,
+ *                              size_t xBufferLength );
+ *
+ * Write a one line summary of histogram eHistogram of xTask to pcBuffer,
+ * without using sprintf() or the heap: the task name, R or S for the
+ * response or start histogram, the number of values and the 50th, 99th and
+ * 99.9th percentiles and maximum, tab separated.  The line is cut short if
+ * pcBuffer is shorter than taskEDF_HISTOGRAM_LINE_LENGTH.  The buckets
+ * themselves can be read with vTaskGetHistogram().
+ *
+ * @return The length of the line written.
+ */
+size_t xTaskHistogramFormat(TaskHandle_t xTask,
+                            eTaskHistogram eHistogram,
+                            char *const pcBuffer,
+                            size_t xBufferLength) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_JOB_HISTOGRAMS */
+
+#if (configJOB_TRACE_LENGTH > 0)
+
+/* One completed job, as held in the job trace.  The trace keeps the last
+ * configJOB_TRACE_LENGTH jobs completed by any EDF task, oldest first, for
+ * tools/edf_analyzer.c to estimate WCETs from. */
+typedef struct xTASK_JOB_RECORD
+{
+    char pcTaskName[configMAX_TASK_NAME_LEN]; /* The name of the task. */
+    TickType_t xPeriod;                       /* The period, or minimum inter-arrival time, of the task. */
+    TickType_t xRelativeDeadline;             /* The deadline of the task relative to a release. */
+    TickType_t xReleaseTime;                  /* The tick the job was released on. */
+    TickType_t xResponseTime;                 /* Ticks from release to completion. */
+    uint32_t ulExecutionTime;                 /* Run time counter counts the job ran for, or ticks if configGENERATE_RUN_TIME_STATS is 0. */
+} TaskJobRecord_t;
+
+/* Longest line written by xTaskJobTraceFormat(), with its terminating null. */
+#define taskEDF_JOB_TRACE_LINE_LENGTH (configMAX_TASK_NAME_LEN + 64U)
+
+/**
+ * BaseType_t xTaskJobTraceRead( TaskJobRecord_t * const pxRecord );
+ *
+ * Take the oldest record out of the job trace.  When the trace is full the
+ * oldest record is overwritten, see ulTaskJobTraceGetOverwrites().
+ *
+ * @return pdPASS if *pxRecord was filled, pdFAIL if the trace is empty.
+ */
+BaseType_t xTaskJobTraceRead(TaskJobRecord_t *const pxRecord) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulTaskJobTraceGetOverwrites( void );
+ *
+ * @return The number of records overwritten before they were read.
+ */
+uint32_t ulTaskJobTraceGetOverwrites(void) PRIVILEGED_FUNCTION;
+
+/**
+ * size_t xTaskJobTraceFormat( const TaskJobRecord_t * const pxRecord,
+ *                             char * const pcBuffer,
+ *                             size_t xBufferLength );
+ *
+ * Write *pxRecord to pcBuffer as the line tools/edf_analyzer.c reads, without
+ * using sprintf(): J, then the task name, period, relative deadline, release
+ * time, response time and execution time, tab separated.  The line is cut
+ * short if pcBuffer is shorter than taskEDF_JOB_TRACE_LINE_LENGTH.
+ *
+ * @return The length of the line written.
+ */
+size_t xTaskJobTraceFormat(const TaskJobRecord_t *const pxRecord,
+                           char *const pcBuffer,
+                           size_t xBufferLength) PRIVILEGED_FUNCTION;
+
+#endif /* configJOB_TRACE_LENGTH */
+
+#endif /* configUSE_EDF_SCHEDULER */
+
+#if (configUSE_TASK_SLAB_ALLOCATOR == 1)
+
+/* The slabs TCBs and stacks of dynamically created tasks are allocated from
+ * when configUSE_TASK_SLAB_ALLOCATOR is set to 1.  Stacks are taken from the
+ * small stack slab if they are no deeper than
+ * configTASK_SLAB_SMALL_STACK_DEPTH words, otherwise from the large stack slab
+ * if they are no deeper than configTASK_SLAB_LARGE_STACK_DEPTH words.  A
+ * request that no slab can serve is allocated from the heap instead.
+ * configTASK_SLAB_LARGE_STACKS may be 0 if no task needs a deep stack. */
+typedef enum
+{
+    eTaskSlabTCB = 0,    /* configTASK_SLAB_TCBS task control blocks. */
+    eTaskSlabSmallStack, /* configTASK_SLAB_SMALL_STACKS stacks. */
+    eTaskSlabLargeStack  /* configTASK_SLAB_LARGE_STACKS stacks. */
+} eTaskSlab;
+
+/* Used to pass information about a slab out of vTaskGetSlabStats(). */
+typedef struct xTASK_SLAB_STATS
+{
+    UBaseType_t uxBlocks;     /* The number of blocks in the slab. */
+    size_t xBlockSize;        /* The size of one block in bytes. */
+    UBaseType_t uxInUse;      /* The number of blocks currently allocated. */
+    UBaseType_t uxMaxInUse;   /* The most blocks that have been allocated at the same time. */
+    uint32_t ulHeapFallbacks; /* The number of requests for this slab that were allocated from the heap. */
+} TaskSlabStats_t;
+
+/**
+ * void vTaskGetSlabStats( eTaskSlab eSlab, TaskSlabStats_t *pxSlabStats );
+ *
+ * Fill *pxSlabStats with the current state of the slab eSlab.  A non-zero
+ * ulHeapFallbacks means the slab is too small, or its blocks too small, for
+ * the tasks the application creates.
+ */
+void vTaskGetSlabStats(eTaskSlab eSlab,
+                       TaskSlabStats_t *pxSlabStats) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_SLAB_ALLOCATOR */
+
+#if (configUSE_SWITCH_PROFILER == 1)
+
+/* Cycle histograms of the switch profile have one bucket per power of two,
+ * bucket n counting samples of 2^n to 2^(n+1) - 1 cycles (bucket 0 also
+ * counts 0).  The last bucket also counts every longer sample. */
+#ifndef configSWITCH_PROFILE_BUCKETS
+#define configSWITCH_PROFILE_BUCKETS 16
+#endif
+
+/* The phases of a context switch that are timed when
+ * configUSE_SWITCH_PROFILER is set to 1.  vTaskSwitchContext() reads
+ * portPROFILER_GET_CYCLES() between them.  If the counter is reset by
+ * hardware, for example by a match on the tick, configPROFILER_COUNTER_PERIOD
+ * must be the number of counts between resets so a phase that spans a reset
+ * is still timed correctly. */
+typedef enum
+{
+    eTaskSwitchRunTime = 0,  /* Run time stats accounting. */
+    eTaskSwitchTraceOut,     /* traceTASK_SWITCHED_OUT(). */
+    eTaskSwitchStackCheck,   /* taskCHECK_FOR_STACK_OVERFLOW(). */
+    eTaskSwitchSelect,       /* Choosing the task to run, the head of the EDF ready list. */
+    eTaskSwitchTraceIn,      /* traceTASK_SWITCHED_IN(). */
+    eTaskSwitchTotal,        /* All of vTaskSwitchContext(). */
+    eTaskSwitchPort          /* Saving and restoring the context, as reported by the port with vTaskProfilePortSample(). */
+} eTaskSwitchPhase;
+
+/* Number of phases in eTaskSwitchPhase. */
+#define taskSWITCH_PHASES (eTaskSwitchPort + 1)
+
+/* Used to pass the profile of a phase out of vTaskGetSwitchProfile(). */
+typedef struct xTASK_SWITCH_PROFILE
+{
+    uint32_t ulSamples;                                  /* The number of switches timed. */
+    uint32_t ulMinCycles;                                /* The shortest sample. */
+    uint32_t ulMaxCycles;                                /* The longest sample. */
+    uint64_t ullTotalCycles;                             /* The sum of the samples, for the average. */
+    uint32_t ulBuckets[configSWITCH_PROFILE_BUCKETS];    /* The number of samples in each power of two range. */
+} TaskSwitchProfile_t;
+
+/**
+ * void vTaskGetSwitchProfile( eTaskSwitchPhase ePhase,
+ *                             TaskSwitchProfile_t * const pxProfile );
+ *
+ * Fill *pxProfile with the cycles spent in phase ePhase of the context
+ * switches since the scheduler was started or vTaskResetSwitchProfile() was
+ * last called.  Only switches that change or reselect the running task are
+ * timed, not those deferred while the scheduler is suspended.
+ */
+void vTaskGetSwitchProfile(eTaskSwitchPhase ePhase,
+                           TaskSwitchProfile_t *const pxProfile) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskResetSwitchProfile( void );
+ *
+ * Clear the profile of every phase.
+ */
+void vTaskResetSwitchProfile(void) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskProfilePortSample( uint32_t ulCycles );
+ *
+ * Called by the port with interrupts masked, after restoring a context, with
+ * the cycles from just before it saved the previous context.  The time the
+ * vTaskSwitchContext() call in between took is taken off, and the rest is
+ * recorded as the eTaskSwitchPort phase.  The phase stays empty with a port
+ * that does not call it.  The simulation port in tools/edf_fuzz does, see
+ * FreeRTOSConfig.h for the LPC2000 port.
+ */
+void vTaskProfilePortSample(uint32_t ulCycles) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_SWITCH_PROFILER */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* EDF_SCHEDULER_H */
@@ -0,0 +1,32 @@
+/*
+ * The periodic and sporadic tasks of the application, fixed at compile time.
+ *
+ * Only used when configUSE_EDF_STATIC_TASK_SET is set to 1 in
+ * FreeRTOSConfig.h.  The tables below hold an entry for each task, in the
+ * order the tasks are created: its period (the minimum inter-arrival time of
+ * a sporadic task) and its relative deadline, both in ticks.  The kernel
+ * checks every task against its entries as it is created, and that all of them
+ * were created before the scheduler starts, so the tables cannot drift from
+ * the calls in main.c: a task that does not match is not created, its create
+ * function returns pdFAIL, and vTaskStartScheduler() returns without starting
+ * the kernel.  configASSERT(), if defined, also stops at the first mismatch.
+ *
+ * With the task set fixed the kernel drops the priority ready lists, the
+ * per tick re-release of the idle task and the functions that change the
+ * timing of a task at run time, and a tick that releases a job only asks for a
+ * context switch if the job preempts the running one.
+ *
+ * edfTASK_SET_HYPERPERIOD must be the least common multiple of the periods.
+ */
+
+#ifndef EDF_TASK_SET_H
+#define EDF_TASK_SET_H
+
+/* Load 1, load 2, transmitter, UART receiver, button 1 and button 2, see the
+ * slots in main.c. */
+#define edfTASK_SET_COUNT          6
+#define edfTASK_SET_PERIODS        { 10U, 100U, 100U, 20U, 50U, 50U }
+#define edfTASK_SET_DEADLINES      { 10U, 100U, 100U, 20U, 50U, 50U }
+#define edfTASK_SET_HYPERPERIOD    100U
+
+#endif /* EDF_TASK_SET_H */
@@ -0,0 +1,214 @@
+/*
+ * Synthetic CPU load, calibrated against the run time counter.  See
+ * load_generator.h for the API.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "load_generator.h"
+
+#ifndef portLOAD_GENERATOR_RUN
+
+/* Each calibration run lasts at least this long, so the one count the run
+ * time counter can be out by at each end is a small part of it. */
+#define loadgenCALIBRATION_MS          20UL
+
+/* Calibration is repeated and the fastest run is kept: an interrupt during a
+ * run only ever makes it slower. */
+#define loadgenCALIBRATION_RUNS        3U
+
+/* Iterations timed by the first calibration run.  Doubled until a run is long
+ * enough. */
+#define loadgenCALIBRATION_ITERATIONS  1024UL
+
+/*
+ * Count ulIterations down to 0.  The cost of an iteration is what the
+ * calibration measures.
+ */
+static void prvSpin(uint32_t ulIterations);
+
+#endif
+/*-----------------------------------------------------------*/
+
+/* Spin loop iterations per microsecond, 16.16 fixed point. */
+static uint32_t ulIterationsPerMicrosecond = 0UL;
+/*-----------------------------------------------------------*/
+
+#ifndef portLOAD_GENERATOR_RUN
+
+static void prvSpin(uint32_t ulIterations)
+{
+    volatile uint32_t ulCount = ulIterations;
+
+    while (ulCount != 0UL)
+    {
+        ulCount--;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vLoadGeneratorCalibrate(void)
+{
+    const configRUN_TIME_COUNTER_TYPE ulMinimumCounts =
+        (configRUN_TIME_COUNTER_TYPE)(((uint64_t)configRUN_TIME_COUNTER_HZ * loadgenCALIBRATION_MS) / 1000UL);
+    configRUN_TIME_COUNTER_TYPE ulStart;
+    configRUN_TIME_COUNTER_TYPE ulElapsed;
+    configRUN_TIME_COUNTER_TYPE ulFastest = 0;
+    uint32_t ulIterations = loadgenCALIBRATION_ITERATIONS;
+    uint64_t ullScaled;
+    UBaseType_t uxRun;
+
+    configASSERT(ulMinimumCounts > 0U);
+
+    /* Find an iteration count that takes long enough to time. */
+    do
+    {
+        ulIterations <<= 1;
+        ulStart = portGET_RUN_TIME_COUNTER_VALUE();
+        prvSpin(ulIterations);
+        ulElapsed = portGET_RUN_TIME_COUNTER_VALUE() - ulStart;
+
+        /* The counter has not moved after 2^31 iterations if it is not
+         * running at all. */
+        configASSERT((ulElapsed > 0U) || (ulIterations < 0x80000000UL));
+    } while ((ulElapsed < ulMinimumCounts) && (ulIterations < 0x80000000UL));
+
+    for (uxRun = 0U; uxRun < loadgenCALIBRATION_RUNS; uxRun++)
+    {
+        ulStart = portGET_RUN_TIME_COUNTER_VALUE();
+        prvSpin(ulIterations);
+        ulElapsed = portGET_RUN_TIME_COUNTER_VALUE() - ulStart;
+
+        if ((ulFastest == 0U) || (ulElapsed < ulFastest))
+        {
+            ulFastest = ulElapsed;
+        }
+    }
+
+    /* Iterations per microsecond is iterations * counter Hz / (counts * 10^6),
+     * shifted up 16 bits first so the fraction is kept. */
+    ullScaled = (((uint64_t)ulIterations << 16) * (uint64_t)configRUN_TIME_COUNTER_HZ) /
+                ((uint64_t)ulFastest * 1000000ULL);
+
+    if (ullScaled > (uint64_t)0xFFFFFFFFUL)
+    {
+        ullScaled = (uint64_t)0xFFFFFFFFUL;
+    }
+    else if (ullScaled == 0ULL)
+    {
+        /* Slower than one iteration per 65536 microseconds, which cannot
+         * happen on a real core, but keep 0 to mean uncalibrated. */
+        ullScaled = 1ULL;
+    }
+
+    ulIterationsPerMicrosecond = (uint32_t)ullScaled;
+}
+/*-----------------------------------------------------------*/
+
+void vLoadGeneratorRun(uint32_t ulMicroseconds)
+{
+    uint64_t ullIterations;
+
+    configASSERT(ulIterationsPerMicrosecond != 0UL);
+
+    ullIterations = ((uint64_t)ulMicroseconds * (uint64_t)ulIterationsPerMicrosecond) >> 16;
+
+    /* Only loads of minutes need more than one pass. */
+    while (ullIterations > (uint64_t)0xFFFFFFFFUL)
+    {
+        prvSpin(0xFFFFFFFFUL);
+        ullIterations -= (uint64_t)0xFFFFFFFFUL;
+    }
+
+    prvSpin((uint32_t)ullIterations);
+}
+
+#else /* portLOAD_GENERATOR_RUN */
+
+void vLoadGeneratorCalibrate(void)
+{
+    /* Simulated time needs no calibration, but mark it done so
+     * ulLoadGeneratorGetCalibration() does not report it missing. */
+    ulIterationsPerMicrosecond = 1UL << 16;
+}
+/*-----------------------------------------------------------*/
+
+void vLoadGeneratorRun(uint32_t ulMicroseconds)
+{
+    portLOAD_GENERATOR_RUN(ulMicroseconds);
+}
+
+#endif /* portLOAD_GENERATOR_RUN */
+/*-----------------------------------------------------------*/
+
+uint32_t ulLoadGeneratorGetCalibration(void)
+{
+    return ulIterationsPerMicrosecond;
+}
+/*-----------------------------------------------------------*/
+
+void vLoadGeneratorProfileInit(LoadProfile_t *pxProfile,
+                               eLoadDistribution eDistribution,
+                               uint32_t ulLowMicroseconds,
+                               uint32_t ulHighMicroseconds,
+                               uint32_t ulHighPerMille,
+                               uint32_t ulSeed)
+{
+    configASSERT(pxProfile);
+    configASSERT((eDistribution == eLoadConstant) || (ulHighMicroseconds >= ulLowMicroseconds));
+    configASSERT(ulHighPerMille <= 1000UL);
+
+    pxProfile->eDistribution = eDistribution;
+    pxProfile->ulLowMicroseconds = ulLowMicroseconds;
+    pxProfile->ulHighMicroseconds = ulHighMicroseconds;
+    pxProfile->ulHighPerMille = ulHighPerMille;
+
+    /* xorshift never leaves 0, so a 0 seed is replaced. */
+    pxProfile->ulState = (ulSeed != 0UL) ? ulSeed : 0x9E3779B9UL;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulLoadGeneratorProfileNext(LoadProfile_t *pxProfile)
+{
+    uint32_t ulRandom;
+    uint32_t ulReturn;
+
+    configASSERT(pxProfile);
+
+    /* xorshift32: cheap, and the same seed gives the same jobs on any port. */
+    ulRandom = pxProfile->ulState;
+    ulRandom ^= ulRandom << 13;
+    ulRandom ^= ulRandom >> 17;
+    ulRandom ^= ulRandom << 5;
+    pxProfile->ulState = ulRandom;
+
+    /* Scaling by multiplication avoids a division, which the ARM7 does not
+     * have in hardware. */
+    switch (pxProfile->eDistribution)
+    {
+        case eLoadUniform:
+            ulReturn = pxProfile->ulLowMicroseconds +
+                       (uint32_t)(((uint64_t)ulRandom * ((uint64_t)(pxProfile->ulHighMicroseconds - pxProfile->ulLowMicroseconds) + 1ULL)) >> 32);
+            break;
+
+        case eLoadBimodal:
+            if ((uint32_t)(((uint64_t)ulRandom * 1000ULL) >> 32) < pxProfile->ulHighPerMille)
+            {
+                ulReturn = pxProfile->ulHighMicroseconds;
+            }
+            else
+            {
+                ulReturn = pxProfile->ulLowMicroseconds;
+            }
+            break;
+
+        case eLoadConstant:
+        default:
+            ulReturn = pxProfile->ulLowMicroseconds;
+            break;
+    }
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
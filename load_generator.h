@@ -0,0 +1,123 @@
+/*
+ * Synthetic CPU load, calibrated against the run time counter.
+ *
+ * vLoadGeneratorCalibrate() times a fixed spin loop against
+ * portGET_RUN_TIME_COUNTER_VALUE() once at startup.  vLoadGeneratorRun() then
+ * spins for the number of loop iterations that takes the requested number of
+ * microseconds, so a load job demands the same CPU time whatever the
+ * compiler, optimisation level or clock.  The time is execution time: a job
+ * that is preempted part way through still gets its full demand once it
+ * resumes.
+ *
+ * The loop counter is volatile, so the compiler can neither remove the loop
+ * nor change its cost per iteration between calibration and use.
+ *
+ * A profile draws the execution time of successive jobs from a distribution,
+ * with a seeded generator so the same seed always gives the same sequence of
+ * jobs.
+ *
+ * A port that simulates time, rather than running on a real core, defines
+ * portLOAD_GENERATOR_RUN( ulMicroseconds ) to advance its own clock.  No
+ * calibration is needed then.
+ */
+
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#ifndef INC_TASK_H
+#error "include task.h must appear in source files before include load_generator.h"
+#endif
+
+#if (configGENERATE_RUN_TIME_STATS != 1) && !defined(portLOAD_GENERATOR_RUN)
+#error "the load generator is calibrated against the run time counter, set configGENERATE_RUN_TIME_STATS to 1"
+#endif
+
+#if !defined(configRUN_TIME_COUNTER_HZ) && !defined(portLOAD_GENERATOR_RUN)
+#error "Missing definition: configRUN_TIME_COUNTER_HZ must be defined in FreeRTOSConfig.h to use the load generator"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Distribution of the execution times drawn from a profile. */
+typedef enum
+{
+    eLoadConstant = 0, /* Always ulLowMicroseconds. */
+    eLoadUniform,      /* Uniform from ulLowMicroseconds to ulHighMicroseconds inclusive. */
+    eLoadBimodal       /* ulHighMicroseconds for ulHighPerMille of every 1000 jobs on average, otherwise ulLowMicroseconds. */
+} eLoadDistribution;
+
+/* The execution times of one load.  Initialise with vLoadGeneratorProfileInit(),
+ * the members should not be accessed directly. */
+typedef struct xLOAD_PROFILE
+{
+    eLoadDistribution eDistribution;
+    uint32_t ulLowMicroseconds;
+    uint32_t ulHighMicroseconds;
+    uint32_t ulHighPerMille;
+    uint32_t ulState; /*< State of the generator, never 0. */
+} LoadProfile_t;
+
+/**
+ * void vLoadGeneratorCalibrate( void );
+ *
+ * Time the spin loop against the run time counter.  Must be called before the
+ * scheduler is started, with the run time counter running, so nothing
+ * preempts the loop while it is timed.  Takes a few tens of milliseconds.
+ */
+void vLoadGeneratorCalibrate(void);
+
+/**
+ * uint32_t ulLoadGeneratorGetCalibration( void );
+ *
+ * @return Spin loop iterations per microsecond, in 16.16 fixed point, or 0 if
+ * vLoadGeneratorCalibrate() has not been called.
+ */
+uint32_t ulLoadGeneratorGetCalibration(void);
+
+/**
+ * void vLoadGeneratorRun( uint32_t ulMicroseconds );
+ *
+ * Burn ulMicroseconds of CPU time in the calling task.
+ */
+void vLoadGeneratorRun(uint32_t ulMicroseconds);
+
+/**
+ * void vLoadGeneratorProfileInit( LoadProfile_t *pxProfile,
+ *                                 eLoadDistribution eDistribution,
+ *                                 uint32_t ulLowMicroseconds,
+ *                                 uint32_t ulHighMicroseconds,
+ *                                 uint32_t ulHighPerMille,
+ *                                 uint32_t ulSeed );
+ *
+ * Prepare pxProfile to draw execution times from eDistribution.
+ * ulHighMicroseconds must not be below ulLowMicroseconds for eLoadUniform and
+ * eLoadBimodal, and is not used for eLoadConstant.  ulHighPerMille is only
+ * used for eLoadBimodal.  Profiles with the same arguments draw the same
+ * sequence.
+ */
+void vLoadGeneratorProfileInit(LoadProfile_t *pxProfile,
+                               eLoadDistribution eDistribution,
+                               uint32_t ulLowMicroseconds,
+                               uint32_t ulHighMicroseconds,
+                               uint32_t ulHighPerMille,
+                               uint32_t ulSeed);
+
+/**
+ * uint32_t ulLoadGeneratorProfileNext( LoadProfile_t *pxProfile );
+ *
+ * @return The execution time of the next job of pxProfile, in microseconds.
+ * Pass it to vLoadGeneratorRun().
+ */
+uint32_t ulLoadGeneratorProfileNext(LoadProfile_t *pxProfile);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* LOAD_GENERATOR_H */
@@ -60,11 +60,16 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "edf_scheduler.h"
 #include "lpc21xx.h"
 #include "queue.h"
+#include "message_ring.h"
+#include "message_pool.h"
+#include "load_generator.h"
 
 /* Peripheral includes. */
 #include "serial.h"
+#include "uart_tx.h"
 #include "GPIO.h"
 
 
@@ -75,6 +80,11 @@
 
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
+
+/* Interrupt driven UART transmit: buffer size, and the longest record sent for
+a message (a newline followed by the message, longer messages are cut). */
+#define UART_TX_BUFFER_SIZE						256
+#define UART_RECORD_SIZE							32
 	
 /* Task handlers */
 TaskHandle_t Periodic_Transmitter_Handler = NULL;
@@ -84,8 +94,39 @@ TaskHandle_t Button_2_Monitor_Handler =NULL;
 TaskHandle_t Load_1_Simulation_Handler =NULL;
 TaskHandle_t Load_2_Simulation_Handler =NULL;
 
-/* Queue used to send and receive pointers to messages between tasks */
-QueueHandle_t xPointerQueue = NULL;
+/* Ring used to pass messages from the monitor and transmitter tasks to the
+UART task. Sends never block, a full ring drops the message and counts it. */
+#define MESSAGE_RING_SLOTS						8			/* must be a power of 2 */
+static MessageRingSlot_t xMessageSlots[MESSAGE_RING_SLOTS];
+MessageRing_t xMessageRing;
+
+/* Blocks the records are built in. The producer formats the record in place and
+passes the block through the ring, the UART task transmits it from the block
+and releases it, so the record is never copied between tasks. Stats are
+refreshed by the UART task for the debugger. */
+#define MESSAGE_POOL_BLOCKS						MESSAGE_RING_SLOTS
+static uint32_t ulMessagePoolStorage[messagepoolSTORAGE_WORDS(UART_RECORD_SIZE, MESSAGE_POOL_BLOCKS)];
+MessagePool_t xMessagePool;
+MessagePoolStats_t xMessagePoolStats;
+
+/* Set to 1 to time the message ring against a FreeRTOS queue before the
+scheduler is started. Results are in timer 1 counts, for MESSAGE_BENCHMARK_ROUNDS
+send/receive pairs. */
+#define MESSAGE_BENCHMARK							0
+#define MESSAGE_BENCHMARK_ROUNDS			1000
+unsigned int Ring_Benchmark_Time=0,	Queue_Benchmark_Time=0;
+
+/* Set to 1 to time RUN_TIME_BENCHMARK_ROUNDS reads of the extended run time
+counter against as many raw T1TC reads, both in timer 1 counts. The difference
+is the cost the extension adds to each read in the context switch path. */
+#define RUN_TIME_BENCHMARK						0
+#define RUN_TIME_BENCHMARK_ROUNDS			10000
+unsigned int RunTime_Benchmark_Time=0,	T1TC_Benchmark_Time=0;
+
+/* Timer 1 extended to 64 bits: the upper word and the T1TC value it was last
+checked against. Only the tick hook writes them, ulRunTimeUpdates counts its
+writes so readers can tell a consistent snapshot. */
+static volatile uint32_t ulRunTimeHigh=0,	ulRunTimeLastLow=0,	ulRunTimeUpdates=0;
 
 /*Task Periodicity*/
 #define Button_1_Monitor_PERIOD     	50
@@ -94,25 +135,87 @@ QueueHandle_t xPointerQueue = NULL;
 #define Uart_Receiver_PERIOD   				20
 #define Load_1_Simulation_PERIOD    	10
 #define Load_2_Simulation_PERIOD    	100
-#define Load_1_ms											7000
 #define fixed_Priority								2
 
+/*Execution time of each load job in microseconds, burnt by the calibrated
+load generator. Set the distribution to eLoadUniform or eLoadBimodal to vary
+it between the LOW and HIGH times, the seed makes every run draw the same
+jobs.*/
+#define Load_1_Simulation_DISTRIBUTION	eLoadConstant
+#define Load_1_Simulation_LOW_US			5000
+#define Load_1_Simulation_HIGH_US			5000
+#define Load_2_Simulation_DISTRIBUTION	eLoadConstant
+#define Load_2_Simulation_LOW_US			12000
+#define Load_2_Simulation_HIGH_US			12000
+#define LOAD_HIGH_PER_MILLE						100		/* bimodal: share of jobs at the HIGH time */
+#define LOAD_SEED											1
+LoadProfile_t xLoad_1_Profile,	xLoad_2_Profile;
+
+/*Worst case execution time of a job in ticks, admitted by xTaskSetWCET(). The
+loads burn at most their HIGH time, rounded up to whole ticks. The other tasks
+run for well under a tick, and a tick is the smallest WCET there is. Together
+they use 72% of the processor.*/
+#define US_TO_TICKS_CEIL( ulUs )			( ( TickType_t ) ( ( ( ( uint64_t ) ( ulUs ) * configTICK_RATE_HZ ) + 999999ULL ) / 1000000ULL ) )
+#define Load_1_Simulation_WCET				US_TO_TICKS_CEIL( Load_1_Simulation_HIGH_US )
+#define Load_2_Simulation_WCET				US_TO_TICKS_CEIL( Load_2_Simulation_HIGH_US )
+#define SHORT_TASK_WCET								( ( TickType_t ) 1 )
+
+/*(m,k)-firm constraint of the transmitter: m of every k jobs must run*/
+#define TRANSMITTER_FIRM_M						1
+#define TRANSMITTER_FIRM_K						2
+
+/*Release offsets: one slot per periodic task, in creation order*/
+#define Load_1_Simulation_SLOT				0
+#define Load_2_Simulation_SLOT				1
+#define Periodic_Transmitter_SLOT			2
+#define Uart_Receiver_SLOT						3
+#define Button_1_Monitor_SLOT					4
+#define Button_2_Monitor_SLOT					5
+#define NUMBER_OF_PERIODIC_TASKS			6
+#define HYPERPERIOD										100		/* LCM of the periods above */
+
+/*With the task set fixed at compile time the kernel checks each task created
+below against edf_task_set.h*/
+#if ( configUSE_EDF_STATIC_TASK_SET == 1 )
+#include "edf_task_set.h"
+#if ( edfTASK_SET_COUNT != NUMBER_OF_PERIODIC_TASKS ) || ( edfTASK_SET_HYPERPERIOD != HYPERPERIOD )
+#error "edf_task_set.h does not describe the tasks created in main()"
+#endif
+#endif
+
 /* Msgs to be sent to queue by each task */
 char * Transmitting_Task = "Transmitting each 100 ms";
 char * Button_1_Rising_Edge = "Button1 State: Rising Edge";
 char * Button_1_Falling_Edge = "Button1 State: Falling Edge";
 char * Button_2_Rising_Edge = "Button2 State: Rising_Edge";
 char * Button_2_Falling_Edge = "Button2 State: Falling Edge";
-//char TaskState_Buffer[270]; 
-
-/*Tasks time variables*/
-unsigned int LD1_InTime=0,	LD1_OutTime=0,	LD1_TotalTime=0;
-unsigned int LD2_InTime=0,	LD2_OutTime=0,	LD2_TotalTime=0;
-unsigned int B1_InTime=0,		B1_OutTime=0,		B1_TotalTime=0;
-unsigned int B2_InTime=0,		B2_OutTime=0,		B2_TotalTime=0;
-unsigned int PeriodicTransmitter_InTime=0,	PeriodicTransmitter_OutTime=0,	PeriodicTransmitter_TotalTime=0;
-unsigned int Uart_Receiver_InTime=0,				Uart_Receiver_OutTime=0,				Uart_Receiver_TotalTime=0;
-unsigned int totalExecution=0,							totalTime=0;
+
+/* One row of the task table, streamed by Uart_Receiver a row per job */
+char TaskState_Buffer[ taskEDF_STATS_LINE_LENGTH ];
+TaskStatsIterator_t xTaskStatsIterator;
+
+#if ( configUSE_JOB_HISTOGRAMS == 1 )
+/* Response time percentiles of the 10 and 20 tick tasks, sent after each pass
+over the task table */
+char Histogram_Buffer[ taskEDF_HISTOGRAM_LINE_LENGTH ];
+#endif
+
+/* Every completed job is sent over the UART in place of the task table when
+JOB_TRACE_OUTPUT is set in FreeRTOSConfig.h. Jobs the UART cannot keep up with
+are counted by ulTaskJobTraceGetOverwrites(). */
+#if ( JOB_TRACE_OUTPUT == 1 )
+char JobTrace_Buffer[ taskEDF_JOB_TRACE_LINE_LENGTH ];
+TaskJobRecord_t xJobRecord;
+#endif
+
+/*Tasks time variables, in extended timer 1 counts*/
+uint64_t LD1_InTime=0,	LD1_OutTime=0,	LD1_TotalTime=0;
+uint64_t LD2_InTime=0,	LD2_OutTime=0,	LD2_TotalTime=0;
+uint64_t B1_InTime=0,		B1_OutTime=0,		B1_TotalTime=0;
+uint64_t B2_InTime=0,		B2_OutTime=0,		B2_TotalTime=0;
+uint64_t PeriodicTransmitter_InTime=0,	PeriodicTransmitter_OutTime=0,	PeriodicTransmitter_TotalTime=0;
+uint64_t Uart_Receiver_InTime=0,				Uart_Receiver_OutTime=0,				Uart_Receiver_TotalTime=0;
+uint64_t totalExecution=0,							totalTime=0;
 float CPU_Load=0;
 
 /*
@@ -121,6 +224,23 @@ float CPU_Load=0;
  * file.
  */
 static void prvSetupHardware( void );
+
+/* Post a message to the UART task. */
+static void prvSendMessage( const char * pcMessage );
+
+/* Carry timer 1 wraps into the upper word of the run time counter. */
+static void prvUpdateRunTimeCounter( void );
+
+/* Work out CPU_Load from the sums kept by the switched out hook. */
+static void prvUpdateCPULoad( void );
+
+#if ( MESSAGE_BENCHMARK == 1 )
+static void prvBenchmarkMessagePaths( void );
+#endif
+
+#if ( RUN_TIME_BENCHMARK == 1 )
+static void prvBenchmarkRunTimeCounter( void );
+#endif
 /*-----------------------------------------------------------*/
 
 /* Tasks implementation */
@@ -130,7 +250,6 @@ static void prvSetupHardware( void );
 void Periodic_Transmitter( void * pvParameters )
 {
 		
-		const TickType_t xFrequency=Periodic_Transmitter_PERIOD;
 		TickType_t LastWakeTime;
 		LastWakeTime =xTaskGetTickCount();
  		 
@@ -141,43 +260,72 @@ void Periodic_Transmitter( void * pvParameters )
     for( ;; )
     {
         /* Task code goes here. */
-					xQueueSend(	xPointerQueue,
-							( void * ) &Transmitting_Task,
-                      ( TickType_t ) 0 );
+					prvSendMessage( Transmitting_Task );
 							
-					vTaskDelayUntil(&LastWakeTime,xFrequency);				
+					xTaskDelayUntilNextPeriod(&LastWakeTime);				
     }
 }
 
 void Uart_Receiver( void * pvParameters )
 {  
-		char  *receive;
-		const TickType_t xFrequency=Uart_Receiver_PERIOD;
+		MessageDescriptor_t xMessage;
 		TickType_t LastWakeTime;
+		size_t xStatsLength;
 		LastWakeTime =xTaskGetTickCount();
 
 	/* The parameter value is expected to be 1 as 1 is passed in the
     pvParameters value in the call to xTaskCreate() below.*/ 
     configASSERT( ( ( uint32_t ) pvParameters ) == 1 );
 	
+		vTaskStatsIteratorInit( &xTaskStatsIterator );
+	
     for( ;; )
     {
-				//vTaskGetRunTimeStats( TaskState_Buffer );
-				//vSerialPutString( TaskState_Buffer, 300);
-			if( xPointerQueue != NULL )
-   {
-      /* Receive a message from the created queue */
-      if( xQueueReceive( xPointerQueue,
-                         &( receive ),
-                         ( TickType_t ) 0 ) == pdPASS )
+#if ( JOB_TRACE_OUTPUT == 1 )
+				/* Every job completed since the last one of this task */
+				while( xTaskJobTraceRead( &xJobRecord ) == pdPASS )
+				{
+						xStatsLength = xTaskJobTraceFormat( &xJobRecord, JobTrace_Buffer, sizeof( JobTrace_Buffer ) );
+						( void ) xUartTxWrite( JobTrace_Buffer, xStatsLength );
+				}
+#else
+				/* One row of the task table per job, so the job stays short,
+				start over once every task has been listed */
+				xStatsLength = xTaskStatsIteratorNext( &xTaskStatsIterator,
+																							 TaskState_Buffer,
+																							 sizeof( TaskState_Buffer ) );
+				if( xStatsLength == 0 )
+				{
+						vTaskStatsIteratorInit( &xTaskStatsIterator );
+#if ( configUSE_JOB_HISTOGRAMS == 1 )
+						
+						xStatsLength = xTaskHistogramFormat( Load_1_Simulation_Handler, eTaskHistogramResponse,
+																								 Histogram_Buffer, sizeof( Histogram_Buffer ) );
+						( void ) xUartTxWrite( Histogram_Buffer, xStatsLength );
+						xStatsLength = xTaskHistogramFormat( NULL, eTaskHistogramResponse,
+																								 Histogram_Buffer, sizeof( Histogram_Buffer ) );
+						( void ) xUartTxWrite( Histogram_Buffer, xStatsLength );
+#endif
+				}
+				else
+				{
+						( void ) xUartTxWrite( TaskState_Buffer, xStatsLength );
+				}
+#endif
+      /* Queue every message posted since the last job for transmission,
+      the UART interrupt sends them while other jobs run */
+      while( xMessageRingReceive( &xMessageRing,
+                                  &xMessage,
+                                  ( TickType_t ) 0 ) == pdPASS )
       {
-        							xSerialPutChar('\n');
-											vSerialPutString(receive, 28);
+											( void ) xUartTxWrite( xMessage.pvData, xMessage.xLength );
+											vMessagePoolRelease( ( void * ) xMessage.pvData );
       }
-   }
+			vMessagePoolGetStats( &xMessagePool, &xMessagePoolStats );
+			prvUpdateCPULoad();
 			
       /* Task code goes here. */
-				vTaskDelayUntil(&LastWakeTime,20);		
+				xTaskDelayUntilNextPeriod(&LastWakeTime);		
     }
 }
 
@@ -185,7 +333,6 @@ void Button_1_Monitor( void * pvParameters )
 {
 		pinState_t u8Button1State;
 		
-		const TickType_t xFrequency=Button_1_Monitor_PERIOD;	
 		TickType_t LastWakeTime;
 		LastWakeTime =xTaskGetTickCount();
 		
@@ -205,22 +352,18 @@ void Button_1_Monitor( void * pvParameters )
 					/* check for falling or rising edge, then send a queue msg with the state*/					
 					 if( u8Button1State == PIN_IS_HIGH )
 						{
-							xQueueSend( xPointerQueue,
-                      ( void * ) &Button_1_Rising_Edge,
-                      ( TickType_t ) 0 );  
+							prvSendMessage( Button_1_Rising_Edge );
 							u8Button1State = GPIO_read(PORT_0,PIN0); 
 
         		}
 						else
 						{							
-							xQueueSend( xPointerQueue,
-                      ( void * ) &Button_1_Falling_Edge,
-                      ( TickType_t ) 0 );  
+							prvSendMessage( Button_1_Falling_Edge );
 							u8Button1State = GPIO_read(PORT_0,PIN0);
 
 						}
 				}
-				vTaskDelayUntil(&LastWakeTime,xFrequency);		
+				xTaskDelayUntilNextPeriod(&LastWakeTime);		
 
 		}
 }
@@ -229,7 +372,6 @@ void Button_2_Monitor( void * pvParameters )
 {
 		pinState_t u8Button2State;
 	
-		const TickType_t xFrequency	=	Button_2_Monitor_PERIOD;	
 		TickType_t LastWakeTime;
 		LastWakeTime =xTaskGetTickCount();
 	
@@ -248,31 +390,24 @@ void Button_2_Monitor( void * pvParameters )
 					/* check for falling or rising edge, then send a queue msg with the state*/					
 					 if( u8Button2State == PIN_IS_HIGH )
 						{
-							xQueueSend( xPointerQueue,
-                      ( void * ) &Button_2_Rising_Edge,
-                      ( TickType_t ) 0 );  
+							prvSendMessage( Button_2_Rising_Edge );
 							u8Button2State = GPIO_read(PORT_0,PIN1); 
 
         		}
 						else
 							{							
-							xQueueSend( xPointerQueue,
-                      ( void * ) &Button_2_Falling_Edge,
-                      ( TickType_t ) 0 );  
+							prvSendMessage( Button_2_Falling_Edge );
 							u8Button2State = GPIO_read(PORT_0,PIN1);
 
 						}
 				}
-				vTaskDelayUntil(&LastWakeTime,xFrequency);		
+				xTaskDelayUntilNextPeriod(&LastWakeTime);		
 		}
 }
 
 
 void Load_1_Simulation( void * pvParameters )
 {
-    int i;
-		const TickType_t xFrequency=Load_1_Simulation_PERIOD;
-
 	  TickType_t LastWakeTime;
 		LastWakeTime =xTaskGetTickCount();
 	
@@ -283,20 +418,14 @@ void Load_1_Simulation( void * pvParameters )
     for( ;; )
     {
         /* Task code goes here. */
-				for(i=0;i<Load_1_ms*5;i++) // 7000 = 1 ms  
-				{
-					i=i;
-				}
+				vLoadGeneratorRun( ulLoadGeneratorProfileNext( &xLoad_1_Profile ) );
 					
-				vTaskDelayUntil(&LastWakeTime,xFrequency);				
+				xTaskDelayUntilNextPeriod(&LastWakeTime);				
     }
 }
 
 void Load_2_Simulation( void * pvParameters )
 {
-		int i;
-		const TickType_t xFrequency=Load_2_Simulation_PERIOD;
-
 	  TickType_t LastWakeTime;	 
 		LastWakeTime =xTaskGetTickCount();
 	
@@ -308,12 +437,9 @@ void Load_2_Simulation( void * pvParameters )
     {
      
 				/* Task code goes here. */
-				for(i=0;i<Load_1_ms*12;i++)// 7000 = 1 ms 
-				{
-					i=i;
-				}
+				vLoadGeneratorRun( ulLoadGeneratorProfileNext( &xLoad_2_Profile ) );
 				
-				vTaskDelayUntil(&LastWakeTime,xFrequency);			
+				xTaskDelayUntilNextPeriod(&LastWakeTime);			
     }
 }
 
@@ -326,62 +452,86 @@ void Load_2_Simulation( void * pvParameters )
 
 int main( void )
 {
+	/* Periods of the periodic tasks, indexed by their slot. */
+	const TickType_t xPeriods[NUMBER_OF_PERIODIC_TASKS] = {
+		Load_1_Simulation_PERIOD, Load_2_Simulation_PERIOD, Periodic_Transmitter_PERIOD,
+		Uart_Receiver_PERIOD, Button_1_Monitor_PERIOD, Button_2_Monitor_PERIOD };
+	TickType_t xOffsets[NUMBER_OF_PERIODIC_TASKS];
+	static uint8_t ucReleaseCount[HYPERPERIOD];
+
 	/* Setup the hardware for use with the Keil demo board. */
 	prvSetupHardware();
+
+	/* Spread the first releases so the tasks do not all line up on the same
+	tick every hyperperiod. On failure all offsets are 0. */
+	(void)xTaskComputeReleaseOffsets(xPeriods, xOffsets, NUMBER_OF_PERIODIC_TASKS, ucReleaseCount, HYPERPERIOD);
 	
-   /* Create the queue used to send pointers to struct AMessage structures. */
-  xPointerQueue = xQueueCreate(1,                    /* The number of items the queue can hold. */
-                         sizeof( char *) );/* Size of each item is big enough to hold only a pointer. */                     
-                         
+	/* Create the ring used to send messages to the UART task. */
+	vMessageRingInit( &xMessageRing, xMessageSlots, MESSAGE_RING_SLOTS );
+	vMessagePoolInit( &xMessagePool, ulMessagePoolStorage, UART_RECORD_SIZE, MESSAGE_POOL_BLOCKS );
+
+	/* Time the load loop against timer 1 while nothing can preempt it. */
+	vLoadGeneratorCalibrate();
+	vLoadGeneratorProfileInit( &xLoad_1_Profile, Load_1_Simulation_DISTRIBUTION, Load_1_Simulation_LOW_US,
+		Load_1_Simulation_HIGH_US, LOAD_HIGH_PER_MILLE, LOAD_SEED );
+	vLoadGeneratorProfileInit( &xLoad_2_Profile, Load_2_Simulation_DISTRIBUTION, Load_2_Simulation_LOW_US,
+		Load_2_Simulation_HIGH_US, LOAD_HIGH_PER_MILLE, LOAD_SEED + 1 );
+
+#if ( MESSAGE_BENCHMARK == 1 )
+	prvBenchmarkMessagePaths();
+#endif
+#if ( RUN_TIME_BENCHMARK == 1 )
+	prvBenchmarkRunTimeCounter();
+#endif
 	
   /* Create the task, storing the handle. */
-	xPeriodicTaskCreate(
+	xPeriodicTaskCreateWithOffset(
                     Load_1_Simulation,       			/* Function that implements the task. */
                     "LOAD1 1 TASK",         			/* Text name for the task. */
                     100,      										/* Stack size in words, not bytes. */
-                    ( void * ) 0,    							/* Parameter passed into the task. */
+                    ( void * ) 1,    							/* Parameter passed into the task. */
                     fixed_Priority,								/* Priority at which the task is created. */
-                    &Load_1_Simulation_Handler ,Load_1_Simulation_PERIOD );      /* Used to pass out the created task's handle. */
+                    &Load_1_Simulation_Handler ,Load_1_Simulation_PERIOD, xOffsets[Load_1_Simulation_SLOT] );      /* Used to pass out the created task's handle. */
 
-	xPeriodicTaskCreate(
+	xPeriodicTaskCreateWithOffset(
                     Load_2_Simulation,       			/* Function that implements the task. */
                     "LOAD 2 TASK",         	 			/* Text name for the task. */
                     100,      										/* Stack size in words, not bytes. */
-                    ( void * ) 0,    							/* Parameter passed into the task. */
+                    ( void * ) 1,    							/* Parameter passed into the task. */
                     fixed_Priority,								/* Priority at which the task is created. */
-                    &Load_2_Simulation_Handler,Load_2_Simulation_PERIOD );      /* Used to pass out the created task's handle. */
+                    &Load_2_Simulation_Handler,Load_2_Simulation_PERIOD, xOffsets[Load_2_Simulation_SLOT] );      /* Used to pass out the created task's handle. */
 
   	
-  xPeriodicTaskCreate(
+  xPeriodicTaskCreateWithOffset(
                     Periodic_Transmitter,       	/* Function that implements the task. */
                     "Transmitter Task",          	/* Text name for the task. */
                     100,      										/* Stack size in words, not bytes. */
-                    ( void * ) 0,    							/* Parameter passed into the task. */
+                    ( void * ) 1,    							/* Parameter passed into the task. */
                     fixed_Priority,								/* Priority at which the task is created. */
-                    &Periodic_Transmitter_Handler,Periodic_Transmitter_PERIOD );      /* Used to pass out the created task's handle. */
+                    &Periodic_Transmitter_Handler,Periodic_Transmitter_PERIOD, xOffsets[Periodic_Transmitter_SLOT] );      /* Used to pass out the created task's handle. */
 
-	xPeriodicTaskCreate(
+	xPeriodicTaskCreateWithOffset(
                     Uart_Receiver,       					/* Function that implements the task. */
                     "UART Task",          				/* Text name for the task. */
                     100,      										/* Stack size in words, not bytes. */
-                    ( void * ) 0,    							/* Parameter passed into the task. */
+                    ( void * ) 1,    							/* Parameter passed into the task. */
                     fixed_Priority,								/* Priority at which the task is created. */
-                    &UART_Task_Handler,Uart_Receiver_PERIOD );      /* Used to pass out the created task's handle. */
-	xPeriodicTaskCreate(
+                    &UART_Task_Handler,Uart_Receiver_PERIOD, xOffsets[Uart_Receiver_SLOT] );      /* Used to pass out the created task's handle. */
+	xPeriodicTaskCreateWithOffset(
                     Button_1_Monitor,       			/* Function that implements the task. */
                     "Button 1 Task",          		/* Text name for the task. */
                     100,      										/* Stack size in words, not bytes. */
-                    ( void * ) 0,    							/* Parameter passed into the task. */
+                    ( void * ) 1,    							/* Parameter passed into the task. */
                     fixed_Priority,								/* Priority at which the task is created. */
-                    &Button_1_Monitor_Handler,Button_1_Monitor_PERIOD );      /* Used to pass out the created task's handle. */
+                    &Button_1_Monitor_Handler,Button_1_Monitor_PERIOD, xOffsets[Button_1_Monitor_SLOT] );      /* Used to pass out the created task's handle. */
 
-	xPeriodicTaskCreate(
+	xPeriodicTaskCreateWithOffset(
                     Button_2_Monitor,       			/* Function that implements the task. */
                     "Button 2 Task",          		/* Text name for the task. */
                     100,      										/* Stack size in words, not bytes. */
-                    ( void * ) 0,    							/* Parameter passed into the task. */
+                    ( void * ) 1,    							/* Parameter passed into the task. */
                     fixed_Priority,								/* Priority at which the task is created. */
-                    &Button_2_Monitor_Handler ,Button_2_Monitor_PERIOD);      /* Used to pass out the created task's handle. */
+                    &Button_2_Monitor_Handler ,Button_2_Monitor_PERIOD, xOffsets[Button_2_Monitor_SLOT]);      /* Used to pass out the created task's handle. */
 								
 
 /*	set tasks' tags		*/ 
@@ -392,6 +542,19 @@ int main( void )
 	vTaskSetApplicationTaskTag(	Periodic_Transmitter_Handler,	(void *)TRANSMITTER_TASK_ID);
 	vTaskSetApplicationTaskTag( UART_Task_Handler,						(void*)UARTRECIEVER_TASK_ID );
 
+/*	admit each task's share of the processor, so the utilisation, slack and
+	overload figures describe the real load */
+	( void ) xTaskSetWCET( Load_1_Simulation_Handler,		Load_1_Simulation_WCET );
+	( void ) xTaskSetWCET( Load_2_Simulation_Handler,		Load_2_Simulation_WCET );
+	( void ) xTaskSetWCET( Periodic_Transmitter_Handler,	SHORT_TASK_WCET );
+	( void ) xTaskSetWCET( UART_Task_Handler,						SHORT_TASK_WCET );
+	( void ) xTaskSetWCET( Button_1_Monitor_Handler,			SHORT_TASK_WCET );
+	( void ) xTaskSetWCET( Button_2_Monitor_Handler,			SHORT_TASK_WCET );
+
+/*	the transmitter may lose a message now and then, but not two in a row:
+	under overload the kernel skips at most one of every two of its jobs */
+	(void)xTaskSetFirmConstraint( Periodic_Transmitter_Handler, TRANSMITTER_FIRM_M, TRANSMITTER_FIRM_K );
+
 /* Now all the tasks have been started - start the scheduler. */
 	vTaskStartScheduler();
 	
@@ -401,6 +564,163 @@ int main( void )
 }
 /*-----------------------------------------------------------*/
 
+static void prvSendMessage( const char * pcMessage )
+{
+	char * pcRecord;
+	size_t xLength;
+
+	/* An exhausted pool drops the message, the pool counts it. */
+	pcRecord = pvMessagePoolAlloc( &xMessagePool );
+	if( pcRecord != NULL )
+	{
+		xLength = strlen( pcMessage );
+		if( xLength > ( UART_RECORD_SIZE - 1 ) )
+		{
+			xLength = UART_RECORD_SIZE - 1;
+		}
+		pcRecord[ 0 ] = '\n';
+		memcpy( &pcRecord[ 1 ], pcMessage, xLength );
+
+		/* The ring counts its own drops, the block goes straight back. */
+		if( xMessageRingSend( &xMessageRing, pcRecord, xLength + 1 ) != pdPASS )
+		{
+			vMessagePoolRelease( pcRecord );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( MESSAGE_BENCHMARK == 1 )
+
+/* Time MESSAGE_BENCHMARK_ROUNDS send/receive pairs through the message ring,
+then through a queue of the same depth. Called before the scheduler starts so
+nothing else runs in between. */
+static void prvBenchmarkMessagePaths( void )
+{
+	QueueHandle_t xQueue;
+	MessageDescriptor_t xMessage;
+	char * pcReceived;
+	const size_t xLength = strlen( Transmitting_Task );
+	unsigned int uiStart;
+	int i;
+
+	uiStart = T1TC;
+	for( i = 0; i < MESSAGE_BENCHMARK_ROUNDS; i++ )
+	{
+		( void ) xMessageRingSend( &xMessageRing, Transmitting_Task, xLength );
+		( void ) xMessageRingReceive( &xMessageRing, &xMessage, ( TickType_t ) 0 );
+	}
+	Ring_Benchmark_Time = T1TC - uiStart;
+
+	xQueue = xQueueCreate( MESSAGE_RING_SLOTS, sizeof( char * ) );
+	configASSERT( xQueue );
+
+	uiStart = T1TC;
+	for( i = 0; i < MESSAGE_BENCHMARK_ROUNDS; i++ )
+	{
+		( void ) xQueueSend( xQueue, ( void * ) &Transmitting_Task, ( TickType_t ) 0 );
+		( void ) xQueueReceive( xQueue, &pcReceived, ( TickType_t ) 0 );
+	}
+	Queue_Benchmark_Time = T1TC - uiStart;
+
+	vQueueDelete( xQueue );
+}
+
+#endif /* MESSAGE_BENCHMARK */
+/*-----------------------------------------------------------*/
+
+#if ( RUN_TIME_BENCHMARK == 1 )
+
+/* Time RUN_TIME_BENCHMARK_ROUNDS extended reads, then as many raw T1TC reads.
+Called before the scheduler starts so no tick lands in between. */
+static void prvBenchmarkRunTimeCounter( void )
+{
+	volatile uint64_t ullSink;
+	volatile uint32_t ulSink;
+	unsigned int uiStart;
+	int i;
+
+	uiStart = T1TC;
+	for( i = 0; i < RUN_TIME_BENCHMARK_ROUNDS; i++ )
+	{
+		ullSink = ullGetRunTimeCounterValue();
+	}
+	RunTime_Benchmark_Time = T1TC - uiStart;
+
+	uiStart = T1TC;
+	for( i = 0; i < RUN_TIME_BENCHMARK_ROUNDS; i++ )
+	{
+		ulSink = T1TC;
+	}
+	T1TC_Benchmark_Time = T1TC - uiStart;
+
+	( void ) ullSink;
+	( void ) ulSink;
+}
+
+#endif /* RUN_TIME_BENCHMARK */
+/*-----------------------------------------------------------*/
+
+/* Timer 1 count extended to 64 bits, used as the kernel run time counter.
+A wrap is seen as T1TC dropping below the value the tick hook last saw. The
+tick hook runs far more often than T1TC wraps (hours at 60 kHz) so at most one
+wrap can be pending. Nothing is written here, so a read costs a few loads and
+no critical section. A reader the tick interrupts retries, which cannot happen
+in the context switch path as it runs with interrupts masked. */
+uint64_t ullGetRunTimeCounterValue( void )
+{
+	uint32_t ulUpdates, ulHigh, ulLastLow, ulLow;
+
+	do
+	{
+		ulUpdates = ulRunTimeUpdates;
+		ulHigh = ulRunTimeHigh;
+		ulLastLow = ulRunTimeLastLow;
+		ulLow = T1TC;
+	} while( ulUpdates != ulRunTimeUpdates );
+
+	if( ulLow < ulLastLow )
+	{
+		ulHigh++;
+	}
+
+	return ( ( ( uint64_t ) ulHigh ) << 32 ) | ( uint64_t ) ulLow;
+}
+
+/* The switched out hook only keeps 64 bit sums, the float division is done
+here, once per job of this task, rather than on every context switch. The
+sums are copied in a critical section as a 64 bit read takes two loads. */
+static void prvUpdateCPULoad( void )
+{
+	uint64_t ullExecution, ullTime;
+
+	taskENTER_CRITICAL();
+	{
+		ullExecution = totalExecution;
+		ullTime = totalTime;
+	}
+	taskEXIT_CRITICAL();
+
+	if( ullTime != 0 )
+	{
+		CPU_Load = ( float ) ullExecution / ( float ) ullTime * 100;
+	}
+}
+
+/* Called from the tick hook, with interrupts masked. */
+static void prvUpdateRunTimeCounter( void )
+{
+	const uint32_t ulLow = T1TC;
+
+	if( ulLow < ulRunTimeLastLow )
+	{
+		ulRunTimeHigh++;
+	}
+	ulRunTimeLastLow = ulLow;
+	ulRunTimeUpdates++;
+}
+/*-----------------------------------------------------------*/
+
 /* Function to reset timer 1 */
 void timer1Reset(void)
 {
@@ -420,8 +740,9 @@ static void prvSetupHardware( void )
 	/* Perform the hardware setup required.  This is minimal as most of the
 	setup is managed by the settings in the project file. */
 
-	/* Configure UART */
+	/* Configure UART, then move transmission to the FIFO interrupt */
 	xSerialPortInitMinimal(mainCOM_TEST_BAUD_RATE);
+	( void ) xUartTxInit( UART_TX_BUFFER_SIZE );
 
 	/* Configure GPIO */
 	GPIO_init();
@@ -434,6 +755,7 @@ static void prvSetupHardware( void )
 }
 void vApplicationTickHook(void)
 {
+	prvUpdateRunTimeCounter();
 	GPIO_write(PORT_0,PIN0,PIN_IS_LOW);
 	GPIO_write(PORT_0,PIN0,PIN_IS_HIGH);
 }
@@ -0,0 +1,206 @@
+/*
+ * Fixed-block message pool with reference counted buffers.  See
+ * message_pool.h for the API.
+ *
+ * Free blocks form a singly linked stack threaded through their headers, so
+ * allocation and release are a push or a pop.  As in message_ring.c the
+ * ARMv4T core has no exclusive load/store instructions, so the few
+ * instructions that update the free list and the reference counts run with
+ * interrupts masked.
+ */
+
+/* Standard includes. */
+#include <stddef.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_pool.h"
+
+/* Header of the block whose payload starts at pvBlock, and the reverse. */
+#define messagepoolHEADER(pvBlock) (((MessagePoolBlockHeader_t *)(pvBlock)) - 1)
+#define messagepoolPAYLOAD(pxHeader) ((void *)((pxHeader) + 1))
+
+/*
+ * Pop a block off the free list.  Must be called with interrupts masked.
+ */
+static void *prvTakeBlock(MessagePool_t *pxPool);
+
+/*
+ * Drop a reference, pushing the block back onto the free list if it was the
+ * last one.  Must be called with interrupts masked.
+ */
+static void prvDropReference(MessagePoolBlockHeader_t *pxHeader);
+/*-----------------------------------------------------------*/
+
+void vMessagePoolInit(MessagePool_t *pxPool,
+                      uint32_t *pulStorage,
+                      size_t xBlockSize,
+                      UBaseType_t uxNumberOfBlocks)
+{
+    MessagePoolBlockHeader_t *pxHeader;
+    UBaseType_t uxBlock;
+
+    configASSERT(pxPool);
+    configASSERT(pulStorage);
+    configASSERT(uxNumberOfBlocks > (UBaseType_t)0U);
+
+    pxPool->pxFreeList = NULL;
+    pxPool->xBlockSize = xBlockSize;
+    pxPool->uxNumberOfBlocks = uxNumberOfBlocks;
+    pxPool->uxFreeBlocks = uxNumberOfBlocks;
+    pxPool->uxMinimumEverFreeBlocks = uxNumberOfBlocks;
+    pxPool->ulAllocations = 0UL;
+    pxPool->ulExhaustions = 0UL;
+
+    /* Push the blocks in reverse so they are handed out in address order. */
+    for (uxBlock = uxNumberOfBlocks; uxBlock > (UBaseType_t)0U; uxBlock--)
+    {
+        pxHeader = (MessagePoolBlockHeader_t *)&(pulStorage[(uxBlock - (UBaseType_t)1U) * messagepoolBLOCK_WORDS(xBlockSize)]);
+        pxHeader->pxPool = pxPool;
+        pxHeader->uxReferenceCount = (UBaseType_t)0U;
+        pxHeader->pxNextFree = pxPool->pxFreeList;
+        pxPool->pxFreeList = pxHeader;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTakeBlock(MessagePool_t *pxPool)
+{
+    MessagePoolBlockHeader_t *const pxHeader = pxPool->pxFreeList;
+    void *pvReturn = NULL;
+
+    if (pxHeader != NULL)
+    {
+        pxPool->pxFreeList = pxHeader->pxNextFree;
+        pxHeader->pxNextFree = NULL;
+        pxHeader->uxReferenceCount = (UBaseType_t)1U;
+
+        pxPool->uxFreeBlocks--;
+        pxPool->ulAllocations++;
+
+        if (pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks)
+        {
+            pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+        }
+
+        pvReturn = messagepoolPAYLOAD(pxHeader);
+    }
+    else
+    {
+        pxPool->ulExhaustions++;
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDropReference(MessagePoolBlockHeader_t *pxHeader)
+{
+    MessagePool_t *const pxPool = pxHeader->pxPool;
+
+    /* Releasing a free block means a reference was dropped twice. */
+    configASSERT(pxHeader->uxReferenceCount > (UBaseType_t)0U);
+
+    pxHeader->uxReferenceCount--;
+
+    if (pxHeader->uxReferenceCount == (UBaseType_t)0U)
+    {
+        pxHeader->pxNextFree = pxPool->pxFreeList;
+        pxPool->pxFreeList = pxHeader;
+        pxPool->uxFreeBlocks++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void *pvMessagePoolAlloc(MessagePool_t *pxPool)
+{
+    void *pvReturn;
+
+    configASSERT(pxPool);
+
+    taskENTER_CRITICAL();
+    {
+        pvReturn = prvTakeBlock(pxPool);
+    }
+    taskEXIT_CRITICAL();
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMessagePoolAllocFromISR(MessagePool_t *pxPool)
+{
+    void *pvReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(pxPool);
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pvReturn = prvTakeBlock(pxPool);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolRetain(void *pvBlock)
+{
+    MessagePoolBlockHeader_t *const pxHeader = messagepoolHEADER(pvBlock);
+
+    configASSERT(pvBlock);
+
+    taskENTER_CRITICAL();
+    {
+        /* Only a holder of a reference may add another. */
+        configASSERT(pxHeader->uxReferenceCount > (UBaseType_t)0U);
+        pxHeader->uxReferenceCount++;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolRelease(void *pvBlock)
+{
+    configASSERT(pvBlock);
+
+    taskENTER_CRITICAL();
+    {
+        prvDropReference(messagepoolHEADER(pvBlock));
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolReleaseFromISR(void *pvBlock)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(pvBlock);
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        prvDropReference(messagepoolHEADER(pvBlock));
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+/*-----------------------------------------------------------*/
+
+void vMessagePoolGetStats(MessagePool_t *pxPool,
+                          MessagePoolStats_t *pxPoolStats)
+{
+    configASSERT(pxPool);
+    configASSERT(pxPoolStats);
+
+    taskENTER_CRITICAL();
+    {
+        pxPoolStats->uxFreeBlocks = pxPool->uxFreeBlocks;
+        pxPoolStats->uxMinimumEverFreeBlocks = pxPool->uxMinimumEverFreeBlocks;
+        pxPoolStats->ulAllocations = pxPool->ulAllocations;
+        pxPoolStats->ulExhaustions = pxPool->ulExhaustions;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
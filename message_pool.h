@@ -0,0 +1,142 @@
+/*
+ * Fixed-block message pool with reference counted buffers.
+ *
+ * A producer allocates a block, writes its payload in place and passes the
+ * block pointer on, for example through a message ring.  The payload is never
+ * copied between tasks.  Each holder of a block that keeps it beyond the
+ * hand-over takes a reference with vMessagePoolRetain(), and every reference
+ * is dropped with vMessagePoolRelease().  The block returns to its pool when
+ * the last reference is dropped.
+ *
+ * Allocation and release are O(1) and can be done from interrupts.  A failed
+ * allocation never blocks; it is counted so exhaustion shows up in the
+ * statistics.
+ */
+
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+#ifndef INC_TASK_H
+#error "include task.h must appear in source files before include message_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+struct xMESSAGE_POOL;
+
+/* Stored in front of each block.  Word sized members only, so the payload
+ * that follows is word aligned. */
+typedef struct xMESSAGE_POOL_BLOCK_HEADER
+{
+    struct xMESSAGE_POOL *pxPool;                    /*< Pool the block is returned to. */
+    struct xMESSAGE_POOL_BLOCK_HEADER *pxNextFree;   /*< Next block in the free list. */
+    volatile UBaseType_t uxReferenceCount;           /*< 0 while the block is free. */
+} MessagePoolBlockHeader_t;
+
+/* The pool itself.  Members should not be accessed directly. */
+typedef struct xMESSAGE_POOL
+{
+    MessagePoolBlockHeader_t *pxFreeList;
+    size_t xBlockSize;
+    UBaseType_t uxNumberOfBlocks;
+    UBaseType_t uxFreeBlocks;
+    UBaseType_t uxMinimumEverFreeBlocks;
+    uint32_t ulAllocations;
+    uint32_t ulExhaustions;
+} MessagePool_t;
+
+/* Used to pass information about a pool out of vMessagePoolGetStats(). */
+typedef struct xMESSAGE_POOL_STATS
+{
+    UBaseType_t uxFreeBlocks;            /* The number of blocks currently free. */
+    UBaseType_t uxMinimumEverFreeBlocks; /* The fewest free blocks there have been since the pool was initialised. */
+    uint32_t ulAllocations;              /* The number of successful allocations. */
+    uint32_t ulExhaustions;              /* The number of allocations that failed because the pool was empty. */
+} MessagePoolStats_t;
+
+/* Number of uint32_t words of storage needed for uxNumberOfBlocks blocks with
+ * xBlockSize byte payloads.  Use it to size the array given to
+ * vMessagePoolInit(). */
+#define messagepoolBLOCK_WORDS(xBlockSize) \
+    ((sizeof(MessagePoolBlockHeader_t) + (xBlockSize) + sizeof(uint32_t) - 1U) / sizeof(uint32_t))
+#define messagepoolSTORAGE_WORDS(xBlockSize, uxNumberOfBlocks) \
+    (messagepoolBLOCK_WORDS(xBlockSize) * (uxNumberOfBlocks))
+
+/**
+ * void vMessagePoolInit( MessagePool_t *pxPool,
+ *                        uint32_t *pulStorage,
+ *                        size_t xBlockSize,
+ *                        UBaseType_t uxNumberOfBlocks );
+ *
+ * Split pulStorage, which must be messagepoolSTORAGE_WORDS( xBlockSize,
+ * uxNumberOfBlocks ) words long, into uxNumberOfBlocks free blocks of
+ * xBlockSize bytes each.  Must be called before any task or interrupt uses the
+ * pool.
+ */
+void vMessagePoolInit(MessagePool_t *pxPool,
+                      uint32_t *pulStorage,
+                      size_t xBlockSize,
+                      UBaseType_t uxNumberOfBlocks);
+
+/**
+ * void *pvMessagePoolAlloc( MessagePool_t *pxPool );
+ *
+ * Take a block from pxPool, holding one reference.
+ *
+ * @return A pointer to the payload of the block, or NULL if the pool is
+ * exhausted.
+ */
+void *pvMessagePoolAlloc(MessagePool_t *pxPool);
+
+/**
+ * void *pvMessagePoolAllocFromISR( MessagePool_t *pxPool );
+ *
+ * A version of pvMessagePoolAlloc() that can be called from an interrupt
+ * service routine.
+ */
+void *pvMessagePoolAllocFromISR(MessagePool_t *pxPool);
+
+/**
+ * void vMessagePoolRetain( void *pvBlock );
+ *
+ * Add a reference to the block whose payload starts at pvBlock, so it stays
+ * valid until a matching vMessagePoolRelease().
+ */
+void vMessagePoolRetain(void *pvBlock);
+
+/**
+ * void vMessagePoolRelease( void *pvBlock );
+ *
+ * Drop a reference to the block whose payload starts at pvBlock.  The block
+ * is returned to its pool when no references are left.
+ */
+void vMessagePoolRelease(void *pvBlock);
+
+/**
+ * void vMessagePoolReleaseFromISR( void *pvBlock );
+ *
+ * A version of vMessagePoolRelease() that can be called from an interrupt
+ * service routine.
+ */
+void vMessagePoolReleaseFromISR(void *pvBlock);
+
+/**
+ * void vMessagePoolGetStats( MessagePool_t *pxPool,
+ *                            MessagePoolStats_t *pxPoolStats );
+ *
+ * Fill *pxPoolStats with the current state of pxPool.
+ */
+void vMessagePoolGetStats(MessagePool_t *pxPool,
+                          MessagePoolStats_t *pxPoolStats);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* MESSAGE_POOL_H */
@@ -0,0 +1,252 @@
+/*
+ * Multi-producer, single-consumer ring of message descriptors.  See
+ * message_ring.h for the API.
+ *
+ * Each slot carries a sequence number.  A slot at ring position uxPos is free
+ * for a producer when its sequence is uxPos, and holds a message for the
+ * consumer when its sequence is uxPos + 1.  The consumer hands the slot back
+ * for the next lap by setting its sequence to uxPos + the number of slots.
+ * Producers and the consumer therefore only share the slots, and the consumer
+ * never needs a critical section.
+ *
+ * The ARM7TDMI (ARMv4T) has no exclusive load/store instructions to claim a
+ * slot with a compare and swap, so producers claim their slot with
+ * interrupts masked.  That covers the few instructions that check and advance
+ * uxHead.  Filling in and publishing the slot is done with interrupts
+ * enabled.
+ *
+ * The ARM7TDMI is a single core that does not reorder memory accesses, so
+ * only the compiler could move a slot access across the sequence number.  The
+ * slots are volatile to stop it.
+ */
+
+/* Standard includes. */
+#include <stddef.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_ring.h"
+
+/*
+ * Claim the slot for the next message, or return NULL if the ring is full.
+ * Must be called with interrupts masked.
+ */
+static MessageRingSlot_t *prvClaimSlot(MessageRing_t *pxRing);
+
+/*
+ * Fill in and publish a claimed slot.  Returns pdTRUE if the consumer is
+ * waiting for a message and must be notified.
+ */
+static BaseType_t prvPublishSlot(MessageRing_t *pxRing,
+                                 MessageRingSlot_t *pxSlot,
+                                 const void *pvData,
+                                 size_t xLength);
+
+/*
+ * Take the oldest published message, if any.  Consumer only.
+ */
+static BaseType_t prvTakeMessage(MessageRing_t *pxRing,
+                                 MessageDescriptor_t *pxMessage);
+/*-----------------------------------------------------------*/
+
+void vMessageRingInit(MessageRing_t *pxRing,
+                      MessageRingSlot_t *pxSlots,
+                      UBaseType_t uxNumberOfSlots)
+{
+    UBaseType_t uxSlot;
+
+    configASSERT(pxRing);
+    configASSERT(pxSlots);
+
+    /* The positions wrap, so the ring size must divide their range. */
+    configASSERT(uxNumberOfSlots > (UBaseType_t)0U);
+    configASSERT((uxNumberOfSlots & (uxNumberOfSlots - (UBaseType_t)1U)) == (UBaseType_t)0U);
+
+    for (uxSlot = 0; uxSlot < uxNumberOfSlots; uxSlot++)
+    {
+        pxSlots[uxSlot].uxSequence = uxSlot;
+        pxSlots[uxSlot].xMessage.pvData = NULL;
+        pxSlots[uxSlot].xMessage.xLength = 0;
+    }
+
+    pxRing->pxSlots = pxSlots;
+    pxRing->uxMask = uxNumberOfSlots - (UBaseType_t)1U;
+    pxRing->uxHead = 0;
+    pxRing->uxTail = 0;
+    pxRing->ulDropCount = 0UL;
+    pxRing->xConsumer = NULL;
+    pxRing->xConsumerWaiting = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static MessageRingSlot_t *prvClaimSlot(MessageRing_t *pxRing)
+{
+    MessageRingSlot_t *pxSlot = &(pxRing->pxSlots[pxRing->uxHead & pxRing->uxMask]);
+
+    if (pxSlot->uxSequence == pxRing->uxHead)
+    {
+        pxRing->uxHead++;
+    }
+    else
+    {
+        /* The consumer has not released this slot from the previous lap
+         * yet. */
+        pxRing->ulDropCount++;
+        pxSlot = NULL;
+    }
+
+    return pxSlot;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPublishSlot(MessageRing_t *pxRing,
+                                 MessageRingSlot_t *pxSlot,
+                                 const void *pvData,
+                                 size_t xLength)
+{
+    BaseType_t xNotifyConsumer = pdFALSE;
+
+    pxSlot->xMessage.pvData = pvData;
+    pxSlot->xMessage.xLength = xLength;
+
+    /* The claimed position is the sequence the slot had when it was
+     * claimed.  Only this producer writes the slot until it is published. */
+    pxSlot->uxSequence = pxSlot->uxSequence + (UBaseType_t)1U;
+
+    if (pxRing->xConsumerWaiting != pdFALSE)
+    {
+        pxRing->xConsumerWaiting = pdFALSE;
+        xNotifyConsumer = pdTRUE;
+    }
+
+    return xNotifyConsumer;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeMessage(MessageRing_t *pxRing,
+                                 MessageDescriptor_t *pxMessage)
+{
+    MessageRingSlot_t *const pxSlot = &(pxRing->pxSlots[pxRing->uxTail & pxRing->uxMask]);
+    BaseType_t xReturn = pdFAIL;
+
+    /* A slot that is claimed but not yet published also reads as empty.
+     * Messages behind it wait until its producer has finished. */
+    if (pxSlot->uxSequence == (pxRing->uxTail + (UBaseType_t)1U))
+    {
+        pxMessage->pvData = pxSlot->xMessage.pvData;
+        pxMessage->xLength = pxSlot->xMessage.xLength;
+
+        /* Hand the slot back to the producers for the next lap. */
+        pxSlot->uxSequence = pxRing->uxTail + pxRing->uxMask + (UBaseType_t)1U;
+        pxRing->uxTail++;
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessageRingSend(MessageRing_t *pxRing,
+                            const void *pvData,
+                            size_t xLength)
+{
+    MessageRingSlot_t *pxSlot;
+
+    configASSERT(pxRing);
+
+    taskENTER_CRITICAL();
+    {
+        pxSlot = prvClaimSlot(pxRing);
+    }
+    taskEXIT_CRITICAL();
+
+    if (pxSlot == NULL)
+    {
+        return pdFAIL;
+    }
+
+    if (prvPublishSlot(pxRing, pxSlot, pvData, xLength) != pdFALSE)
+    {
+        xTaskNotifyGive(pxRing->xConsumer);
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessageRingSendFromISR(MessageRing_t *pxRing,
+                                   const void *pvData,
+                                   size_t xLength,
+                                   BaseType_t *pxHigherPriorityTaskWoken)
+{
+    MessageRingSlot_t *pxSlot;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(pxRing);
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pxSlot = prvClaimSlot(pxRing);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+    if (pxSlot == NULL)
+    {
+        return pdFAIL;
+    }
+
+    if (prvPublishSlot(pxRing, pxSlot, pvData, xLength) != pdFALSE)
+    {
+        vTaskNotifyGiveFromISR(pxRing->xConsumer, pxHigherPriorityTaskWoken);
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessageRingReceive(MessageRing_t *pxRing,
+                               MessageDescriptor_t *pxMessage,
+                               TickType_t xTicksToWait)
+{
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn;
+
+    configASSERT(pxRing);
+    configASSERT(pxMessage);
+
+    xReturn = prvTakeMessage(pxRing, pxMessage);
+
+    if ((xReturn == pdFAIL) && (xTicksToWait > (TickType_t)0U))
+    {
+        vTaskSetTimeOutState(&xTimeOut);
+        pxRing->xConsumer = xTaskGetCurrentTaskHandle();
+
+        do
+        {
+            /* Ask the producers for a notification, then look again in case
+             * a message was published before they could see the request. */
+            pxRing->xConsumerWaiting = pdTRUE;
+            xReturn = prvTakeMessage(pxRing, pxMessage);
+
+            if (xReturn == pdFAIL)
+            {
+                (void)ulTaskNotifyTake(pdTRUE, xTicksToWait);
+                xReturn = prvTakeMessage(pxRing, pxMessage);
+            }
+        } while ((xReturn == pdFAIL) && (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE));
+
+        pxRing->xConsumerWaiting = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulMessageRingGetDropCount(const MessageRing_t *pxRing)
+{
+    configASSERT(pxRing);
+
+    return pxRing->ulDropCount;
+}
+/*-----------------------------------------------------------*/
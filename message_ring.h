@@ -0,0 +1,132 @@
+/*
+ * Multi-producer, single-consumer ring of message descriptors.
+ *
+ * A message is passed by reference: the ring holds a descriptor (pointer and
+ * length), never a copy of the payload, so the payload must remain valid
+ * until the consumer is done with it.  Any number of tasks and interrupts can
+ * send to a ring, but only one task may receive from it.
+ *
+ * A send never blocks.  If the ring is full the message is dropped and
+ * counted, see ulMessageRingGetDropCount().  The consumer can either poll the
+ * ring from a periodic job, or block until a message arrives.
+ */
+
+#ifndef MESSAGE_RING_H
+#define MESSAGE_RING_H
+
+#ifndef INC_TASK_H
+#error "include task.h must appear in source files before include message_ring.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* A message passed through a ring. */
+typedef struct xMESSAGE_DESCRIPTOR
+{
+    const void *pvData; /*< Points to the payload, which is not copied. */
+    size_t xLength;     /*< Length of the payload in bytes. */
+} MessageDescriptor_t;
+
+/* One entry of the storage array given to vMessageRingInit().  The sequence
+ * number tells the producers and the consumer whether the slot is free or
+ * holds a message, so they never have to look at each other's indexes.  The
+ * message is volatile too, so the compiler keeps its accesses in order with
+ * those of the sequence number: a producer fills the slot before it publishes
+ * it, and the consumer copies it before it hands it back. */
+typedef struct xMESSAGE_RING_SLOT
+{
+    volatile UBaseType_t uxSequence;
+    volatile MessageDescriptor_t xMessage;
+} MessageRingSlot_t;
+
+/* The ring itself.  Declare one per channel and initialise it with
+ * vMessageRingInit() before it is used.  The members should not be accessed
+ * directly. */
+typedef struct xMESSAGE_RING
+{
+    MessageRingSlot_t *pxSlots;
+    UBaseType_t uxMask;                     /*< Number of slots minus one. */
+    UBaseType_t uxHead;                     /*< Next slot a producer claims. */
+    UBaseType_t uxTail;                     /*< Next slot the consumer reads. */
+    volatile uint32_t ulDropCount;          /*< Messages dropped because the ring was full. */
+    TaskHandle_t xConsumer;                 /*< Task blocked in xMessageRingReceive(), if any. */
+    volatile BaseType_t xConsumerWaiting;   /*< pdTRUE while xConsumer should be notified. */
+} MessageRing_t;
+
+/**
+ * void vMessageRingInit( MessageRing_t *pxRing,
+ *                        MessageRingSlot_t *pxSlots,
+ *                        UBaseType_t uxNumberOfSlots );
+ *
+ * Prepare pxRing for use, with pxSlots as its storage.  uxNumberOfSlots must
+ * be a power of two.  Must be called before any task or interrupt uses the
+ * ring, for example before the scheduler is started.
+ */
+void vMessageRingInit(MessageRing_t *pxRing,
+                      MessageRingSlot_t *pxSlots,
+                      UBaseType_t uxNumberOfSlots);
+
+/**
+ * BaseType_t xMessageRingSend( MessageRing_t *pxRing,
+ *                              const void *pvData,
+ *                              size_t xLength );
+ *
+ * Post a message to pxRing from a task.  Never blocks.
+ *
+ * @return pdPASS if the message was posted, pdFAIL if the ring was full and
+ * the message was dropped.
+ */
+BaseType_t xMessageRingSend(MessageRing_t *pxRing,
+                            const void *pvData,
+                            size_t xLength);
+
+/**
+ * BaseType_t xMessageRingSendFromISR( MessageRing_t *pxRing,
+ *                                     const void *pvData,
+ *                                     size_t xLength,
+ *                                     BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * A version of xMessageRingSend() that can be called from an interrupt
+ * service routine.  *pxHigherPriorityTaskWoken is set to pdTRUE if posting
+ * the message unblocked a consumer that should run before the interrupted
+ * task.
+ */
+BaseType_t xMessageRingSendFromISR(MessageRing_t *pxRing,
+                                   const void *pvData,
+                                   size_t xLength,
+                                   BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * BaseType_t xMessageRingReceive( MessageRing_t *pxRing,
+ *                                 MessageDescriptor_t *pxMessage,
+ *                                 TickType_t xTicksToWait );
+ *
+ * Take the oldest message from pxRing.  Only one task may receive from a
+ * given ring.  If the ring is empty the calling task blocks for up to
+ * xTicksToWait ticks for a message to arrive; use 0 to poll.  Blocking uses
+ * the calling task's direct to task notification.
+ *
+ * @return pdPASS if a message was written to *pxMessage, otherwise pdFAIL.
+ */
+BaseType_t xMessageRingReceive(MessageRing_t *pxRing,
+                               MessageDescriptor_t *pxMessage,
+                               TickType_t xTicksToWait);
+
+/**
+ * uint32_t ulMessageRingGetDropCount( const MessageRing_t *pxRing );
+ *
+ * @return The number of messages dropped because pxRing was full.
+ */
+uint32_t ulMessageRingGetDropCount(const MessageRing_t *pxRing);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* MESSAGE_RING_H */
@@ -40,6 +40,7 @@
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+#include "edf_scheduler.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -72,6 +73,17 @@
 #define taskWAITING_NOTIFICATION ((uint8_t)1)
 #define taskNOTIFICATION_RECEIVED ((uint8_t)2)
 
+/* E.C. Values that can be assigned to the ucSporadicState member of the TCB. */
+#define taskNOT_SPORADIC ((uint8_t)0)         /* Periodic task.  Must be zero as it is the initialised value. */
+#define taskSPORADIC_JOB_ACTIVE ((uint8_t)1)  /* A job has been released and has not yet called xTaskWaitForRelease(). */
+#define taskSPORADIC_WAITING ((uint8_t)2)     /* Blocked in xTaskWaitForRelease(). */
+#define taskSPORADIC_RELEASED ((uint8_t)3)    /* Released while waiting, the minimum inter-arrival time already enforced. */
+#define taskSPORADIC_DEFERRED ((uint8_t)4)    /* Released while waiting, the minimum inter-arrival time still to be checked. */
+
+/* E.C. Releases that arrive while a sporadic job is active are counted, up to
+ * this limit. */
+#define taskSPORADIC_MAX_PENDING_RELEASES ((uint8_t)0xFFU)
+
 /*
  * The value used to fill the stack of a task when the task is created.  This
  * is used purely for checking the high water mark for tasks.
@@ -115,6 +127,106 @@
 #define configIDLE_TASK_NAME "IDLE"
 #endif
 
+/* E.C. TCBs and stacks come from the heap unless the slab allocator is
+ * enabled in FreeRTOSConfig.h. */
+#ifndef configUSE_TASK_SLAB_ALLOCATOR
+#define configUSE_TASK_SLAB_ALLOCATOR 0
+#endif
+
+/* E.C. Called when the job of an (m,k)-firm task due at this tick is skipped.
+ * FreeRTOS.h does not know about it, so the default is defined here. */
+#ifndef traceTASK_JOB_SKIPPED
+#define traceTASK_JOB_SKIPPED(pxTCB)
+#endif
+
+/* E.C. Called by xTaskResumeAll() once it has merged uxTasks tasks, readied
+ * while the scheduler was suspended, into the EDF ready list. */
+#ifndef traceTASK_PENDING_READY_MERGED
+#define traceTASK_PENDING_READY_MERGED(uxTasks)
+#endif
+
+/* E.C. The most ready jobs the overload test of a firm job looks at, from the
+ * tick interrupt.  A longer ready list counts as overloaded. */
+#ifndef configFIRM_OVERLOAD_SCAN_LIMIT
+#define configFIRM_OVERLOAD_SCAN_LIMIT 8
+#endif
+
+/* E.C. The most deadlines the slack computation checks the processor demand
+ * at.  A schedule that needs more is taken to have no slack. */
+#ifndef configSLACK_MAX_CHECKPOINTS
+#define configSLACK_MAX_CHECKPOINTS 64
+#endif
+
+/* E.C. The number of work items xTaskRunInSlack() can hold. */
+#ifndef configSLACK_QUEUE_LENGTH
+#define configSLACK_QUEUE_LENGTH 4
+#endif
+
+/* E.C. Response time and start jitter histograms are not kept unless enabled
+ * in FreeRTOSConfig.h. */
+#ifndef configUSE_JOB_HISTOGRAMS
+#define configUSE_JOB_HISTOGRAMS 0
+#endif
+
+/* E.C. Completed jobs are not traced unless enabled in FreeRTOSConfig.h. */
+#ifndef configJOB_TRACE_LENGTH
+#define configJOB_TRACE_LENGTH 0
+#endif
+
+/* E.C. Context switches are not timed unless enabled in FreeRTOSConfig.h. */
+#ifndef configUSE_SWITCH_PROFILER
+#define configUSE_SWITCH_PROFILER 0
+#endif
+
+#if (configUSE_SWITCH_PROFILER == 1)
+
+#ifndef portPROFILER_GET_CYCLES
+#error "portPROFILER_GET_CYCLES() must be defined in FreeRTOSConfig.h when configUSE_SWITCH_PROFILER is 1"
+#endif
+
+/* E.C. 0 for a free running 32-bit counter. */
+#ifndef configPROFILER_COUNTER_PERIOD
+#define configPROFILER_COUNTER_PERIOD 0UL
+#endif
+
+/* E.C. Note the counter at the start of phase ePhase of vTaskSwitchContext(),
+ * which is also the end of the phase before it. */
+#define taskPROFILE_MARK(ePhase) ulProfileMarks[(ePhase)] = (uint32_t)portPROFILER_GET_CYCLES()
+#else
+#define taskPROFILE_MARK(ePhase)
+#endif
+
+/* E.C. The periodic and sporadic tasks, their periods and relative deadlines
+ * can be fixed at compile time, see edf_task_set.h.  EDF orders every ready
+ * job by its deadline alone, so the priority ready lists are only kept when
+ * the task set is not fixed. */
+#if (configUSE_EDF_SCHEDULER == 1) && (configUSE_EDF_STATIC_TASK_SET == 1)
+
+#include "edf_task_set.h"
+
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+#error "configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when configUSE_EDF_STATIC_TASK_SET is 1"
+#endif
+
+#define taskUSE_PRIORITY_READY_LISTS 0
+#else
+#define taskUSE_PRIORITY_READY_LISTS 1
+#endif
+
+#if (configUSE_EDF_SCHEDULER == 0) && (configUSE_EDF_STATIC_TASK_SET == 1)
+#error "configUSE_EDF_STATIC_TASK_SET can only be 1 when configUSE_EDF_SCHEDULER is 1"
+#endif
+
+/* E.C. pdTRUE if pxTCB is in the priority ready list of uxPriority.  Under EDF
+ * no task ever is, so without the lists the code that moves a task between
+ * them is compiled out. */
+#if (taskUSE_PRIORITY_READY_LISTS == 1)
+#define taskIS_IN_PRIORITY_READY_LIST(uxPriority, pxTCB) \
+    listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[(uxPriority)]), &((pxTCB)->xStateListItem))
+#else
+#define taskIS_IN_PRIORITY_READY_LIST(uxPriority, pxTCB) pdFALSE
+#endif
+
 #if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 0)
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -232,8 +344,156 @@ PRIVILEGED_DATA static List_t xReadyTasksListEDF;
     listINSERT_END(&(pxReadyTasksLists[(pxTCB)->uxPriority]), &((pxTCB)->xStateListItem)); \
     tracePOST_MOVED_TASK_TO_READY_STATE(pxTCB)
 #else
-#define prvAddTaskToReadyList(pxTCB) \
-    vListInsert(&(xReadyTasksListEDF), &((pxTCB)->xStateListItem))
+/* E.C. the state list item value is borrowed while the task is Blocked, so
+ * the deadline of its job is restored from the TCB. */
+#define prvAddTaskToReadyList(pxTCB)                                                   \
+    do                                                                                 \
+    {                                                                                  \
+        traceMOVED_TASK_TO_READY_STATE(pxTCB);                                         \
+        listSET_LIST_ITEM_VALUE(&((pxTCB)->xStateListItem), (pxTCB)->xTaskDeadline); \
+        vListInsert(&(xReadyTasksListEDF), &((pxTCB)->xStateListItem));              \
+        tracePOST_MOVED_TASK_TO_READY_STATE(pxTCB);                                    \
+    } while (0)
+#endif
+
+#if (configUSE_EDF_SCHEDULER == 1)
+
+/*
+ * E.C. A period or relative deadline set since the last release applies from
+ * the next job on, whether that job runs or is skipped.
+ */
+#define taskEDF_TAKE_NEXT_TIMING(pxTCB)                                              \
+    do                                                                               \
+    {                                                                                \
+        (pxTCB)->xTaskPeriod = (pxTCB)->xTaskNextPeriod;                             \
+        (pxTCB)->xTaskRelativeDeadline = (pxTCB)->xTaskNextRelativeDeadline;         \
+    } while (0)
+
+/*
+ * E.C. Release a new job of the task represented by pxTCB at xReleaseTime.  The
+ * absolute deadline of the job, chosen by prvJobDeadline() for the criticality
+ * mode, is also copied to the state list item value, which is what orders the
+ * EDF ready list.  The task is no longer waiting for its next period.
+ */
+#define prvReleaseJob(pxTCB, xReleaseTime)                                           \
+    do                                                                               \
+    {                                                                                \
+        taskEDF_TAKE_NEXT_TIMING(pxTCB);                                             \
+        (pxTCB)->xTaskReleaseTime = (xReleaseTime);                                  \
+        (pxTCB)->xTaskDeadline = prvJobDeadline(pxTCB);                              \
+        (pxTCB)->xJobExecutionTime = (TickType_t)0U;                                 \
+        (pxTCB)->ucWaitingForPeriod = (uint8_t)pdFALSE;                              \
+        taskEDF_CLEAR_JOB_STARTED(pxTCB);                                            \
+        listSET_LIST_ITEM_VALUE(&((pxTCB)->xStateListItem), (pxTCB)->xTaskDeadline); \
+    } while (0)
+
+/* E.C. Note that the job just released has not been switched in yet, so its
+ * start jitter, and the run time its execution is measured from, are recorded
+ * when pxTCB is next switched in. */
+#if (configJOB_TRACE_LENGTH > 0) && (configGENERATE_RUN_TIME_STATS == 1)
+#define taskEDF_STAMP_JOB_RUN_TIME(pxTCB) (pxTCB)->ulJobRunTimeStart = (pxTCB)->ulRunTimeCounter
+#else
+#define taskEDF_STAMP_JOB_RUN_TIME(pxTCB)
+#endif
+
+#if (configUSE_JOB_HISTOGRAMS == 1)
+#define taskEDF_RECORD_START_JITTER(pxTCB) prvRecordInHistogram(&((pxTCB)->xHistograms[eTaskHistogramStart]), xTickCount - (pxTCB)->xTaskReleaseTime)
+#else
+#define taskEDF_RECORD_START_JITTER(pxTCB)
+#endif
+
+#if (configUSE_JOB_HISTOGRAMS == 1) || ((configJOB_TRACE_LENGTH > 0) && (configGENERATE_RUN_TIME_STATS == 1))
+#define taskEDF_TRACK_JOB_START 1
+#define taskEDF_CLEAR_JOB_STARTED(pxTCB) (pxTCB)->ucJobStarted = (uint8_t)pdFALSE
+#define taskEDF_RECORD_JOB_START(pxTCB)                        \
+    do                                                         \
+    {                                                          \
+        if ((pxTCB)->ucJobStarted == (uint8_t)pdFALSE)         \
+        {                                                      \
+            (pxTCB)->ucJobStarted = (uint8_t)pdTRUE;           \
+            taskEDF_RECORD_START_JITTER(pxTCB);                \
+            taskEDF_STAMP_JOB_RUN_TIME(pxTCB);                 \
+        }                                                      \
+    } while (0)
+#else
+#define taskEDF_TRACK_JOB_START 0
+#define taskEDF_CLEAR_JOB_STARTED(pxTCB)
+#define taskEDF_RECORD_JOB_START(pxTCB)
+#endif
+
+/* E.C. pdTRUE if the job of pxTCB has an earlier deadline than the job of the
+ * running task. */
+#define taskEDF_PREEMPTS_CURRENT(pxTCB) \
+    ((pxTCB)->xTaskDeadline < pxCurrentTCB->xTaskDeadline)
+
+/* E.C. The key of the job of the idle task in the EDF ready list.  It sorts
+ * after every job with a deadline, so the idle task only runs when no job is
+ * ready, but ahead of the LO jobs dropped in HI mode, whose key is
+ * portMAX_DELAY: they must not run until the processor next idles. */
+#define taskEDF_IDLE_DEADLINE (portMAX_DELAY - (TickType_t)1U)
+
+/* E.C. Processor utilisation is held in 16.16 fixed point.  A task set is
+ * admitted while the utilisations of its tasks add up to no more than
+ * taskEDF_UTILISATION_ONE. */
+#define taskEDF_UTILISATION_ONE ((uint32_t)0x10000UL)
+
+/* E.C. Link pxNewListItem into pxList just before pxPosition, which must be
+ * in pxList or be its end marker.  list.h only inserts by value, walking the
+ * list from its head, or at the end; this lets a sorted batch be merged into
+ * the EDF ready list in one pass. */
+#define taskEDF_LIST_INSERT_BEFORE(pxList, pxPosition, pxNewListItem) \
+    do                                                                \
+    {                                                                 \
+        (pxNewListItem)->pxNext = (pxPosition);                       \
+        (pxNewListItem)->pxPrevious = (pxPosition)->pxPrevious;       \
+        (pxPosition)->pxPrevious->pxNext = (pxNewListItem);           \
+        (pxPosition)->pxPrevious = (pxNewListItem);                   \
+        (pxNewListItem)->pxContainer = (pxList);                      \
+        ((pxList)->uxNumberOfItems)++;                                \
+    } while (0)
+
+/* E.C. The bits of a job history that fall in a window of ucK jobs. */
+#define taskEDF_FIRM_WINDOW_MASK(ucK) \
+    (((ucK) >= taskEDF_FIRM_MAX_WINDOW) ? 0xFFFFFFFFUL : ((1UL << (ucK)) - 1UL))
+
+/* E.C. Called where a job of the running task completes.  A task retired by
+ * xTaskModeChange() is deleted there instead of waiting for its next job. */
+#if (INCLUDE_vTaskDelete == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
+#define taskEDF_RETIRE_IF_REQUESTED()                         \
+    do                                                        \
+    {                                                         \
+        if (pxCurrentTCB->ucRetiring != (uint8_t)pdFALSE)     \
+        {                                                     \
+            vTaskDelete(NULL);                                \
+        }                                                     \
+    } while (0)
+#else
+#define taskEDF_RETIRE_IF_REQUESTED()
+#endif
+
+/* E.C. Note the time a job was made ready by an event (an interrupt or a
+ * sporadic release), so the latency until the task is switched in can be
+ * measured by vTaskSwitchContext(). */
+#if (configGENERATE_RUN_TIME_STATS == 1)
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+#define taskEDF_STAMP_RELEASE(pxTCB)                                   \
+    do                                                                 \
+    {                                                                  \
+        portALT_GET_RUN_TIME_COUNTER_VALUE((pxTCB)->ulReleaseRunTime); \
+        (pxTCB)->ucReleaseLatencyPending = (uint8_t)pdTRUE;            \
+    } while (0)
+#else
+#define taskEDF_STAMP_RELEASE(pxTCB)                                  \
+    do                                                                \
+    {                                                                 \
+        (pxTCB)->ulReleaseRunTime = portGET_RUN_TIME_COUNTER_VALUE(); \
+        (pxTCB)->ucReleaseLatencyPending = (uint8_t)pdTRUE;           \
+    } while (0)
+#endif
+#else
+#define taskEDF_STAMP_RELEASE(pxTCB)
+#endif
+
 #endif
 /*-----------------------------------------------------------*/
 
@@ -259,6 +519,18 @@ PRIVILEGED_DATA static List_t xReadyTasksListEDF;
 #define taskEVENT_LIST_ITEM_VALUE_IN_USE 0x80000000UL
 #endif
 
+/* E.C. pdTRUE if a priority change may write the new priority into the event
+ * list item value of pxTCB.  Under EDF that value orders the waiters of a
+ * queue or semaphore by the deadlines of their jobs (see
+ * vTaskPlaceOnEventList()), so it never holds a priority, and a deadline can
+ * have any bit set, taskEVENT_LIST_ITEM_VALUE_IN_USE included. */
+#if (configUSE_EDF_SCHEDULER == 1)
+#define taskEVENT_LIST_ITEM_VALUE_HOLDS_PRIORITY(pxTCB) pdFALSE
+#else
+#define taskEVENT_LIST_ITEM_VALUE_HOLDS_PRIORITY(pxTCB) \
+    ((listGET_LIST_ITEM_VALUE(&((pxTCB)->xEventListItem)) & taskEVENT_LIST_ITEM_VALUE_IN_USE) == 0UL)
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -281,7 +553,51 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
     /* the period of the task */
 #if (configUSE_EDF_SCHEDULER == 1)
 
-    TickType_t xTaskPeriod; /* stores the period of the task*/
+    TickType_t xTaskPeriod;           /* stores the period of the task (the minimum inter-arrival time of a sporadic task) */
+    TickType_t xTaskReleaseTime;      /* tick at which the current (or first) job of the task is released */
+    TickType_t xTaskRelativeDeadline; /* deadline of each job, relative to its release */
+    TickType_t xTaskDeadline;         /* absolute deadline of the current job */
+    TickType_t xTaskNextPeriod;       /* period from the next release on, see prvApplyTaskTiming() */
+    TickType_t xTaskNextRelativeDeadline; /* relative deadline from the next release on */
+    uint8_t ucSporadicState;          /* taskNOT_SPORADIC for a periodic task */
+    uint8_t ucPendingReleases;        /* releases of a sporadic task not yet served */
+    uint8_t ucRetiring;               /* pdTRUE if a mode change deletes the task when its job completes */
+    TickType_t xTaskWCET;             /* worst case execution time of a job, 0 if not known */
+    uint32_t ulTaskUtilisation;       /* share of the processor admitted for the task, taskEDF_UTILISATION_ONE is all of it */
+    ListItem_t xElasticListItem;      /* links an elastic task into xElasticTaskList */
+    TickType_t xTaskMinPeriod;        /* shortest (nominal) period of an elastic task */
+    TickType_t xTaskMaxPeriod;        /* longest period an elastic task can be stretched to */
+    UBaseType_t uxElasticity;         /* share of a compression an elastic task takes, 0 for none */
+    uint8_t ucElasticSaturated;       /* pdTRUE while an elastic task is stretched to its longest period */
+    uint8_t ucFirmM;                  /* jobs that must meet their deadline in any ucFirmK consecutive ones */
+    uint8_t ucFirmK;                  /* window of the (m,k)-firm constraint, 0 if jobs are never skipped */
+    uint8_t ucSkippedJobs;            /* jobs skipped since the task last completed one */
+    uint8_t ucWaitingForPeriod;       /* pdTRUE while blocked until the release of its next job */
+    uint32_t ulSkipHistory;           /* one bit per job, the latest in bit 0: set if it was skipped */
+    TaskJobStats_t xJobStats;         /* job completion, skip and deadline miss accounting */
+    uint8_t ucCriticality;            /* eTaskCriticalityLO or eTaskCriticalityHI */
+    TickType_t xTaskWCETHI;           /* WCET of a HI task in HI mode, xTaskWCET is its LO mode budget */
+    uint32_t ulTaskUtilisationHI;     /* share of the processor a HI task needs in HI mode */
+    TickType_t xJobExecutionTime;     /* ticks the current job has been running for */
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    uint8_t ucReleaseLatencyPending;                  /* pdTRUE between an event driven release and the next switch in */
+    configRUN_TIME_COUNTER_TYPE ulReleaseRunTime;     /* run time counter when the job was released */
+    configRUN_TIME_COUNTER_TYPE ulLastReleaseLatency; /* release to switch in time of the last event driven job */
+    configRUN_TIME_COUNTER_TYPE ulMaxReleaseLatency;  /* and the largest seen */
+#endif
+
+#if (configJOB_TRACE_LENGTH > 0) && (configGENERATE_RUN_TIME_STATS == 1)
+    configRUN_TIME_COUNTER_TYPE ulJobRunTimeStart; /* ulRunTimeCounter when the current job was first switched in */
+#endif
+
+#if (taskEDF_TRACK_JOB_START == 1)
+    uint8_t ucJobStarted; /* pdTRUE once the current job has been switched in */
+#endif
+
+#if (configUSE_JOB_HISTOGRAMS == 1)
+    TaskHistogram_t xHistograms[eTaskHistogramStart + 1]; /* indexed by eTaskHistogram */
+#endif
 
 #endif
 
@@ -343,6 +659,29 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if (configUSE_EDF_SCHEDULER == 1)
+
+/* E.C. A work item queued by xTaskRunInSlack(). */
+typedef struct xSLACK_WORK
+{
+    TaskSlackFunction_t pxFunction;
+    void *pvParameter;
+    TickType_t xCost; /*< Ticks of slack the item needs to run ahead of the jobs. */
+} SlackWork_t;
+
+/* E.C. The jobs of one task that slack has to be left for, in ticks from the
+ * current tick. */
+typedef struct xSLACK_JOBS
+{
+    TickType_t xRemaining;    /*< WCET left of the ready job, 0 if there is none. */
+    TickType_t xDeadline;     /*< Deadline of the ready job. */
+    TickType_t xNextDeadline; /*< Deadline of the earliest possible next job. */
+    TickType_t xPeriod;
+    TickType_t xWCET;
+} SlackJobs_t;
+
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
 portDONT_DISCARD PRIVILEGED_DATA TCB_t *volatile pxCurrentTCB = NULL;
@@ -351,7 +690,9 @@ portDONT_DISCARD PRIVILEGED_DATA TCB_t *volatile pxCurrentTCB = NULL;
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
+#if (taskUSE_PRIORITY_READY_LISTS == 1)
 PRIVILEGED_DATA static List_t pxReadyTasksLists[configMAX_PRIORITIES]; /*< Prioritised ready tasks. */
+#endif
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                       /*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                       /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t *volatile pxDelayedTaskList;             /*< Points to the delayed task list currently being used. */
@@ -380,7 +721,9 @@ int FreeRTOS_errno = 0;
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = (UBaseType_t)0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = (TickType_t)configINITIAL_TICK_COUNT;
+#if (taskUSE_PRIORITY_READY_LISTS == 1)
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = (TickType_t)0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
@@ -404,6 +747,60 @@ const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
  * accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = (UBaseType_t)pdFALSE;
 
+#if (configUSE_EDF_SCHEDULER == 1)
+
+/* E.C. Sum of the utilisations of all tasks, see xTaskSetWCET(). */
+PRIVILEGED_DATA static uint32_t ulTotalUtilisation = 0UL;
+
+/* E.C. Tasks whose period the kernel may stretch, see xTaskSetElastic(), and
+ * the utilisation their periods are compressed to fit. */
+PRIVILEGED_DATA static List_t xElasticTaskList;
+PRIVILEGED_DATA static ElasticStats_t xElasticStats = {taskEDF_UTILISATION_ONE, 0UL, 0U, 0U, 0U, 0UL};
+
+/* E.C. EDF-VD.  The criticality mode, the utilisations of the HI tasks at
+ * their LO and HI mode WCETs, the largest total utilisation (at LO mode WCETs)
+ * that keeps the task set schedulable in both modes, and the factor the
+ * relative deadlines of HI tasks are scaled by in LO mode. */
+PRIVILEGED_DATA static volatile eTaskCriticality eCriticalityMode = eTaskCriticalityLO;
+PRIVILEGED_DATA static uint32_t ulHIUtilisationLO = 0UL;
+PRIVILEGED_DATA static uint32_t ulHIUtilisationHI = 0UL;
+PRIVILEGED_DATA static uint32_t ulUtilisationLimit = taskEDF_UTILISATION_ONE;
+PRIVILEGED_DATA static uint32_t ulVirtualDeadlineFactor = taskEDF_UTILISATION_ONE;
+PRIVILEGED_DATA static CriticalityStats_t xCriticalityStats = {eTaskCriticalityLO, taskEDF_UTILISATION_ONE, taskEDF_UTILISATION_ONE, 0UL, 0UL, 0UL, 0U};
+
+/* E.C. When the last job of any task completed after its deadline.  A recent
+ * miss is taken as a sign of overload by prvReadyQueueOverloaded(). */
+PRIVILEGED_DATA static TickType_t xLastDeadlineMissTime = (TickType_t)0U;
+PRIVILEGED_DATA static BaseType_t xDeadlineMissed = pdFALSE;
+
+/* E.C. The slack stealing server.  Work items wait in a ring until the idle
+ * task runs them.  xSlackGranted is set once slack has been found for the
+ * running item, or the next one, and xSlackBudget counts down the ticks of the
+ * grant left. */
+PRIVILEGED_DATA static SlackWork_t xSlackQueue[configSLACK_QUEUE_LENGTH];
+PRIVILEGED_DATA static UBaseType_t uxSlackHead = 0U;
+PRIVILEGED_DATA static UBaseType_t uxSlackWaiting = 0U;
+PRIVILEGED_DATA static TickType_t xSlackActiveCost = (TickType_t)0U;
+PRIVILEGED_DATA static BaseType_t xSlackGranted = pdFALSE;
+PRIVILEGED_DATA static TickType_t xSlackBudget = (TickType_t)0U;
+PRIVILEGED_DATA static SlackStats_t xSlackStats = {0U, 0UL, 0UL, 0UL, 0UL, 0UL, 0U};
+
+#if (INCLUDE_vTaskDelete == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
+PRIVILEGED_DATA static ModeChangeStats_t xModeChangeStats = {0U, 0U, 0U, 0U, 0U, 0U};
+#endif
+
+#if (configUSE_EDF_STATIC_TASK_SET == 1)
+
+/* E.C. The timing of the periodic and sporadic tasks in the order they must
+ * be created, and how many of them have been. */
+static const TickType_t xStaticTaskPeriods[edfTASK_SET_COUNT] = edfTASK_SET_PERIODS;
+static const TickType_t xStaticTaskDeadlines[edfTASK_SET_COUNT] = edfTASK_SET_DEADLINES;
+PRIVILEGED_DATA static UBaseType_t uxStaticTasksCreated = 0U;
+
+#endif
+
+#endif
+
 #if (configGENERATE_RUN_TIME_STATS == 1)
 
 /* Do not move these variables to function scope as doing so prevents the
@@ -413,6 +810,66 @@ PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL
 
 #endif
 
+#if (configJOB_TRACE_LENGTH > 0)
+
+/* E.C. The job trace, a ring that overwrites its oldest record when full. */
+PRIVILEGED_DATA static TaskJobRecord_t xJobTrace[configJOB_TRACE_LENGTH];
+PRIVILEGED_DATA static UBaseType_t uxJobTraceHead = 0U;
+PRIVILEGED_DATA static UBaseType_t uxJobTraceWaiting = 0U;
+PRIVILEGED_DATA static uint32_t ulJobTraceOverwrites = 0UL;
+
+#endif
+
+#if (configUSE_SWITCH_PROFILER == 1)
+
+/* E.C. Cycles spent in each phase of a context switch, and the length of the
+ * last vTaskSwitchContext() call for vTaskProfilePortSample() to take off. */
+PRIVILEGED_DATA static TaskSwitchProfile_t xSwitchProfile[taskSWITCH_PHASES];
+PRIVILEGED_DATA static uint32_t ulLastSwitchCycles = 0UL;
+
+#endif
+
+#if (configUSE_TASK_SLAB_ALLOCATOR == 1)
+
+/* E.C. A slab of equally sized blocks for TCBs or stacks.  Blocks that have
+ * never been used are handed out in order, freed blocks are kept on a list
+ * threaded through their first word, so both allocating and freeing are O(1)
+ * and the slab never fragments. */
+typedef struct tskTaskSlab
+{
+    uint8_t *const pucStorage;    /*< First block.  Blocks are contiguous, so this also tells if a block belongs to the slab. */
+    const size_t xBlockSize;      /*< Size of one block in bytes. */
+    const UBaseType_t uxBlocks;   /*< Number of blocks in the slab. */
+    UBaseType_t uxNextUnused;     /*< Index of the first block that has never been allocated. */
+    void *pvFreeList;             /*< Blocks that have been freed. */
+    UBaseType_t uxInUse;          /*< Blocks currently allocated. */
+    UBaseType_t uxMaxInUse;       /*< Most blocks that have been allocated at the same time. */
+    uint32_t ulHeapFallbacks;     /*< Requests for this slab that were served from the heap instead. */
+} TaskSlab_t;
+
+PRIVILEGED_DATA static TCB_t xTCBSlabStorage[configTASK_SLAB_TCBS];
+PRIVILEGED_DATA static StackType_t xSmallStackSlabStorage[configTASK_SLAB_SMALL_STACKS][configTASK_SLAB_SMALL_STACK_DEPTH];
+
+/* E.C. an application without deep stacks can set
+ * configTASK_SLAB_LARGE_STACKS to 0, the slab is then empty and deep stacks
+ * always come from the heap. */
+#if (configTASK_SLAB_LARGE_STACKS > 0)
+PRIVILEGED_DATA static StackType_t xLargeStackSlabStorage[configTASK_SLAB_LARGE_STACKS][configTASK_SLAB_LARGE_STACK_DEPTH];
+#define taskSLAB_LARGE_STACK_STORAGE ((uint8_t *)xLargeStackSlabStorage)
+#else
+#define taskSLAB_LARGE_STACK_STORAGE ((uint8_t *)NULL)
+#endif
+
+/* Indexed by eTaskSlab. */
+PRIVILEGED_DATA static TaskSlab_t xTaskSlabs[] =
+{
+    {(uint8_t *)xTCBSlabStorage, sizeof(TCB_t), configTASK_SLAB_TCBS, 0U, NULL, 0U, 0U, 0UL},
+    {(uint8_t *)xSmallStackSlabStorage, sizeof(xSmallStackSlabStorage[0]), configTASK_SLAB_SMALL_STACKS, 0U, NULL, 0U, 0U, 0UL},
+    {taskSLAB_LARGE_STACK_STORAGE, ((size_t)configTASK_SLAB_LARGE_STACK_DEPTH) * sizeof(StackType_t), configTASK_SLAB_LARGE_STACKS, 0U, NULL, 0U, 0U, 0UL}
+};
+
+#endif /* configUSE_TASK_SLAB_ALLOCATOR */
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -462,6 +919,29 @@ static void prvDeleteTCB(TCB_t *pxTCB) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * E.C. Allocate and free the memory for a dynamically created task.  With
+ * configUSE_TASK_SLAB_ALLOCATOR set to 1 TCBs and stacks come from fixed size
+ * slabs, and only fall back to the heap when a stack is larger than the
+ * largest slab block or the slab is exhausted.  Otherwise they map straight
+ * onto the heap.
+ */
+#if (configUSE_TASK_SLAB_ALLOCATOR == 1)
+
+static TCB_t *prvAllocateTCB(void) PRIVILEGED_FUNCTION;
+static StackType_t *prvAllocateStack(configSTACK_DEPTH_TYPE usStackDepth) PRIVILEGED_FUNCTION;
+static void prvFreeTCB(TCB_t *pxTCB) PRIVILEGED_FUNCTION;
+static void prvFreeStack(StackType_t *pxStack) PRIVILEGED_FUNCTION;
+
+#else
+
+#define prvAllocateTCB() ((TCB_t *)pvPortMalloc(sizeof(TCB_t)))
+#define prvAllocateStack(usStackDepth) ((StackType_t *)pvPortMallocStack((((size_t)(usStackDepth)) * sizeof(StackType_t))))
+#define prvFreeTCB(pxTCB) vPortFree(pxTCB)
+#define prvFreeStack(pxStack) vPortFreeStack(pxStack)
+
+#endif /* configUSE_TASK_SLAB_ALLOCATOR */
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
@@ -477,149 +957,475 @@ static void prvAddCurrentTaskToDelayedList(TickType_t xTicksToWait,
                                            const BaseType_t xCanBlockIndefinitely) PRIVILEGED_FUNCTION;
 
 /*
- * Fills an TaskStatus_t structure with information on each task that is
- * referenced from the pxList list (which may be a ready list, a delayed list,
- * a suspended list, etc.).
- *
- * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
- * NORMAL APPLICATION CODE.
+ * E.C. Place a task that is not the running task in the Blocked state until
+ * xTimeToWake.  Used to hold back the first release of a periodic task that
+ * was created with a release offset.
  */
-#if (configUSE_TRACE_FACILITY == 1)
+#if (configUSE_EDF_SCHEDULER == 1)
 
-static UBaseType_t prvListTasksWithinSingleList(TaskStatus_t *pxTaskStatusArray,
-                                                List_t *pxList,
-                                                eTaskState eState) PRIVILEGED_FUNCTION;
+static void prvAddTaskToDelayedList(TCB_t *pxTCB,
+                                    const TickType_t xTimeToWake) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Searches pxList for a task with name pcNameToQuery - returning a handle to
- * the task if it is found, or NULL if the task is not found.
+ * E.C. Create an EDF task.  Shared by xPeriodicTaskCreateWithOffset() and
+ * xSporadicTaskCreate().  A task created with ucSporadicState set to
+ * taskSPORADIC_WAITING does not run until its first release.
  */
-#if (INCLUDE_xTaskGetHandle == 1)
+#if (configUSE_EDF_SCHEDULER == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+static BaseType_t prvCreateEDFTask(TaskFunction_t pxTaskCode,
+                                   const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                   const configSTACK_DEPTH_TYPE usStackDepth,
+                                   void *const pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t *const pxCreatedTask,
+                                   TickType_t xPeriod,
+                                   TickType_t xRelativeDeadline,
+                                   TickType_t xOffset,
+                                   uint8_t ucSporadicState) PRIVILEGED_FUNCTION;
 
-static TCB_t *prvSearchForNameWithinSingleList(List_t *pxList,
-                                               const char pcNameToQuery[]) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * E.C. Release a job of the sporadic task pxTCB.  If the task is waiting for a
+ * release it is moved to the ready list, or to the delayed list if its minimum
+ * inter-arrival time has not yet elapsed, otherwise the release is counted as
+ * pending.  *pxYieldRequired is set to pdTRUE if the released job should
+ * preempt the running task.  Must be called with interrupts masked.
+ */
+#if (configUSE_EDF_SCHEDULER == 1) && (INCLUDE_vTaskSuspend == 1)
+
+static BaseType_t prvReleaseSporadicJob(TCB_t *const pxTCB,
+                                        BaseType_t *const pxYieldRequired) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * When a task is created, the stack of the task is filled with a known value.
- * This function determines the 'high water mark' of the task stack by
- * determining how much of the stack remains at the original preset value.
+ * E.C. pxTCB, just taken off the suspended list, was waiting for its next
+ * period when it was suspended.  It goes back to the delayed list until the
+ * first release due from now, skipping the releases it missed while it was
+ * suspended, or has a job released now if one is due on this tick.  Returns
+ * pdTRUE if a job was released and the task must be added to the ready list.
+ * Must be called with interrupts masked or the scheduler suspended.
  */
+#if (configUSE_EDF_SCHEDULER == 1) && (INCLUDE_vTaskSuspend == 1)
+
+static BaseType_t prvResumeIntoPeriod(TCB_t *const pxTCB) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
- * When a task is created, the stack of the task is filled with a known value.
- * This function determines the 'high water mark' of the task stack by
- * determining how much of the stack remains at the original preset value.
+ * E.C. The utilisation of a task with the given timing, in the 16.16 fixed
+ * point format of taskEDF_UTILISATION_ONE.  Jobs must complete within the
+ * shorter of the period and the relative deadline, so that is what the WCET
+ * is divided by (the density of the task).
  */
-#if ((configUSE_TRACE_FACILITY == 1) || (INCLUDE_uxTaskGetStackHighWaterMark == 1) || (INCLUDE_uxTaskGetStackHighWaterMark2 == 1))
+#if (configUSE_EDF_SCHEDULER == 1)
 
-static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace(const uint8_t *pucStackByte) PRIVILEGED_FUNCTION;
+static uint32_t prvComputeUtilisation(TickType_t xWCET,
+                                      TickType_t xPeriod,
+                                      TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Return the amount of time, in ticks, that will pass before the kernel will
- * next move a task from the Blocked state to the Running state.
- *
- * This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure portSUPPRESS_TICKS_AND_SLEEP() can be called when user
- * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
- * set to a value other than 1.
+ * E.C. Change either the period (xRelativeDeadline 0) or the relative
+ * deadline (xPeriod 0) of a task, after checking the task set stays
+ * schedulable.  A task whose relative deadline equals its period keeps them
+ * equal when its period is changed.
  */
-#if (configUSE_TICKLESS_IDLE != 0)
+#if (configUSE_EDF_SCHEDULER == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
 
-static TickType_t prvGetExpectedIdleTime(void) PRIVILEGED_FUNCTION;
+static BaseType_t prvSetTaskTiming(TaskHandle_t xTask,
+                                   TickType_t xPeriod,
+                                   TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Set xNextTaskUnblockTime to the time at which the next Blocked state task
- * will exit the Blocked state.
+ * E.C. Give pxTCB a new period and relative deadline from its next release
+ * on.  The job already released keeps the timing it was released with.  Must
+ * be called from a critical section.
  */
-static void prvResetNextTaskUnblockTime(void) PRIVILEGED_FUNCTION;
+#if (configUSE_EDF_SCHEDULER == 1)
 
-#if ((configUSE_TRACE_FACILITY == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0))
+static void prvApplyTaskTiming(TCB_t *const pxTCB,
+                               TickType_t xPeriod,
+                               TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
- * Helper function used to pad task names with spaces when printing out
- * human readable tables of task information.
+ * E.C. The share of the processor admitted for pxTCB with a WCET of xWCET.
+ * An elastic task is admitted with its longest period, as that is what it can
+ * be compressed to.
  */
-static char *prvWriteNameToBuffer(char *pcBuffer,
-                                  const char *pcTaskName) PRIVILEGED_FUNCTION;
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static uint32_t prvAdmittedUtilisation(const TCB_t *const pxTCB,
+                                       TickType_t xWCET) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Called after a Task_t structure has been allocated either statically or
- * dynamically to fill in the structure's members.
+ * E.C. Share the utilisation target between the elastic tasks, in proportion
+ * to their elasticity, and set their periods to match (Buttazzo's elastic
+ * task model).  Runs at most one pass per elastic task plus one, each over
+ * all elastic tasks.  Must be called with the scheduler suspended, never from
+ * an interrupt.
  */
-static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
-                                 const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                 const uint32_t ulStackDepth,
-                                 void *const pvParameters,
-                                 UBaseType_t uxPriority,
-                                 TaskHandle_t *const pxCreatedTask,
-                                 TCB_t *pxNewTCB,
-                                 const MemoryRegion_t *const xRegions) PRIVILEGED_FUNCTION;
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static void prvElasticCompress(void) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
- * Called after a new task has been created and initialised to place the task
- * under the control of the scheduler.
+ * E.C. Called when a job of pxTCB is due at xReleaseTime.  If pxTCB is
+ * (m,k)-firm, the EDF ready queue is overloaded and the job can be skipped
+ * without breaking the constraint, the skip is recorded and pdTRUE returned.
+ * The caller then holds pxTCB back until its next period.  Must be called with
+ * interrupts masked or the scheduler suspended.
  */
-static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB) PRIVILEGED_FUNCTION;
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static BaseType_t prvSkipFirmJob(TCB_t *const pxTCB,
+                                 const TickType_t xReleaseTime) PRIVILEGED_FUNCTION;
 
 /*
- * freertos_tasks_c_additions_init() should only be called if the user definable
- * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
- * called by the function.
+ * E.C. pdTRUE if a job of pxTCB released at xReleaseTime would overload the
+ * EDF ready queue: it, or another ready job, cannot meet its deadline, or a
+ * job of any task missed its deadline within the last period of pxTCB.
  */
-#ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+static BaseType_t prvReadyQueueOverloaded(const TCB_t *const pxTCB,
+                                          const TickType_t xReleaseTime) PRIVILEGED_FUNCTION;
 
-static void freertos_tasks_c_additions_init(void) PRIVILEGED_FUNCTION;
+/*
+ * E.C. The absolute deadline of a job of pxTCB released at its
+ * xTaskReleaseTime.  In LO mode a HI task gets a virtual deadline; in HI mode
+ * a LO task gets none at all (portMAX_DELAY), so the job is dropped until the
+ * system returns to LO mode.  The job of the idle task has the key
+ * taskEDF_IDLE_DEADLINE.
+ */
+static TickType_t prvJobDeadline(const TCB_t *const pxTCB) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. The relative deadline of a job of pxTCB in the current criticality
+ * mode: the virtual deadline for a HI task in LO mode.
+ */
+static TickType_t prvJobRelativeDeadline(const TCB_t *const pxTCB) PRIVILEGED_FUNCTION;
 
+/*
+ * E.C. The largest total utilisation, at LO mode WCETs, that EDF-VD can
+ * schedule with HI tasks of the given LO and HI mode utilisations.
+ */
+static uint32_t prvUtilisationLimit(uint32_t ulHILO,
+                                    uint32_t ulHIHI) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Recompute ulUtilisationLimit and ulVirtualDeadlineFactor after the set
+ * of HI tasks changed.  Must be called with interrupts masked.
+ */
+static void prvUpdateCriticality(void) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Switch to the criticality mode eMode and give every ready job the
+ * deadline that mode calls for.  Called from the tick.  A static task set has
+ * no HI tasks, so it never leaves LO mode.  Takes O(n^2) list steps for n ready
+ * jobs, see the function.
+ */
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+static void prvSetCriticalityMode(eTaskCriticality eMode) PRIVILEGED_FUNCTION;
 #endif
 
-/*-----------------------------------------------------------*/
+/*
+ * E.C. Check the timing of a periodic or sporadic task about to be created
+ * against the next entry of edf_task_set.h.  Returns pdFAIL, and the task is
+ * not created, if they differ.  vTaskStartScheduler() does not start the
+ * kernel unless every entry has been created.  Both checks are made whether
+ * or not configASSERT() is defined.
+ */
+#if (configUSE_EDF_STATIC_TASK_SET == 1)
+static BaseType_t prvCheckStaticTask(TickType_t xPeriod,
+                                     TickType_t xRelativeDeadline) PRIVILEGED_FUNCTION;
+#endif
 
-#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/*
+ * E.C. Account for the completion of the current job of the running task:
+ * whether it met its deadline, and by how much it missed it.
+ */
+static void prvCompleteJob(void) PRIVILEGED_FUNCTION;
 
-TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode,
-                               const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                               const uint32_t ulStackDepth,
-                               void *const pvParameters,
-                               UBaseType_t uxPriority,
-                               StackType_t *const puxStackBuffer,
-                               StaticTask_t *const pxTaskBuffer)
-{
-    TCB_t *pxNewTCB;
-    TaskHandle_t xReturn;
+#if (configUSE_JOB_HISTOGRAMS == 1)
 
-    configASSERT(puxStackBuffer != NULL);
-    configASSERT(pxTaskBuffer != NULL);
+/*
+ * E.C. Count xValue in the log-linear histogram pxHistogram.  Takes a bounded
+ * number of steps, as there are only so many octaves before the last bucket.
+ * Must be called with interrupts masked.
+ */
+static void prvRecordInHistogram(TaskHistogram_t *const pxHistogram,
+                                 TickType_t xValue) PRIVILEGED_FUNCTION;
 
-#if (configASSERT_DEFINED == 1)
-    {
-        /* Sanity check that the size of the structure used to declare a
-         * variable of type StaticTask_t equals the size of the real task
-         * structure. */
-        volatile size_t xSize = sizeof(StaticTask_t);
-        configASSERT(xSize == sizeof(TCB_t));
-        (void)xSize; /* Prevent lint warning when configASSERT() is not used. */
-    }
-#endif /* configASSERT_DEFINED */
+#endif
 
-    if ((pxTaskBuffer != NULL) && (puxStackBuffer != NULL))
-    {
-        /* The memory used for the task's TCB and stack are passed into this
-         * function - use them. */
-        pxNewTCB = (TCB_t *)pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
-        pxNewTCB->pxStack = (StackType_t *)puxStackBuffer;
+#if (configJOB_TRACE_LENGTH > 0)
 
-#if (tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
-        {
+/*
+ * E.C. Add the job of pxTCB that has just completed, xResponseTime ticks after
+ * its release, to the job trace.  Must be called with the scheduler suspended
+ * or interrupts masked.
+ */
+static void prvTraceCompletedJob(TCB_t *const pxTCB,
+                                 TickType_t xResponseTime) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if (configUSE_SWITCH_PROFILER == 1)
+
+/*
+ * E.C. Count a sample of ulCycles in the profile of phase ePhase.  Must be
+ * called with interrupts masked.
+ */
+static void prvRecordSwitchCycles(eTaskSwitchPhase ePhase,
+                                  uint32_t ulCycles) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Cycles from ulStart to ulEnd, allowing for the counter being reset
+ * every configPROFILER_COUNTER_PERIOD counts in between.
+ */
+static uint32_t prvProfileElapsed(uint32_t ulStart,
+                                  uint32_t ulEnd) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * E.C. The slack of the EDF schedule at the current tick: the most ticks of
+ * work that can run ahead of every job without a job missing its deadline.
+ * Takes O(configSLACK_MAX_CHECKPOINTS * n) steps for n tasks.  Must be called
+ * with the scheduler suspended or from the tick.
+ */
+static TickType_t prvComputeSlack(void) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Called from the tick with the idle task, just re-released, as
+ * pxIdleTCB.  Charges the slack granted to background work, grants more if
+ * work is waiting, and moves the idle task ahead of every job while it holds
+ * a grant.  Returns pdTRUE if the idle task moved in the ready list.
+ */
+static BaseType_t prvSlackServerTick(TCB_t *const pxIdleTCB) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Called by the idle task to run the next item queued with
+ * xTaskRunInSlack(), if it may run now.
+ */
+static void prvRunSlackWork(void) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Move the tasks readied while the scheduler was suspended into the EDF
+ * ready list: sort them by deadline and merge them in with one pass over the
+ * ready list.  Interrupts are only masked while the tasks are taken off
+ * xPendingReadyList and their state lists.  Must be called by the task that is
+ * about to resume the scheduler, before it does.  Returns pdTRUE if one of the
+ * tasks has an earlier deadline than the running task.
+ */
+static BaseType_t prvMergePendingReady(void) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Walk every task that has not been deleted: the ready, delayed and
+ * suspended tasks.  Returns the task after *ppxItem, or NULL once all of them
+ * have been walked.  Start with *puxList set to 0 and *ppxItem to NULL.  Must
+ * be called with the scheduler suspended or interrupts masked.
+ */
+static const TCB_t *prvNextEDFTask(UBaseType_t *const puxList,
+                                   const ListItem_t **const ppxItem) PRIVILEGED_FUNCTION;
+
+/*
+ * E.C. Fill *pxJobs with the jobs of pxTCB the slack has to leave room for.
+ * Returns pdFALSE if there are none to account for: pxTCB is the idle task or
+ * has no WCET set.
+ */
+static BaseType_t prvSlackJobs(const TCB_t *const pxTCB,
+                               const TickType_t xNow,
+                               SlackJobs_t *const pxJobs) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * E.C. Returns pdTRUE if the current job of pxTCB has not completed yet.  A
+ * job is complete while its task waits for its next release, either delayed by
+ * vTaskDelayUntil() or suspended, and is not waiting on an event.  Must be
+ * called with the scheduler suspended.
+ */
+#if (configUSE_EDF_SCHEDULER == 1) && (INCLUDE_vTaskDelete == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
+
+static BaseType_t prvTaskHasActiveJob(const TCB_t *const pxTCB) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills an TaskStatus_t structure with information on each task that is
+ * referenced from the pxList list (which may be a ready list, a delayed list,
+ * a suspended list, etc.).
+ *
+ * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
+ * NORMAL APPLICATION CODE.
+ */
+#if (configUSE_TRACE_FACILITY == 1)
+
+static UBaseType_t prvListTasksWithinSingleList(TaskStatus_t *pxTaskStatusArray,
+                                                List_t *pxList,
+                                                eTaskState eState) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Searches pxList for a task with name pcNameToQuery - returning a handle to
+ * the task if it is found, or NULL if the task is not found.
+ */
+#if (INCLUDE_xTaskGetHandle == 1)
+
+static TCB_t *prvSearchForNameWithinSingleList(List_t *pxList,
+                                               const char pcNameToQuery[]) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * When a task is created, the stack of the task is filled with a known value.
+ * This function determines the 'high water mark' of the task stack by
+ * determining how much of the stack remains at the original preset value.
+ */
+
+/*
+ * When a task is created, the stack of the task is filled with a known value.
+ * This function determines the 'high water mark' of the task stack by
+ * determining how much of the stack remains at the original preset value.
+ */
+#if ((configUSE_TRACE_FACILITY == 1) || (INCLUDE_uxTaskGetStackHighWaterMark == 1) || (INCLUDE_uxTaskGetStackHighWaterMark2 == 1))
+
+static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace(const uint8_t *pucStackByte) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Return the amount of time, in ticks, that will pass before the kernel will
+ * next move a task from the Blocked state to the Running state.
+ *
+ * This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure portSUPPRESS_TICKS_AND_SLEEP() can be called when user
+ * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
+ * set to a value other than 1.
+ */
+#if (configUSE_TICKLESS_IDLE != 0)
+
+static TickType_t prvGetExpectedIdleTime(void) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Set xNextTaskUnblockTime to the time at which the next Blocked state task
+ * will exit the Blocked state.
+ */
+static void prvResetNextTaskUnblockTime(void) PRIVILEGED_FUNCTION;
+
+#if ((configUSE_TRACE_FACILITY == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0))
+
+/*
+ * Helper function used to pad task names with spaces when printing out
+ * human readable tables of task information.
+ */
+static char *prvWriteNameToBuffer(char *pcBuffer,
+                                  const char *pcTaskName) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if (configUSE_EDF_SCHEDULER == 1) && (((configUSE_TRACE_FACILITY == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0)) || (configUSE_JOB_HISTOGRAMS == 1) || (configJOB_TRACE_LENGTH > 0))
+
+/*
+ * E.C. Bounded helpers for xTaskStatsIteratorNext(), xTaskHistogramFormat()
+ * and xTaskJobTraceFormat(), which do not use sprintf().  Each copies as much
+ * as fits before pcEnd and returns the new end of the string, which is not
+ * terminated.
+ */
+static char *prvAppendText(char *pcBuffer,
+                           const char *const pcEnd,
+                           const char *pcText) PRIVILEGED_FUNCTION;
+
+static char *prvAppendNumber(char *pcBuffer,
+                             const char *const pcEnd,
+                             configRUN_TIME_COUNTER_TYPE ulValue) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called after a Task_t structure has been allocated either statically or
+ * dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
+                                 const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                 const uint32_t ulStackDepth,
+                                 void *const pvParameters,
+                                 UBaseType_t uxPriority,
+                                 TaskHandle_t *const pxCreatedTask,
+                                 TCB_t *pxNewTCB,
+                                 const MemoryRegion_t *const xRegions) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a new task has been created and initialised to place the task
+ * under the control of the scheduler.
+ */
+static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB) PRIVILEGED_FUNCTION;
+
+/*
+ * freertos_tasks_c_additions_init() should only be called if the user definable
+ * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
+ * called by the function.
+ */
+#ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+
+static void freertos_tasks_c_additions_init(void) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode,
+                               const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                               const uint32_t ulStackDepth,
+                               void *const pvParameters,
+                               UBaseType_t uxPriority,
+                               StackType_t *const puxStackBuffer,
+                               StaticTask_t *const pxTaskBuffer)
+{
+    TCB_t *pxNewTCB;
+    TaskHandle_t xReturn;
+
+    configASSERT(puxStackBuffer != NULL);
+    configASSERT(pxTaskBuffer != NULL);
+
+#if (configASSERT_DEFINED == 1)
+    {
+        /* Sanity check that the size of the structure used to declare a
+         * variable of type StaticTask_t equals the size of the real task
+         * structure. */
+        volatile size_t xSize = sizeof(StaticTask_t);
+        configASSERT(xSize == sizeof(TCB_t));
+        (void)xSize; /* Prevent lint warning when configASSERT() is not used. */
+    }
+#endif /* configASSERT_DEFINED */
+
+    if ((pxTaskBuffer != NULL) && (puxStackBuffer != NULL))
+    {
+        /* The memory used for the task's TCB and stack are passed into this
+         * function - use them. */
+        pxNewTCB = (TCB_t *)pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+        pxNewTCB->pxStack = (StackType_t *)puxStackBuffer;
+
+#if (tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        {
             /* Tasks can be created statically or dynamically, so note this
              * task was created statically in case the task is later deleted. */
             pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
@@ -757,19 +1563,19 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
         /* Allocate space for the TCB.  Where the memory comes from depends on
          * the implementation of the port malloc function and whether or not static
          * allocation is being used. */
-        pxNewTCB = (TCB_t *)pvPortMalloc(sizeof(TCB_t));
+        pxNewTCB = prvAllocateTCB();
 
         if (pxNewTCB != NULL)
         {
             /* Allocate space for the stack used by the task being created.
              * The base of the stack memory stored in the TCB so the task can
              * be deleted later if required. */
-            pxNewTCB->pxStack = (StackType_t *)pvPortMallocStack((((size_t)usStackDepth) * sizeof(StackType_t))); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            pxNewTCB->pxStack = prvAllocateStack(usStackDepth); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             if (pxNewTCB->pxStack == NULL)
             {
                 /* Could not allocate the stack.  Delete the allocated TCB. */
-                vPortFree(pxNewTCB);
+                prvFreeTCB(pxNewTCB);
                 pxNewTCB = NULL;
             }
         }
@@ -779,12 +1585,12 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
         StackType_t *pxStack;
 
         /* Allocate space for the stack used by the task being created. */
-        pxStack = pvPortMallocStack((((size_t)usStackDepth) * sizeof(StackType_t))); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+        pxStack = prvAllocateStack(usStackDepth); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
         if (pxStack != NULL)
         {
             /* Allocate space for the TCB. */
-            pxNewTCB = (TCB_t *)pvPortMalloc(sizeof(TCB_t)); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+            pxNewTCB = prvAllocateTCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
             if (pxNewTCB != NULL)
             {
@@ -795,7 +1601,7 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
             {
                 /* The stack cannot be used as the TCB was not created.  Free
                  * it again. */
-                vPortFreeStack(pxStack);
+                prvFreeStack(pxStack);
             }
         }
         else
@@ -836,10 +1642,68 @@ BaseType_t xPeriodicTaskCreate(TaskFunction_t pxTaskCode,
                                UBaseType_t uxPriority,
                                TaskHandle_t *const pxCreatedTask,
                                TickType_t period)
+{
+    /* E.C. a periodic task without an offset releases its first job now. */
+    return xPeriodicTaskCreateWithOffset(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, (TickType_t)0U);
+}
+
+BaseType_t xPeriodicTaskCreateWithOffset(TaskFunction_t pxTaskCode,
+                                         const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                         const configSTACK_DEPTH_TYPE usStackDepth,
+                                         void *const pvParameters,
+                                         UBaseType_t uxPriority,
+                                         TaskHandle_t *const pxCreatedTask,
+                                         TickType_t period,
+                                         TickType_t offset)
+{
+    /* E.C. the first job must be released within the first period. */
+    configASSERT(offset < period);
+
+    /* E.C. the deadline of a periodic job is the end of its period. */
+    return prvCreateEDFTask(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, period, offset, taskNOT_SPORADIC);
+}
+
+#if (INCLUDE_vTaskSuspend == 1)
+
+BaseType_t xSporadicTaskCreate(TaskFunction_t pxTaskCode,
+                               const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                               const configSTACK_DEPTH_TYPE usStackDepth,
+                               void *const pvParameters,
+                               UBaseType_t uxPriority,
+                               TaskHandle_t *const pxCreatedTask,
+                               TickType_t xMinInterArrivalTime,
+                               TickType_t xRelativeDeadline)
+{
+    configASSERT(xMinInterArrivalTime > (TickType_t)0U);
+    configASSERT(xRelativeDeadline > (TickType_t)0U);
+
+    return prvCreateEDFTask(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, xMinInterArrivalTime, xRelativeDeadline, (TickType_t)0U, taskSPORADIC_WAITING);
+}
+
+#endif /* INCLUDE_vTaskSuspend */
+
+static BaseType_t prvCreateEDFTask(TaskFunction_t pxTaskCode,
+                                   const char *const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                   const configSTACK_DEPTH_TYPE usStackDepth,
+                                   void *const pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t *const pxCreatedTask,
+                                   TickType_t xPeriod,
+                                   TickType_t xRelativeDeadline,
+                                   TickType_t xOffset,
+                                   uint8_t ucSporadicState)
 {
     TCB_t *pxNewTCB;
     BaseType_t xReturn;
 
+#if (configUSE_EDF_STATIC_TASK_SET == 1)
+    /* E.C. the idle task is not in edf_task_set.h. */
+    if ((pxTaskCode != prvIdleTask) && (prvCheckStaticTask(xPeriod, xRelativeDeadline) == pdFAIL))
+    {
+        return pdFAIL;
+    }
+#endif
+
 /* If the stack grows down then allocate the stack then the TCB so the stack
  * does not grow into the TCB.  Likewise if the stack grows up then allocate
  * the TCB then the stack. */
@@ -848,7 +1712,7 @@ BaseType_t xPeriodicTaskCreate(TaskFunction_t pxTaskCode,
         /* Allocate space for the TCB.  Where the memory comes from depends on
          * the implementation of the port malloc function and whether or not static
          * allocation is being used. */
-        pxNewTCB = (TCB_t *)pvPortMalloc(sizeof(TCB_t));
+        pxNewTCB = prvAllocateTCB();
 
         if (pxNewTCB != NULL)
         {
@@ -857,12 +1721,12 @@ BaseType_t xPeriodicTaskCreate(TaskFunction_t pxTaskCode,
             /* Allocate space for the stack used by the task being created.
              * The base of the stack memory stored in the TCB so the task can
              * be deleted later if required. */
-            pxNewTCB->pxStack = (StackType_t *)pvPortMallocStack((((size_t)usStackDepth) * sizeof(StackType_t))); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            pxNewTCB->pxStack = prvAllocateStack(usStackDepth); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             if (pxNewTCB->pxStack == NULL)
             {
                 /* Could not allocate the stack.  Delete the allocated TCB. */
-                vPortFree(pxNewTCB);
+                prvFreeTCB(pxNewTCB);
                 pxNewTCB = NULL;
             }
         }
@@ -872,12 +1736,12 @@ BaseType_t xPeriodicTaskCreate(TaskFunction_t pxTaskCode,
         StackType_t *pxStack;
 
         /* Allocate space for the stack used by the task being created. */
-        pxStack = pvPortMallocStack((((size_t)usStackDepth) * sizeof(StackType_t))); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+        pxStack = prvAllocateStack(usStackDepth); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
         if (pxStack != NULL)
         {
             /* Allocate space for the TCB. */
-            pxNewTCB = (TCB_t *)pvPortMalloc(sizeof(TCB_t)); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+            pxNewTCB = prvAllocateTCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
             if (pxNewTCB != NULL)
             {
@@ -890,15 +1754,13 @@ BaseType_t xPeriodicTaskCreate(TaskFunction_t pxTaskCode,
             {
                 /* The stack cannot be used as the TCB was not created.  Free
                  * it again. */
-                vPortFreeStack(pxStack);
+                prvFreeStack(pxStack);
             }
         }
         else
         {
             pxNewTCB = NULL;
         }
-        /* E.C. Initialise the Period	*/
-        pxNewTCB->xTaskPeriod = period;
     }
 #endif /* portSTACK_GROWTH */
 
@@ -913,24 +1775,2301 @@ BaseType_t xPeriodicTaskCreate(TaskFunction_t pxTaskCode,
 #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
         prvInitialiseNewTask(pxTaskCode, pcName, (uint32_t)usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL);
-        
-				/*E.C. : insert the period value in the generic list iteam before to add the	task in RL: */
-        listSET_LIST_ITEM_VALUE(&((pxNewTCB)->xStateListItem), (pxNewTCB)->xTaskPeriod + xTickCount);
-        
-				prvAddNewTaskToReadyList(pxNewTCB);
+
+        /* E.C. Initialise the Period, the relative deadline and the release
+         * time of the first job.  prvAddNewTaskToReadyList() holds the task in
+         * the Blocked state until that release time if an offset was given. */
+        pxNewTCB->xTaskPeriod = xPeriod;
+        pxNewTCB->xTaskRelativeDeadline = xRelativeDeadline;
+        pxNewTCB->xTaskNextPeriod = xPeriod;
+        pxNewTCB->xTaskNextRelativeDeadline = xRelativeDeadline;
+        pxNewTCB->ucSporadicState = ucSporadicState;
+
+#if (configUSE_EDF_STATIC_TASK_SET == 1)
+        if (pxTaskCode != prvIdleTask)
+        {
+            uxStaticTasksCreated++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+#endif
+
+        if (ucSporadicState == taskSPORADIC_WAITING)
+        {
+            /* E.C. no job has been released yet.  Pretend the previous one was
+             * a full minimum inter-arrival time ago so the first release is
+             * never deferred. */
+            pxNewTCB->xTaskReleaseTime = xTickCount - xPeriod;
+        }
+        else
+        {
+            prvReleaseJob(pxNewTCB, xTickCount + xOffset);
+        }
+
+        prvAddNewTaskToReadyList(pxNewTCB);
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+
+    return xReturn;
+}
+
+#endif /* E.C.	EDF Periodic Task */
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_STATIC_TASK_SET == 1)
+
+static BaseType_t prvCheckStaticTask(TickType_t xPeriod,
+                                     TickType_t xRelativeDeadline)
+{
+    BaseType_t xReturn = pdFAIL;
+
+    /* E.C. a task that is not in the table, or has other timing, would void
+     * the analysis the table was built from. */
+    if ((uxStaticTasksCreated < (UBaseType_t)edfTASK_SET_COUNT) &&
+        (xPeriod != (TickType_t)0U) &&
+        (xPeriod == xStaticTaskPeriods[uxStaticTasksCreated]) &&
+        (xRelativeDeadline == xStaticTaskDeadlines[uxStaticTasksCreated]) &&
+        (((TickType_t)edfTASK_SET_HYPERPERIOD % xPeriod) == (TickType_t)0U))
+    {
         xReturn = pdPASS;
     }
     else
     {
-        xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    configASSERT(xReturn == pdPASS);
+
+    return xReturn;
+}
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static TickType_t prvGreatestCommonDivisor(TickType_t xA,
+                                           TickType_t xB)
+{
+    TickType_t xRemainder;
+
+    while (xB != (TickType_t)0U)
+    {
+        xRemainder = xA % xB;
+        xA = xB;
+        xB = xRemainder;
+    }
+
+    return xA;
+}
+
+BaseType_t xTaskComputeReleaseOffsets(const TickType_t *const pxPeriods,
+                                      TickType_t *const pxOffsets,
+                                      const UBaseType_t uxNumberOfTasks,
+                                      uint8_t *const pucReleaseCount,
+                                      const TickType_t xReleaseCountLength)
+{
+    TickType_t xHyperperiod = (TickType_t)1U;
+    TickType_t xPeriod, xOffset, xBestOffset, xTick;
+    UBaseType_t uxTask, uxPlaced, uxNext;
+    uint8_t ucPeak, ucBestPeak;
+
+    configASSERT(pxPeriods);
+    configASSERT(pxOffsets);
+    configASSERT(pucReleaseCount);
+
+    /* Releases repeat every hyperperiod, so the number of simultaneous
+     * releases only has to be counted over one hyperperiod. */
+    for (uxTask = 0; uxTask < uxNumberOfTasks; uxTask++)
+    {
+        configASSERT(pxPeriods[uxTask] > (TickType_t)0U);
+        pxOffsets[uxTask] = portMAX_DELAY;
+
+        xPeriod = pxPeriods[uxTask] / prvGreatestCommonDivisor(xHyperperiod, pxPeriods[uxTask]);
+
+        if (xHyperperiod > (xReleaseCountLength / xPeriod))
+        {
+            /* The hyperperiod does not fit in the buffer supplied by the
+             * caller, release every task at its creation time instead. */
+            for (uxTask = 0; uxTask < uxNumberOfTasks; uxTask++)
+            {
+                pxOffsets[uxTask] = (TickType_t)0U;
+            }
+
+            return pdFAIL;
+        }
+
+        xHyperperiod *= xPeriod;
+    }
+
+    (void)memset(pucReleaseCount, 0x00, (size_t)xHyperperiod);
+
+    /* Greedy placement, shortest period first as those tasks have the
+     * fewest offsets to choose from and release most often.  Each task gets
+     * the offset that keeps the peak number of releases sharing a tick as
+     * low as possible, the earliest such offset on a tie. */
+    for (uxPlaced = 0; uxPlaced < uxNumberOfTasks; uxPlaced++)
+    {
+        uxNext = uxNumberOfTasks;
+
+        for (uxTask = 0; uxTask < uxNumberOfTasks; uxTask++)
+        {
+            if ((pxOffsets[uxTask] == portMAX_DELAY) &&
+                ((uxNext == uxNumberOfTasks) || (pxPeriods[uxTask] < pxPeriods[uxNext])))
+            {
+                uxNext = uxTask;
+            }
+        }
+
+        xPeriod = pxPeriods[uxNext];
+        xBestOffset = (TickType_t)0U;
+        ucBestPeak = (uint8_t)0xffU;
+
+        for (xOffset = (TickType_t)0U; xOffset < xPeriod; xOffset++)
+        {
+            ucPeak = (uint8_t)0U;
+
+            for (xTick = xOffset; xTick < xHyperperiod; xTick += xPeriod)
+            {
+                if (pucReleaseCount[xTick] > ucPeak)
+                {
+                    ucPeak = pucReleaseCount[xTick];
+                }
+            }
+
+            if (ucPeak < ucBestPeak)
+            {
+                ucBestPeak = ucPeak;
+                xBestOffset = xOffset;
+            }
+        }
+
+        for (xTick = xBestOffset; xTick < xHyperperiod; xTick += xPeriod)
+        {
+            if (pucReleaseCount[xTick] < (uint8_t)0xffU)
+            {
+                pucReleaseCount[xTick]++;
+            }
+        }
+
+        pxOffsets[uxNext] = xBestOffset;
+    }
+
+    return pdPASS;
+}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static uint32_t prvComputeUtilisation(TickType_t xWCET,
+                                      TickType_t xPeriod,
+                                      TickType_t xRelativeDeadline)
+{
+    TickType_t xWindow = xPeriod;
+    uint32_t ulReturn;
+
+    if ((xRelativeDeadline != (TickType_t)0U) && (xRelativeDeadline < xWindow))
+    {
+        xWindow = xRelativeDeadline;
+    }
+
+    if (xWCET == (TickType_t)0U)
+    {
+        ulReturn = 0UL;
+    }
+    else if ((xWindow == (TickType_t)0U) || (xWCET > xWindow))
+    {
+        /* A job that cannot complete in its window can never be admitted. */
+        ulReturn = taskEDF_UTILISATION_ONE + 1UL;
+    }
+    else
+    {
+        ulReturn = (uint32_t)((((uint64_t)xWCET) << 16) / (uint64_t)xWindow);
+    }
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskSetWCET(TaskHandle_t xTask,
+                        TickType_t xWCET)
+{
+    TCB_t *pxTCB;
+    uint32_t ulUtilisation;
+    BaseType_t xReturn;
+
+    vTaskSuspendAll();
+    {
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle(xTask);
+            ulUtilisation = prvAdmittedUtilisation(pxTCB, xWCET);
+
+            /* E.C. the two WCETs of a HI task are set together, by
+             * xTaskSetCriticality(). */
+            if ((pxTCB->ucCriticality == (uint8_t)eTaskCriticalityLO) &&
+                (ulUtilisation <= taskEDF_UTILISATION_ONE) &&
+                ((ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisation <= ulUtilisationLimit))
+            {
+                ulTotalUtilisation = (ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisation;
+                pxTCB->xTaskWCET = xWCET;
+                pxTCB->ulTaskUtilisation = ulUtilisation;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* E.C. make room for the new WCET by compressing the elastic
+         * tasks, or give them back what it freed. */
+        if (xReturn == pdPASS)
+        {
+            prvElasticCompress();
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTaskGetTotalUtilisation(void)
+{
+    return ulTotalUtilisation;
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+
+static BaseType_t prvSetTaskTiming(TaskHandle_t xTask,
+                                   TickType_t xPeriod,
+                                   TickType_t xRelativeDeadline)
+{
+    TCB_t *pxTCB;
+    uint32_t ulUtilisation;
+    BaseType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        pxTCB = prvGetTCBFromHandle(xTask);
+
+        /* E.C. a task with an implicit deadline keeps it equal to its
+         * period. */
+        if (xPeriod == (TickType_t)0U)
+        {
+            xPeriod = pxTCB->xTaskNextPeriod;
+        }
+        else if (pxTCB->xTaskNextRelativeDeadline == pxTCB->xTaskNextPeriod)
+        {
+            xRelativeDeadline = xPeriod;
+        }
+        else
+        {
+            xRelativeDeadline = pxTCB->xTaskNextRelativeDeadline;
+        }
+
+        ulUtilisation = prvComputeUtilisation(pxTCB->xTaskWCET, xPeriod, xRelativeDeadline);
+
+        /* E.C. the period of an elastic task belongs to prvElasticCompress().
+         * The timing of a HI task is fixed once its WCETs are admitted. */
+        if ((listLIST_ITEM_CONTAINER(&(pxTCB->xElasticListItem)) == NULL) &&
+            (pxTCB->ucCriticality == (uint8_t)eTaskCriticalityLO) &&
+            (ulUtilisation <= taskEDF_UTILISATION_ONE) &&
+            ((ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisation <= ulUtilisationLimit))
+        {
+            ulTotalUtilisation = (ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisation;
+            pxTCB->ulTaskUtilisation = ulUtilisation;
+            prvApplyTaskTiming(pxTCB, xPeriod, xRelativeDeadline);
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskSetPeriod(TaskHandle_t xTask,
+                          TickType_t xPeriod)
+{
+    configASSERT(xPeriod > (TickType_t)0U);
+
+    return prvSetTaskTiming(xTask, xPeriod, (TickType_t)0U);
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskSetRelativeDeadline(TaskHandle_t xTask,
+                                    TickType_t xRelativeDeadline)
+{
+    configASSERT(xRelativeDeadline > (TickType_t)0U);
+
+    return prvSetTaskTiming(xTask, (TickType_t)0U, xRelativeDeadline);
+}
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetPeriod(TaskHandle_t xTask)
+{
+    TickType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvGetTCBFromHandle(xTask)->xTaskNextPeriod;
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetRelativeDeadline(TaskHandle_t xTask)
+{
+    TickType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvGetTCBFromHandle(xTask)->xTaskNextRelativeDeadline;
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvApplyTaskTiming(TCB_t *const pxTCB,
+                               TickType_t xPeriod,
+                               TickType_t xRelativeDeadline)
+{
+    /* E.C. prvReleaseJob() takes the new timing, so the deadline of the
+     * current job and the time of the next release do not move, and no list
+     * the task is on needs reordering. */
+    pxTCB->xTaskNextPeriod = xPeriod;
+    pxTCB->xTaskNextRelativeDeadline = xRelativeDeadline;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvAdmittedUtilisation(const TCB_t *const pxTCB,
+                                       TickType_t xWCET)
+{
+    uint32_t ulReturn;
+
+    if (listLIST_ITEM_CONTAINER(&(pxTCB->xElasticListItem)) == NULL)
+    {
+        ulReturn = prvComputeUtilisation(xWCET, pxTCB->xTaskNextPeriod, pxTCB->xTaskNextRelativeDeadline);
+    }
+    else if (pxTCB->uxElasticity == (UBaseType_t)0U)
+    {
+        /* A task with no elasticity always runs at its shortest period. */
+        ulReturn = prvComputeUtilisation(xWCET, pxTCB->xTaskMinPeriod, pxTCB->xTaskMinPeriod);
+    }
+    else
+    {
+        ulReturn = prvComputeUtilisation(xWCET, pxTCB->xTaskMaxPeriod, pxTCB->xTaskMaxPeriod);
+    }
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvElasticCompress(void)
+{
+    const ListItem_t *const pxEnd = listGET_END_MARKER(&xElasticTaskList);
+    const ListItem_t *pxItem;
+    TCB_t *pxTCB;
+    uint32_t ulFixed = ulTotalUtilisation, ulCapacity, ulSaturated, ulNominal, ulExcess = 0UL, ulShare, ulUtilisation, ulActual = 0UL;
+    UBaseType_t uxElasticity, uxPasses = (UBaseType_t)0U, uxSaturatedTasks = (UBaseType_t)0U;
+    TickType_t xPeriod;
+    BaseType_t xNewlySaturated;
+
+    /* E.C. elastic tasks are admitted at their minimum utilisation, which is
+     * also the utilisation they have once saturated.  Whatever the target
+     * leaves over the other tasks is shared between them. */
+    for (pxItem = listGET_HEAD_ENTRY(&xElasticTaskList); pxItem != pxEnd; pxItem = listGET_NEXT(pxItem))
+    {
+        pxTCB = (TCB_t *)listGET_LIST_ITEM_OWNER(pxItem);
+        ulFixed -= pxTCB->ulTaskUtilisation;
+        pxTCB->ucElasticSaturated = (uint8_t)((pxTCB->uxElasticity == (UBaseType_t)0U) ? pdTRUE : pdFALSE);
+    }
+
+    /* E.C. never beyond what EDF-VD can schedule with the HI tasks. */
+    ulCapacity = (xElasticStats.ulTargetUtilisation < ulUtilisationLimit) ? xElasticStats.ulTargetUtilisation : ulUtilisationLimit;
+    ulCapacity = (ulCapacity > ulFixed) ? (ulCapacity - ulFixed) : 0UL;
+
+    /* Every pass but the last saturates at least one more task, which then
+     * stays at its minimum utilisation while the rest are compressed
+     * further. */
+    do
+    {
+        uxPasses++;
+        ulSaturated = 0UL;
+        ulNominal = 0UL;
+        uxElasticity = (UBaseType_t)0U;
+
+        for (pxItem = listGET_HEAD_ENTRY(&xElasticTaskList); pxItem != pxEnd; pxItem = listGET_NEXT(pxItem))
+        {
+            pxTCB = (TCB_t *)listGET_LIST_ITEM_OWNER(pxItem);
+
+            if (pxTCB->ucElasticSaturated != (uint8_t)pdFALSE)
+            {
+                ulSaturated += pxTCB->ulTaskUtilisation;
+            }
+            else
+            {
+                ulNominal += prvComputeUtilisation(pxTCB->xTaskWCET, pxTCB->xTaskMinPeriod, pxTCB->xTaskMinPeriod);
+                uxElasticity += pxTCB->uxElasticity;
+            }
+        }
+
+        xNewlySaturated = pdFALSE;
+        ulExcess = ((ulSaturated + ulNominal) > ulCapacity) ? ((ulSaturated + ulNominal) - ulCapacity) : 0UL;
+
+        if ((ulExcess != 0UL) && (uxElasticity != (UBaseType_t)0U))
+        {
+            for (pxItem = listGET_HEAD_ENTRY(&xElasticTaskList); pxItem != pxEnd; pxItem = listGET_NEXT(pxItem))
+            {
+                pxTCB = (TCB_t *)listGET_LIST_ITEM_OWNER(pxItem);
+
+                if (pxTCB->ucElasticSaturated == (uint8_t)pdFALSE)
+                {
+                    ulShare = (uint32_t)(((uint64_t)ulExcess * (uint64_t)pxTCB->uxElasticity) / (uint64_t)uxElasticity);
+
+                    if (prvComputeUtilisation(pxTCB->xTaskWCET, pxTCB->xTaskMinPeriod, pxTCB->xTaskMinPeriod) <= (pxTCB->ulTaskUtilisation + ulShare))
+                    {
+                        pxTCB->ucElasticSaturated = (uint8_t)pdTRUE;
+                        xNewlySaturated = pdTRUE;
+                    }
+                }
+            }
+        }
+    } while (xNewlySaturated != pdFALSE);
+
+    for (pxItem = listGET_HEAD_ENTRY(&xElasticTaskList); pxItem != pxEnd; pxItem = listGET_NEXT(pxItem))
+    {
+        pxTCB = (TCB_t *)listGET_LIST_ITEM_OWNER(pxItem);
+
+        if (pxTCB->ucElasticSaturated != (uint8_t)pdFALSE)
+        {
+            ulUtilisation = pxTCB->ulTaskUtilisation;
+            uxSaturatedTasks++;
+        }
+        else
+        {
+            ulUtilisation = prvComputeUtilisation(pxTCB->xTaskWCET, pxTCB->xTaskMinPeriod, pxTCB->xTaskMinPeriod);
+
+            if (ulExcess != 0UL)
+            {
+                ulUtilisation -= (uint32_t)(((uint64_t)ulExcess * (uint64_t)pxTCB->uxElasticity) / (uint64_t)uxElasticity);
+            }
+        }
+
+        /* The shortest period that keeps the task within its utilisation,
+         * rounded up to whole ticks. */
+        if ((pxTCB->xTaskWCET == (TickType_t)0U) || (ulUtilisation == 0UL))
+        {
+            xPeriod = (pxTCB->ucElasticSaturated != (uint8_t)pdFALSE) ? pxTCB->xTaskMaxPeriod : pxTCB->xTaskMinPeriod;
+        }
+        else
+        {
+            xPeriod = (TickType_t)(((((uint64_t)pxTCB->xTaskWCET) << 16) + (uint64_t)ulUtilisation - 1U) / (uint64_t)ulUtilisation);
+
+            /* Utilisations are rounded down, so the period one tick shorter
+             * may still be within it. */
+            if ((xPeriod > (TickType_t)1U) &&
+                (prvComputeUtilisation(pxTCB->xTaskWCET, xPeriod - (TickType_t)1U, xPeriod - (TickType_t)1U) <= ulUtilisation))
+            {
+                xPeriod--;
+            }
+        }
+
+        if (xPeriod < pxTCB->xTaskMinPeriod)
+        {
+            xPeriod = pxTCB->xTaskMinPeriod;
+        }
+        else if (xPeriod > pxTCB->xTaskMaxPeriod)
+        {
+            xPeriod = pxTCB->xTaskMaxPeriod;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ulActual += prvComputeUtilisation(pxTCB->xTaskWCET, xPeriod, xPeriod);
+
+        if (xPeriod != pxTCB->xTaskNextPeriod)
+        {
+            taskENTER_CRITICAL();
+            {
+                prvApplyTaskTiming(pxTCB, xPeriod, xPeriod);
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    xElasticStats.ulElasticUtilisation = ulActual;
+    xElasticStats.uxElasticTasks = listCURRENT_LIST_LENGTH(&xElasticTaskList);
+    xElasticStats.uxSaturatedTasks = uxSaturatedTasks;
+    xElasticStats.uxLastPasses = uxPasses;
+    xElasticStats.ulCompressions++;
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+
+BaseType_t xTaskSetElastic(TaskHandle_t xTask,
+                           TickType_t xMinPeriod,
+                           TickType_t xMaxPeriod,
+                           UBaseType_t uxElasticity)
+{
+    TCB_t *pxTCB;
+    uint32_t ulUtilisation;
+    BaseType_t xReturn;
+
+    configASSERT(xMinPeriod > (TickType_t)0U);
+    configASSERT(xMinPeriod <= xMaxPeriod);
+
+    vTaskSuspendAll();
+    {
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle(xTask);
+
+            ulUtilisation = prvComputeUtilisation(pxTCB->xTaskWCET, (uxElasticity == (UBaseType_t)0U) ? xMinPeriod : xMaxPeriod,
+                                                  (uxElasticity == (UBaseType_t)0U) ? xMinPeriod : xMaxPeriod);
+
+            if ((pxTCB->ucCriticality == (uint8_t)eTaskCriticalityLO) &&
+                (ulUtilisation <= taskEDF_UTILISATION_ONE) &&
+                ((ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisation <= ulUtilisationLimit))
+            {
+                ulTotalUtilisation = (ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisation;
+                pxTCB->ulTaskUtilisation = ulUtilisation;
+                pxTCB->xTaskMinPeriod = xMinPeriod;
+                pxTCB->xTaskMaxPeriod = xMaxPeriod;
+                pxTCB->uxElasticity = uxElasticity;
+
+                if (listLIST_ITEM_CONTAINER(&(pxTCB->xElasticListItem)) == NULL)
+                {
+                    vListInsertEnd(&xElasticTaskList, &(pxTCB->xElasticListItem));
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (xReturn == pdPASS)
+        {
+            prvElasticCompress();
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return xReturn;
+}
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+/*-----------------------------------------------------------*/
+
+void vTaskSetElasticTarget(uint32_t ulTargetUtilisation)
+{
+    configASSERT(ulTargetUtilisation <= taskEDF_UTILISATION_ONE);
+
+    vTaskSuspendAll();
+    {
+        xElasticStats.ulTargetUtilisation = ulTargetUtilisation;
+        prvElasticCompress();
+    }
+    (void)xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskElasticUpdate(void)
+{
+    vTaskSuspendAll();
+    {
+        prvElasticCompress();
+    }
+    (void)xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetElasticStats(ElasticStats_t *const pxElasticStats)
+{
+    configASSERT(pxElasticStats);
+
+    vTaskSuspendAll();
+    {
+        *pxElasticStats = xElasticStats;
+    }
+    (void)xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCountJobsInWindow(const TCB_t *const pxTCB,
+                                        uint32_t ulHistory)
+{
+    UBaseType_t uxJobs = 0U;
+
+    ulHistory &= taskEDF_FIRM_WINDOW_MASK(pxTCB->ucFirmK);
+
+    while (ulHistory != 0UL)
+    {
+        ulHistory &= ulHistory - 1UL;
+        uxJobs++;
+    }
+
+    return uxJobs;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadyQueueOverloaded(const TCB_t *const pxTCB,
+                                          const TickType_t xReleaseTime)
+{
+    const ListItem_t *pxItem;
+    const ListItem_t *const pxEnd = listGET_END_MARKER(&xReadyTasksListEDF);
+    const TCB_t *pxReadyTCB;
+    const TickType_t xConstTickCount = xTickCount;
+    const TickType_t xElapsed = xConstTickCount - xReleaseTime;
+    TickType_t xWindow, xDemand = pxTCB->xTaskWCET;
+    UBaseType_t uxScanned = (UBaseType_t)0U;
+    BaseType_t xReturn = pdFALSE;
+
+    /* E.C. the job being released takes the next timing of pxTCB. */
+    if (xElapsed >= pxTCB->xTaskNextRelativeDeadline)
+    {
+        /* The job would start past its deadline. */
+        xReturn = pdTRUE;
+    }
+    else if ((xDeadlineMissed != pdFALSE) && ((TickType_t)(xConstTickCount - xLastDeadlineMissTime) < pxTCB->xTaskNextPeriod))
+    {
+        /* Jobs that overrun their WCET do not show in the demand below until
+         * they are late, the misses they cause do. */
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xWindow = pxTCB->xTaskNextRelativeDeadline - xElapsed;
+
+        /* E.C. the processor demand until the deadline of the new job.  Walk
+         * the whole ready list rather than rely on its order across a tick
+         * count overflow, but only while it is short: this runs from the tick
+         * interrupt on every firm release.  A ready list longer than
+         * configFIRM_OVERLOAD_SCAN_LIMIT jobs is taken as overload without
+         * looking further.  pxTCB itself may be in it, running the job before
+         * the new one.  The job of the idle task is never late and has no
+         * demand. */
+        for (pxItem = listGET_HEAD_ENTRY(&xReadyTasksListEDF); pxItem != pxEnd; pxItem = listGET_NEXT(pxItem))
+        {
+            pxReadyTCB = listGET_LIST_ITEM_OWNER(pxItem);
+
+            if ((pxReadyTCB == pxTCB) || (pxReadyTCB == xIdleTaskHandle))
+            {
+                continue;
+            }
+
+            if (uxScanned == (UBaseType_t)configFIRM_OVERLOAD_SCAN_LIMIT)
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+
+            uxScanned++;
+
+            if ((TickType_t)(xConstTickCount - pxReadyTCB->xTaskReleaseTime) > (TickType_t)(pxReadyTCB->xTaskDeadline - pxReadyTCB->xTaskReleaseTime))
+            {
+                /* A ready job is already late. */
+                xReturn = pdTRUE;
+                break;
+            }
+
+            if ((TickType_t)(pxReadyTCB->xTaskDeadline - xConstTickCount) <= xWindow)
+            {
+                xDemand += pxReadyTCB->xTaskWCET;
+            }
+        }
+
+        if (xDemand > xWindow)
+        {
+            xReturn = pdTRUE;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSkipFirmJob(TCB_t *const pxTCB,
+                                 const TickType_t xReleaseTime)
+{
+    BaseType_t xReturn = pdFALSE;
+
+    /* At most ucFirmK - ucFirmM of any ucFirmK consecutive jobs are skipped,
+     * whether or not the jobs that ran met their deadlines. */
+    if ((pxTCB->ucFirmK != 0U) &&
+        (prvCountJobsInWindow(pxTCB, (pxTCB->ulSkipHistory << 1) | 1UL) <= (UBaseType_t)(pxTCB->ucFirmK - pxTCB->ucFirmM)) &&
+        (prvReadyQueueOverloaded(pxTCB, xReleaseTime) != pdFALSE))
+    {
+        pxTCB->ulSkipHistory = (pxTCB->ulSkipHistory << 1) | 1UL;
+        pxTCB->xJobStats.ulJobHistory <<= 1;
+        pxTCB->xJobStats.ulJobsSkipped++;
+
+        traceTASK_JOB_SKIPPED(pxTCB);
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCompleteJob(void)
+{
+    TCB_t *const pxTCB = pxCurrentTCB;
+    const TickType_t xResponseTime = xTickCount - pxTCB->xTaskReleaseTime;
+
+    /* E.C. lateness is measured against the real deadline of the job, not
+     * xTaskDeadline, which is the shorter virtual deadline of a HI task in LO
+     * mode.  Missing only the virtual deadline is not a miss, and must not
+     * make prvReadyQueueOverloaded() skip firm jobs. */
+    const TickType_t xRelativeDeadline = pxTCB->xTaskRelativeDeadline;
+
+    pxTCB->xJobStats.ulJobsCompleted++;
+    pxTCB->xJobStats.ulJobHistory <<= 1;
+    pxTCB->ulSkipHistory <<= 1;
+
+#if (configUSE_JOB_HISTOGRAMS == 1)
+    prvRecordInHistogram(&(pxTCB->xHistograms[eTaskHistogramResponse]), xResponseTime);
+#endif
+
+#if (configJOB_TRACE_LENGTH > 0)
+    prvTraceCompletedJob(pxTCB, xResponseTime);
+#endif
+
+    if (xResponseTime > xRelativeDeadline)
+    {
+        pxTCB->xJobStats.ulDeadlineMisses++;
+        pxTCB->xJobStats.xLastLateness = xResponseTime - xRelativeDeadline;
+        xLastDeadlineMissTime = xTickCount;
+        xDeadlineMissed = pdTRUE;
+
+        if (pxTCB->xJobStats.xLastLateness > pxTCB->xJobStats.xMaxLateness)
+        {
+            pxTCB->xJobStats.xMaxLateness = pxTCB->xJobStats.xLastLateness;
+        }
+    }
+    else
+    {
+        pxTCB->xJobStats.ulJobHistory |= 1UL;
+    }
+
+    if ((pxTCB->ucFirmK != 0U) &&
+        (prvCountJobsInWindow(pxTCB, pxTCB->xJobStats.ulJobHistory) < (UBaseType_t)pxTCB->ucFirmM))
+    {
+        pxTCB->xJobStats.ulFirmFailures++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskSetFirmConstraint(TaskHandle_t xTask,
+                                  UBaseType_t uxM,
+                                  UBaseType_t uxK)
+{
+    TCB_t *pxTCB;
+    BaseType_t xReturn = pdFAIL;
+
+    taskENTER_CRITICAL();
+    {
+        pxTCB = prvGetTCBFromHandle(xTask);
+
+        if ((uxM > (UBaseType_t)0U) && (uxM <= uxK) && (uxK <= (UBaseType_t)taskEDF_FIRM_MAX_WINDOW) &&
+            (pxTCB->ucSporadicState == taskNOT_SPORADIC))
+        {
+            /* The jobs before the constraint was set count as on time, so a
+             * skip is possible straight away. */
+            pxTCB->ucFirmM = (uint8_t)uxM;
+            pxTCB->ucFirmK = (uint8_t)((uxM == uxK) ? 0U : uxK);
+            pxTCB->ulSkipHistory = 0UL;
+            pxTCB->xJobStats.ulJobHistory = 0xFFFFFFFFUL;
+            xReturn = pdPASS;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetJobStats(TaskHandle_t xTask,
+                      TaskJobStats_t *const pxJobStats)
+{
+    configASSERT(pxJobStats);
+
+    taskENTER_CRITICAL();
+    {
+        *pxJobStats = prvGetTCBFromHandle(xTask)->xJobStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_JOB_HISTOGRAMS == 1)
+
+static void prvRecordInHistogram(TaskHistogram_t *const pxHistogram,
+                                 TickType_t xValue)
+{
+    const TickType_t xLinearLimit = (TickType_t)2U << configJOB_HISTOGRAM_SUB_BUCKET_BITS;
+    TickType_t xScaled = xValue;
+    UBaseType_t uxOctave = 0U;
+    UBaseType_t uxBucket;
+
+    /* Halve the value until it is below twice the number of sub-buckets.
+     * Each halving moves it up an octave, and what is left selects the
+     * sub-bucket within it.  Stop once the last bucket has been passed. */
+    while ((xScaled >= xLinearLimit) &&
+           ((uxOctave << configJOB_HISTOGRAM_SUB_BUCKET_BITS) < (UBaseType_t)configJOB_HISTOGRAM_BUCKETS))
+    {
+        xScaled >>= 1;
+        uxOctave++;
+    }
+
+    uxBucket = (uxOctave << configJOB_HISTOGRAM_SUB_BUCKET_BITS) + (UBaseType_t)xScaled;
+
+    if (uxBucket >= (UBaseType_t)configJOB_HISTOGRAM_BUCKETS)
+    {
+        uxBucket = (UBaseType_t)configJOB_HISTOGRAM_BUCKETS - (UBaseType_t)1U;
+    }
+
+    pxHistogram->ulBuckets[uxBucket]++;
+    pxHistogram->ulSamples++;
+
+    if (xValue > pxHistogram->xMaxValue)
+    {
+        pxHistogram->xMaxValue = xValue;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetHistogram(TaskHandle_t xTask,
+                       eTaskHistogram eHistogram,
+                       TaskHistogram_t *const pxHistogram)
+{
+    configASSERT(pxHistogram);
+    configASSERT(eHistogram <= eTaskHistogramStart);
+
+    taskENTER_CRITICAL();
+    {
+        *pxHistogram = prvGetTCBFromHandle(xTask)->xHistograms[eHistogram];
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskHistogramBucketLimit(UBaseType_t uxBucket)
+{
+    const UBaseType_t uxSubBuckets = (UBaseType_t)1U << configJOB_HISTOGRAM_SUB_BUCKET_BITS;
+    UBaseType_t uxOctave;
+    TickType_t xReturn;
+
+    if (uxBucket >= ((UBaseType_t)configJOB_HISTOGRAM_BUCKETS - (UBaseType_t)1U))
+    {
+        /* Everything too large for the other buckets. */
+        xReturn = portMAX_DELAY;
+    }
+    else if (uxBucket < (uxSubBuckets << 1))
+    {
+        /* One value per bucket. */
+        xReturn = (TickType_t)uxBucket;
+    }
+    else
+    {
+        /* The inverse of prvRecordInHistogram(): the bucket holds the values
+         * that halve uxOctave times to what is left of uxBucket. */
+        uxOctave = (uxBucket >> configJOB_HISTOGRAM_SUB_BUCKET_BITS) - (UBaseType_t)1U;
+        xReturn = ((TickType_t)(uxBucket - (uxOctave << configJOB_HISTOGRAM_SUB_BUCKET_BITS) + (UBaseType_t)1U) << uxOctave) - (TickType_t)1U;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskHistogramPercentile(const TaskHistogram_t *const pxHistogram,
+                                    uint32_t ulPerMille)
+{
+    uint32_t ulRank;
+    uint32_t ulSeen = 0UL;
+    UBaseType_t uxBucket = 0U;
+    TickType_t xReturn = (TickType_t)0U;
+
+    configASSERT(pxHistogram);
+    configASSERT(ulPerMille <= 1000UL);
+
+    if (pxHistogram->ulSamples != 0UL)
+    {
+        /* The rank of the percentile, rounded up, computed in two parts so
+         * it cannot overflow. */
+        ulRank = ((pxHistogram->ulSamples / 1000UL) * ulPerMille) +
+                 ((((pxHistogram->ulSamples % 1000UL) * ulPerMille) + 999UL) / 1000UL);
+
+        if (ulRank == 0UL)
+        {
+            ulRank = 1UL;
+        }
+
+        for (uxBucket = 0U; uxBucket < (UBaseType_t)configJOB_HISTOGRAM_BUCKETS; uxBucket++)
+        {
+            ulSeen += pxHistogram->ulBuckets[uxBucket];
+
+            if (ulSeen >= ulRank)
+            {
+                break;
+            }
+        }
+
+        xReturn = xTaskHistogramBucketLimit(uxBucket);
+
+        if (xReturn > pxHistogram->xMaxValue)
+        {
+            xReturn = pxHistogram->xMaxValue;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xTaskHistogramFormat(TaskHandle_t xTask,
+                            eTaskHistogram eHistogram,
+                            char *const pcBuffer,
+                            size_t xBufferLength)
+{
+    TaskHistogram_t xHistogram;
+    char cName[configMAX_TASK_NAME_LEN];
+    char *pcWrite = pcBuffer;
+    const char *pcEnd;
+    const TCB_t *pxTCB;
+    size_t x;
+
+    configASSERT(pcBuffer);
+    configASSERT(xBufferLength > (size_t)0U);
+    configASSERT(eHistogram <= eTaskHistogramStart);
+
+    /* Leave room for the terminating null. */
+    pcEnd = &(pcBuffer[xBufferLength - (size_t)1U]);
+
+    taskENTER_CRITICAL();
+    {
+        pxTCB = prvGetTCBFromHandle(xTask);
+        xHistogram = pxTCB->xHistograms[eHistogram];
+
+        for (x = (size_t)0U; x < (size_t)configMAX_TASK_NAME_LEN; x++)
+        {
+            cName[x] = pxTCB->pcTaskName[x];
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    cName[configMAX_TASK_NAME_LEN - 1] = (char)0x00;
+
+    pcWrite = prvAppendText(pcWrite, pcEnd, cName);
+    pcWrite = prvAppendText(pcWrite, pcEnd, (eHistogram == eTaskHistogramResponse) ? "\tR" : "\tS");
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xHistogram.ulSamples);
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xTaskHistogramPercentile(&xHistogram, 500UL));
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xTaskHistogramPercentile(&xHistogram, 990UL));
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xTaskHistogramPercentile(&xHistogram, 999UL));
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xHistogram.xMaxValue);
+    pcWrite = prvAppendText(pcWrite, pcEnd, "\r\n");
+
+    *pcWrite = (char)0x00;
+
+    return (size_t)(pcWrite - pcBuffer);
+}
+
+#endif /* configUSE_JOB_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+#if (configJOB_TRACE_LENGTH > 0)
+
+static void prvTraceCompletedJob(TCB_t *const pxTCB,
+                                 TickType_t xResponseTime)
+{
+    TaskJobRecord_t *pxRecord;
+    UBaseType_t uxIndex;
+    UBaseType_t x;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    configRUN_TIME_COUNTER_TYPE ulRunTime;
+#endif
+
+    if (uxJobTraceWaiting == (UBaseType_t)configJOB_TRACE_LENGTH)
+    {
+        /* Full, drop the oldest record. */
+        uxJobTraceHead = (uxJobTraceHead + 1U) % (UBaseType_t)configJOB_TRACE_LENGTH;
+        uxJobTraceWaiting--;
+        ulJobTraceOverwrites++;
+    }
+
+    uxIndex = (uxJobTraceHead + uxJobTraceWaiting) % (UBaseType_t)configJOB_TRACE_LENGTH;
+    pxRecord = &(xJobTrace[uxIndex]);
+
+    for (x = 0U; x < (UBaseType_t)configMAX_TASK_NAME_LEN; x++)
+    {
+        pxRecord->pcTaskName[x] = pxTCB->pcTaskName[x];
+    }
+
+    pxRecord->xPeriod = pxTCB->xTaskPeriod;
+    pxRecord->xRelativeDeadline = pxTCB->xTaskRelativeDeadline;
+    pxRecord->xReleaseTime = pxTCB->xTaskReleaseTime;
+    pxRecord->xResponseTime = xResponseTime;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    {
+        /* The job is still running, so add the time since it was switched in
+         * to what has already been accounted to it. */
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        portALT_GET_RUN_TIME_COUNTER_VALUE(ulRunTime);
+#else
+        ulRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+#endif
+
+        ulRunTime = pxTCB->ulRunTimeCounter + (ulRunTime - ulTaskSwitchedInTime);
+        pxRecord->ulExecutionTime = (uint32_t)(ulRunTime - pxTCB->ulJobRunTimeStart);
+    }
+#else
+    {
+        pxRecord->ulExecutionTime = (uint32_t)pxTCB->xJobExecutionTime;
+    }
+#endif
+
+    uxJobTraceWaiting++;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskJobTraceRead(TaskJobRecord_t *const pxRecord)
+{
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT(pxRecord);
+
+    taskENTER_CRITICAL();
+    {
+        if (uxJobTraceWaiting != 0U)
+        {
+            *pxRecord = xJobTrace[uxJobTraceHead];
+            uxJobTraceHead = (uxJobTraceHead + 1U) % (UBaseType_t)configJOB_TRACE_LENGTH;
+            uxJobTraceWaiting--;
+            xReturn = pdPASS;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTaskJobTraceGetOverwrites(void)
+{
+    return ulJobTraceOverwrites;
+}
+/*-----------------------------------------------------------*/
+
+size_t xTaskJobTraceFormat(const TaskJobRecord_t *const pxRecord,
+                           char *const pcBuffer,
+                           size_t xBufferLength)
+{
+    char cName[configMAX_TASK_NAME_LEN];
+    char *pcWrite = pcBuffer;
+    const char *pcEnd;
+    size_t x;
+
+    configASSERT(pxRecord);
+    configASSERT(pcBuffer);
+    configASSERT(xBufferLength > (size_t)0U);
+
+    /* Leave room for the terminating null. */
+    pcEnd = &(pcBuffer[xBufferLength - (size_t)1U]);
+
+    for (x = (size_t)0U; x < (size_t)configMAX_TASK_NAME_LEN; x++)
+    {
+        cName[x] = pxRecord->pcTaskName[x];
+    }
+
+    cName[configMAX_TASK_NAME_LEN - 1] = (char)0x00;
+
+    pcWrite = prvAppendText(pcWrite, pcEnd, "J\t");
+    pcWrite = prvAppendText(pcWrite, pcEnd, cName);
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)pxRecord->xPeriod);
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)pxRecord->xRelativeDeadline);
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)pxRecord->xReleaseTime);
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)pxRecord->xResponseTime);
+    pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)pxRecord->ulExecutionTime);
+    pcWrite = prvAppendText(pcWrite, pcEnd, "\r\n");
+
+    *pcWrite = (char)0x00;
+
+    return (size_t)(pcWrite - pcBuffer);
+}
+
+#endif /* configJOB_TRACE_LENGTH */
+/*-----------------------------------------------------------*/
+
+static TickType_t prvJobRelativeDeadline(const TCB_t *const pxTCB)
+{
+    TickType_t xRelativeDeadline = pxTCB->xTaskRelativeDeadline;
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+    if ((pxTCB->ucCriticality == (uint8_t)eTaskCriticalityHI) && (eCriticalityMode == eTaskCriticalityLO))
+    {
+        /* Scale the deadline down, rounding down so the virtual deadline is
+         * never later than x times the real one, which is what the EDF-VD test
+         * assumes.  It is never below the LO mode WCET though. */
+        xRelativeDeadline = (TickType_t)(((uint64_t)xRelativeDeadline * (uint64_t)ulVirtualDeadlineFactor) >> 16);
+
+        if (xRelativeDeadline < pxTCB->xTaskWCET)
+        {
+            xRelativeDeadline = pxTCB->xTaskWCET;
+        }
+    }
+#endif
+
+    return xRelativeDeadline;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvJobDeadline(const TCB_t *const pxTCB)
+{
+    TickType_t xReturn;
+
+    if (pxTCB == xIdleTaskHandle)
+    {
+        xReturn = taskEDF_IDLE_DEADLINE;
+    }
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+    else if ((pxTCB->ucCriticality == (uint8_t)eTaskCriticalityLO) && (eCriticalityMode == eTaskCriticalityHI))
+    {
+        xCriticalityStats.ulDroppedJobs++;
+        xReturn = portMAX_DELAY;
+    }
+#endif
+    else
+    {
+        xReturn = pxTCB->xTaskReleaseTime + prvJobRelativeDeadline(pxTCB);
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvUtilisationLimit(uint32_t ulHILO,
+                                    uint32_t ulHIHI)
+{
+    uint32_t ulReturn;
+
+    if (ulHIHI == 0UL)
+    {
+        /* No HI tasks, plain EDF. */
+        ulReturn = taskEDF_UTILISATION_ONE;
+    }
+    else if (ulHIHI > taskEDF_UTILISATION_ONE)
+    {
+        ulReturn = 0UL;
+    }
+    else
+    {
+        /* E.C. EDF-VD schedules the set if some x makes both
+         * U_HI(LO) / x <= 1 - U_LO(LO) and x * U_LO(LO) + U_HI(HI) <= 1 hold,
+         * which is U_LO(LO) <= (1 - U_HI(HI)) / (1 - U_HI(HI) + U_HI(LO)). */
+        ulReturn = ulHILO + (uint32_t)((((uint64_t)(taskEDF_UTILISATION_ONE - ulHIHI)) << 16) /
+                                       (uint64_t)((taskEDF_UTILISATION_ONE - ulHIHI) + ulHILO));
+
+        if (ulReturn > taskEDF_UTILISATION_ONE)
+        {
+            ulReturn = taskEDF_UTILISATION_ONE;
+        }
+    }
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUpdateCriticality(void)
+{
+    /* E.C. ulUtilisationLimit keeps U_LO(LO) at or below
+     * L = (1 - U_HI(HI)) / (1 - U_HI(HI) + U_HI(LO)).  The factor
+     * x = 1 - U_HI(HI) + U_HI(LO) then meets both U_HI(LO) / x <= 1 - U_LO(LO)
+     * (LO mode) and x * U_LO(LO) + U_HI(HI) <= 1 (HI mode) for any LO load up
+     * to L, so it only has to change with the HI tasks. */
+    ulUtilisationLimit = prvUtilisationLimit(ulHIUtilisationLO, ulHIUtilisationHI);
+
+    if (ulHIUtilisationHI > taskEDF_UTILISATION_ONE)
+    {
+        ulVirtualDeadlineFactor = taskEDF_UTILISATION_ONE;
+    }
+    else
+    {
+        ulVirtualDeadlineFactor = (taskEDF_UTILISATION_ONE - ulHIUtilisationHI) + ulHIUtilisationLO;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+
+static void prvSetCriticalityMode(eTaskCriticality eMode)
+{
+    List_t xJobs;
+    TCB_t *pxTCB;
+
+    eCriticalityMode = eMode;
+    xCriticalityStats.xLastSwitchTime = xTickCount;
+
+    if (eMode == eTaskCriticalityHI)
+    {
+        xCriticalityStats.ulSwitchesToHI++;
+    }
+    else
+    {
+        xCriticalityStats.ulReturnsToLO++;
+    }
+
+    /* Take every ready job out of the ready list, then put it back in the
+     * place of its deadline for the new mode.  HI jobs go back to their real
+     * deadline in HI mode and to their virtual one in LO mode.  LO jobs are
+     * dropped in HI mode, and released again on the return to LO mode.
+     *
+     * This runs in the tick interrupt.  Every job's deadline changes, so every
+     * job is reinserted, each by a vListInsert() walk of up to n items.  Each
+     * task has at most one ready job, so n is bounded by the number of tasks
+     * created, 7 in the demo.  Dropped LO jobs go to the end of the list
+     * without a walk.  A switch happens once per HI job that overruns its LO
+     * mode WCET, and once per return to LO mode. */
+    vListInitialise(&xJobs);
+
+    while (listLIST_IS_EMPTY(&xReadyTasksListEDF) == pdFALSE)
+    {
+        pxTCB = listGET_OWNER_OF_HEAD_ENTRY(&xReadyTasksListEDF); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        (void)uxListRemove(&(pxTCB->xStateListItem));
+        vListInsertEnd(&xJobs, &(pxTCB->xStateListItem));
+    }
+
+    while (listLIST_IS_EMPTY(&xJobs) == pdFALSE)
+    {
+        pxTCB = listGET_OWNER_OF_HEAD_ENTRY(&xJobs); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        (void)uxListRemove(&(pxTCB->xStateListItem));
+
+        if (pxTCB == xIdleTaskHandle)
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else if ((pxTCB->ucCriticality == (uint8_t)eTaskCriticalityLO) && (pxTCB->xTaskDeadline == portMAX_DELAY))
+        {
+            prvReleaseJob(pxTCB, xTickCount);
+        }
+        else
+        {
+            pxTCB->xTaskDeadline = prvJobDeadline(pxTCB);
+        }
+
+        prvAddTaskToReadyList(pxTCB);
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskSetCriticality(TaskHandle_t xTask,
+                               eTaskCriticality eCriticality,
+                               TickType_t xWCETLO,
+                               TickType_t xWCETHI)
+{
+    TCB_t *pxTCB;
+    uint32_t ulUtilisationLO, ulUtilisationHI = 0UL, ulHILO, ulHIHI, ulTotal;
+    BaseType_t xReturn = pdFAIL;
+
+    vTaskSuspendAll();
+    {
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle(xTask);
+
+            ulUtilisationLO = prvComputeUtilisation(xWCETLO, pxTCB->xTaskNextPeriod, pxTCB->xTaskNextRelativeDeadline);
+            ulHILO = ulHIUtilisationLO;
+            ulHIHI = ulHIUtilisationHI - pxTCB->ulTaskUtilisationHI;
+            ulTotal = (ulTotalUtilisation - pxTCB->ulTaskUtilisation) + ulUtilisationLO;
+
+            if (pxTCB->ucCriticality == (uint8_t)eTaskCriticalityHI)
+            {
+                ulHILO -= pxTCB->ulTaskUtilisation;
+            }
+
+            if (eCriticality == eTaskCriticalityHI)
+            {
+                ulUtilisationHI = prvComputeUtilisation(xWCETHI, pxTCB->xTaskNextPeriod, pxTCB->xTaskNextRelativeDeadline);
+                ulHILO += ulUtilisationLO;
+                ulHIHI += ulUtilisationHI;
+            }
+
+            /* E.C. the kernel manages the periods of elastic tasks, so those
+             * stay LO, and a HI task needs a LO mode budget to overrun. */
+            if ((listLIST_ITEM_CONTAINER(&(pxTCB->xElasticListItem)) == NULL) &&
+                (pxTCB != xIdleTaskHandle) &&
+                (ulUtilisationLO <= taskEDF_UTILISATION_ONE) &&
+                (ulUtilisationHI <= taskEDF_UTILISATION_ONE) &&
+                ((eCriticality == eTaskCriticalityLO) || ((xWCETLO != (TickType_t)0U) && (xWCETLO <= xWCETHI))) &&
+                (ulTotal <= prvUtilisationLimit(ulHILO, ulHIHI)))
+            {
+                pxTCB->ucCriticality = (uint8_t)eCriticality;
+                pxTCB->xTaskWCET = xWCETLO;
+                pxTCB->xTaskWCETHI = (eCriticality == eTaskCriticalityHI) ? xWCETHI : xWCETLO;
+                pxTCB->ulTaskUtilisation = ulUtilisationLO;
+                pxTCB->ulTaskUtilisationHI = ulUtilisationHI;
+                ulTotalUtilisation = ulTotal;
+                ulHIUtilisationLO = ulHILO;
+                ulHIUtilisationHI = ulHIHI;
+                prvUpdateCriticality();
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* E.C. the limit moved, the elastic tasks may have to make room or
+         * may get some back. */
+        if (xReturn == pdPASS)
+        {
+            prvElasticCompress();
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return xReturn;
+}
+
+#endif /* configUSE_EDF_STATIC_TASK_SET */
+/*-----------------------------------------------------------*/
+
+eTaskCriticality eTaskGetCriticalityMode(void)
+{
+    return eCriticalityMode;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetCriticalityStats(CriticalityStats_t *const pxCriticalityStats)
+{
+    configASSERT(pxCriticalityStats);
+
+    taskENTER_CRITICAL();
+    {
+        *pxCriticalityStats = xCriticalityStats;
+        pxCriticalityStats->eMode = eCriticalityMode;
+        pxCriticalityStats->ulVirtualDeadlineFactor = ulVirtualDeadlineFactor;
+        pxCriticalityStats->ulUtilisationLimit = ulUtilisationLimit;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static const TCB_t *prvNextEDFTask(UBaseType_t *const puxList,
+                                   const ListItem_t **const ppxItem)
+{
+    const List_t *pxList;
+    const TCB_t *pxReturn = NULL;
+
+    for (;;)
+    {
+        switch (*puxList)
+        {
+            case 0U:
+                pxList = &xReadyTasksListEDF;
+                break;
+
+            case 1U:
+                pxList = pxDelayedTaskList;
+                break;
+
+            case 2U:
+                pxList = pxOverflowDelayedTaskList;
+                break;
+
+#if (INCLUDE_vTaskSuspend == 1)
+            case 3U:
+                pxList = &xSuspendedTaskList;
+                break;
+#endif
+
+            default:
+                pxList = NULL;
+                break;
+        }
+
+        if (pxList == NULL)
+        {
+            break;
+        }
+
+        *ppxItem = (*ppxItem == NULL) ? listGET_HEAD_ENTRY(pxList) : listGET_NEXT(*ppxItem);
+
+        if (*ppxItem != listGET_END_MARKER(pxList))
+        {
+            pxReturn = listGET_LIST_ITEM_OWNER(*ppxItem); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            break;
+        }
+
+        (*puxList)++;
+        *ppxItem = NULL;
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSlackJobs(const TCB_t *const pxTCB,
+                               const TickType_t xNow,
+                               SlackJobs_t *const pxJobs)
+{
+    const List_t *const pxContainer = listLIST_ITEM_CONTAINER(&(pxTCB->xStateListItem));
+    const TickType_t xElapsed = xNow - pxTCB->xTaskReleaseTime;
+    TickType_t xNextRelease;
+    BaseType_t xReturn = pdFALSE;
+
+    if ((pxTCB != xIdleTaskHandle) && (pxTCB->xTaskWCET != (TickType_t)0U))
+    {
+        pxJobs->xRemaining = (TickType_t)0U;
+        pxJobs->xDeadline = (TickType_t)0U;
+        pxJobs->xPeriod = pxTCB->xTaskPeriod;
+        pxJobs->xWCET = pxTCB->xTaskWCET;
+
+        /* Unless it is waiting for its next period, a task may be released
+         * by an event as soon as its period has passed since its last
+         * release. */
+        xNextRelease = (xElapsed >= pxTCB->xTaskPeriod) ? (TickType_t)0U : (TickType_t)(pxTCB->xTaskPeriod - xElapsed);
+
+        if (pxContainer == &xReadyTasksListEDF)
+        {
+            /* A job dropped in HI mode has no deadline to keep. */
+            if (pxTCB->xTaskDeadline != portMAX_DELAY)
+            {
+                /* A job that has run past its WCET still needs some time. */
+                pxJobs->xRemaining = (pxTCB->xJobExecutionTime < pxTCB->xTaskWCET) ? (TickType_t)(pxTCB->xTaskWCET - pxTCB->xJobExecutionTime) : (TickType_t)1U;
+
+                if (xElapsed > (TickType_t)(pxTCB->xTaskDeadline - pxTCB->xTaskReleaseTime))
+                {
+                    /* Already late, it leaves no slack at all. */
+                    pxJobs->xDeadline = (TickType_t)0U;
+                }
+                else
+                {
+                    pxJobs->xDeadline = pxTCB->xTaskDeadline - xNow;
+                }
+            }
+        }
+        else if ((listLIST_ITEM_CONTAINER(&(pxTCB->xEventListItem)) == NULL) &&
+                 ((pxContainer == pxDelayedTaskList) || (pxContainer == pxOverflowDelayedTaskList)))
+        {
+            xNextRelease = listGET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem)) - xNow;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxJobs->xNextDeadline = xNextRelease + prvJobRelativeDeadline(pxTCB);
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvComputeSlack(void)
+{
+    const TickType_t xConstTickCount = xTickCount;
+    const ListItem_t *pxItem = NULL;
+    const ListItem_t *pxOtherItem;
+    const TCB_t *pxTCB;
+    const TCB_t *pxOtherTCB;
+    UBaseType_t uxList = 0U;
+    UBaseType_t uxOtherList;
+    UBaseType_t uxCheckpoints = 0U;
+    SlackJobs_t xJobs;
+    SlackJobs_t xOtherJobs;
+    TickType_t xHorizon = (TickType_t)0U;
+    TickType_t xCheckpoint;
+    TickType_t xDemand;
+    TickType_t xSlack = portMAX_DELAY;
+
+    if (eCriticalityMode == eTaskCriticalityHI)
+    {
+        /* LO jobs are being dropped already. */
+        return (TickType_t)0U;
+    }
+
+    /* Look as far as the next deadline of every task. */
+    for (pxTCB = prvNextEDFTask(&uxList, &pxItem); pxTCB != NULL; pxTCB = prvNextEDFTask(&uxList, &pxItem))
+    {
+        if ((prvSlackJobs(pxTCB, xConstTickCount, &xJobs) != pdFALSE) && (xJobs.xNextDeadline > xHorizon))
+        {
+            xHorizon = xJobs.xNextDeadline;
+        }
+    }
+
+    /* The processor demand only steps up at deadlines, so the slack is at its
+     * smallest at one of them: the time to the deadline less the WCETs of all
+     * the jobs due by then. */
+    uxList = 0U;
+    pxItem = NULL;
+
+    for (pxTCB = prvNextEDFTask(&uxList, &pxItem); (pxTCB != NULL) && (xSlack != (TickType_t)0U); pxTCB = prvNextEDFTask(&uxList, &pxItem))
+    {
+        if (prvSlackJobs(pxTCB, xConstTickCount, &xJobs) == pdFALSE)
+        {
+            continue;
+        }
+
+        xCheckpoint = (xJobs.xRemaining != (TickType_t)0U) ? xJobs.xDeadline : xJobs.xNextDeadline;
+
+        while ((xCheckpoint <= xHorizon) && (xSlack != (TickType_t)0U))
+        {
+            /* This runs from the tick.  Once the checkpoints run out, the
+             * ones not checked could have less slack than any found, so
+             * claim none. */
+            if (uxCheckpoints == (UBaseType_t)configSLACK_MAX_CHECKPOINTS)
+            {
+                xSlack = (TickType_t)0U;
+                break;
+            }
+
+            uxCheckpoints++;
+            xDemand = (TickType_t)0U;
+            uxOtherList = 0U;
+            pxOtherItem = NULL;
+
+            for (pxOtherTCB = prvNextEDFTask(&uxOtherList, &pxOtherItem); pxOtherTCB != NULL; pxOtherTCB = prvNextEDFTask(&uxOtherList, &pxOtherItem))
+            {
+                if (prvSlackJobs(pxOtherTCB, xConstTickCount, &xOtherJobs) == pdFALSE)
+                {
+                    continue;
+                }
+
+                if ((xOtherJobs.xRemaining != (TickType_t)0U) && (xOtherJobs.xDeadline <= xCheckpoint))
+                {
+                    xDemand += xOtherJobs.xRemaining;
+                }
+
+                if (xCheckpoint >= xOtherJobs.xNextDeadline)
+                {
+                    if (xOtherJobs.xPeriod != (TickType_t)0U)
+                    {
+                        xDemand += (((xCheckpoint - xOtherJobs.xNextDeadline) / xOtherJobs.xPeriod) + (TickType_t)1U) * xOtherJobs.xWCET;
+                    }
+                    else
+                    {
+                        xDemand += xOtherJobs.xWCET;
+                    }
+                }
+            }
+
+            if (xDemand >= xCheckpoint)
+            {
+                xSlack = (TickType_t)0U;
+            }
+            else if ((TickType_t)(xCheckpoint - xDemand) < xSlack)
+            {
+                xSlack = xCheckpoint - xDemand;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* On to the deadline of the next job of the task. */
+            if (xCheckpoint < xJobs.xNextDeadline)
+            {
+                xCheckpoint = xJobs.xNextDeadline;
+            }
+            else if (xJobs.xPeriod != (TickType_t)0U)
+            {
+                xCheckpoint += xJobs.xPeriod;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    return xSlack;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSlackServerTick(TCB_t *const pxIdleTCB)
+{
+    const BaseType_t xWasAhead = (xSlackBudget != (TickType_t)0U) ? pdTRUE : pdFALSE;
+    TickType_t xCost;
+    BaseType_t xReturn = pdFALSE;
+
+    if (xSlackBudget != (TickType_t)0U)
+    {
+        if (pxCurrentTCB == pxIdleTCB)
+        {
+            xSlackBudget--;
+            xSlackStats.ulTicksStolen++;
+
+            if (xSlackBudget == (TickType_t)0U)
+            {
+                /* The item ran for longer than it said it would, it carries
+                 * on in the background. */
+                xSlackStats.ulOverruns++;
+            }
+        }
+
+        if (eCriticalityMode == eTaskCriticalityHI)
+        {
+            /* The slack was found with the LO mode WCETs. */
+            xSlackBudget = (TickType_t)0U;
+        }
+    }
+    else if ((xSlackGranted == pdFALSE) &&
+             ((xSlackActiveCost != (TickType_t)0U) || (uxSlackWaiting != 0U)) &&
+             (listCURRENT_LIST_LENGTH(&xReadyTasksListEDF) > (UBaseType_t)1U))
+    {
+        /* An item that started in idle time needs all of its cost again. */
+        xCost = (xSlackActiveCost != (TickType_t)0U) ? xSlackActiveCost : xSlackQueue[uxSlackHead].xCost;
+        xSlackStats.xLastSlack = prvComputeSlack();
+
+        if (xSlackStats.xLastSlack >= xCost)
+        {
+            xSlackBudget = xCost;
+            xSlackGranted = pdTRUE;
+            xSlackStats.ulGrants++;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if ((xSlackBudget != (TickType_t)0U) || (xWasAhead != pdFALSE))
+    {
+        /* While it holds a grant the idle task runs ahead of every job that
+         * is not already late, once the grant ends it goes back behind them
+         * all. */
+        pxIdleTCB->xTaskDeadline = (xSlackBudget != (TickType_t)0U) ? xTickCount : taskEDF_IDLE_DEADLINE;
+
+        (void)uxListRemove(&(pxIdleTCB->xStateListItem));
+        prvAddTaskToReadyList(pxIdleTCB);
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunSlackWork(void)
+{
+    SlackWork_t xWork;
+    BaseType_t xRun = pdFALSE;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    taskENTER_CRITICAL();
+    {
+        /* Without a grant an item only starts while no job is ready. */
+        if ((uxSlackWaiting != 0U) &&
+            ((xSlackBudget != (TickType_t)0U) || (listCURRENT_LIST_LENGTH(&xReadyTasksListEDF) == (UBaseType_t)1U)))
+        {
+            xWork = xSlackQueue[uxSlackHead];
+            uxSlackHead++;
+
+            if (uxSlackHead >= (UBaseType_t)configSLACK_QUEUE_LENGTH)
+            {
+                uxSlackHead = 0U;
+            }
+
+            uxSlackWaiting--;
+            xSlackActiveCost = xWork.xCost;
+            xRun = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (xRun != pdFALSE)
+    {
+        xWork.pxFunction(xWork.pvParameter);
+
+        taskENTER_CRITICAL();
+        {
+            xSlackStats.ulItemsRun++;
+            xSlackActiveCost = (TickType_t)0U;
+            xSlackGranted = pdFALSE;
+
+            if (xSlackBudget != (TickType_t)0U)
+            {
+                /* Hand the rest of the grant back to the jobs. */
+                xSlackBudget = (TickType_t)0U;
+                (void)uxListRemove(&(pxCurrentTCB->xStateListItem));
+                prvReleaseJob(pxCurrentTCB, xTickCount);
+                prvAddTaskToReadyList(pxCurrentTCB);
+                xYieldRequired = (listGET_OWNER_OF_HEAD_ENTRY(&xReadyTasksListEDF) != pxCurrentTCB) ? pdTRUE : pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (xYieldRequired != pdFALSE)
+        {
+            taskYIELD();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRunInSlack(TaskSlackFunction_t pxFunction,
+                           void *pvParameter,
+                           TickType_t xCost)
+{
+    UBaseType_t uxTail;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT(pxFunction);
+    configASSERT(xCost > (TickType_t)0U);
+
+    taskENTER_CRITICAL();
+    {
+        if (uxSlackWaiting < (UBaseType_t)configSLACK_QUEUE_LENGTH)
+        {
+            uxTail = uxSlackHead + uxSlackWaiting;
+
+            if (uxTail >= (UBaseType_t)configSLACK_QUEUE_LENGTH)
+            {
+                uxTail -= (UBaseType_t)configSLACK_QUEUE_LENGTH;
+            }
+
+            xSlackQueue[uxTail].pxFunction = pxFunction;
+            xSlackQueue[uxTail].pvParameter = pvParameter;
+            xSlackQueue[uxTail].xCost = xCost;
+            uxSlackWaiting++;
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xSlackStats.ulItemsRefused++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetAvailableSlack(void)
+{
+    TickType_t xReturn;
+
+    /* E.C. the lists the slack is computed from only change in the tick and
+     * in tasks, so interrupts can stay enabled. */
+    vTaskSuspendAll();
+    {
+        xReturn = prvComputeSlack();
+    }
+    (void)xTaskResumeAll();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetSlackStats(SlackStats_t *const pxSlackStats)
+{
+    configASSERT(pxSlackStats);
+
+    taskENTER_CRITICAL();
+    {
+        *pxSlackStats = xSlackStats;
+        pxSlackStats->uxWaiting = uxSlackWaiting;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if (INCLUDE_xTaskDelayUntil == 1)
+
+BaseType_t xTaskDelayUntilNextPeriod(TickType_t *const pxPreviousWakeTime)
+{
+    /* E.C. the next job is due one period of the current job after this
+     * one.  A period set by xTaskSetPeriod() since applies from that release
+     * on. */
+    return xTaskDelayUntil(pxPreviousWakeTime, pxCurrentTCB->xTaskPeriod);
+}
+
+#endif /* INCLUDE_xTaskDelayUntil */
+/*-----------------------------------------------------------*/
+
+#if (INCLUDE_vTaskDelete == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
+
+static BaseType_t prvTaskHasActiveJob(const TCB_t *const pxTCB)
+{
+    BaseType_t xReturn = pdTRUE;
+
+    /* E.C. a task that waits for its next period, or for its next sporadic
+     * release, has completed its job.  One blocked mid-job, on an event or in
+     * vTaskDelay(), has not.  A suspended task cannot complete its job, so it
+     * does not hold the mode change back either. */
+    if ((pxTCB->ucWaitingForPeriod != (uint8_t)pdFALSE) || (pxTCB->ucSporadicState == taskSPORADIC_WAITING))
+    {
+        xReturn = pdFALSE;
+    }
+
+#if (INCLUDE_vTaskSuspend == 1)
+    else if ((listLIST_ITEM_CONTAINER(&(pxTCB->xStateListItem)) == &xSuspendedTaskList) &&
+             (listLIST_ITEM_CONTAINER(&(pxTCB->xEventListItem)) == NULL))
+    {
+        xReturn = pdFALSE;
+    }
+#endif
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskModeChange(const TaskHandle_t *const pxOldTasks,
+                           const UBaseType_t uxOldTasks,
+                           const EDFTaskParameters_t *const pxNewTasks,
+                           const UBaseType_t uxNewTasks,
+                           const BaseType_t xAbortOldJobs)
+{
+    TCB_t *pxTCB;
+    const EDFTaskParameters_t *pxNew;
+    TickType_t xNow, xModeStart;
+    uint32_t ulUtilisation, ulNewUtilisation, ulLimit;
+    uint32_t ulHILO = ulHIUtilisationLO, ulHIHI = ulHIUtilisationHI;
+    UBaseType_t uxTask, uxCreated = (UBaseType_t)0U;
+    BaseType_t xReturn = pdPASS, xRetireSelf = pdFALSE;
+
+    configASSERT((pxOldTasks != NULL) || (uxOldTasks == (UBaseType_t)0U));
+    configASSERT((pxNewTasks != NULL) || (uxNewTasks == (UBaseType_t)0U));
+
+    vTaskSuspendAll();
+    {
+        xNow = xTickCount;
+        xModeStart = xNow;
+
+        /* E.C. one mode change at a time: the retiring tasks of the previous
+         * one are not part of either task set. */
+        if (xModeChangeStats.uxRetiringTasks != (UBaseType_t)0U)
+        {
+            xReturn = pdFAIL;
+        }
+
+        /* E.C. admission.  New jobs are only released once every old job has
+         * completed or been aborted, so the two task sets never compete for
+         * the processor and the new mode is the only one that needs
+         * checking. */
+        if (xReturn == pdPASS)
+        {
+            ulUtilisation = ulTotalUtilisation;
+
+            for (uxTask = 0; uxTask < uxOldTasks; uxTask++)
+            {
+                pxTCB = pxOldTasks[uxTask];
+                configASSERT(pxTCB != NULL);
+                configASSERT(pxTCB != xIdleTaskHandle);
+                ulUtilisation -= pxTCB->ulTaskUtilisation;
+
+                if (pxTCB->ucCriticality == (uint8_t)eTaskCriticalityHI)
+                {
+                    ulHILO -= pxTCB->ulTaskUtilisation;
+                    ulHIHI -= pxTCB->ulTaskUtilisationHI;
+                }
+            }
+
+            /* The new tasks are LO tasks, the HI tasks that stay set the
+             * limit. */
+            ulLimit = prvUtilisationLimit(ulHILO, ulHIHI);
+
+            if (ulUtilisation > ulLimit)
+            {
+                xReturn = pdFAIL;
+            }
+
+            for (uxTask = 0; (uxTask < uxNewTasks) && (xReturn == pdPASS); uxTask++)
+            {
+                pxNew = &(pxNewTasks[uxTask]);
+                configASSERT(pxNew->pxCreatedTask != NULL);
+                configASSERT(pxNew->xOffset < pxNew->xPeriod);
+
+                ulNewUtilisation = prvComputeUtilisation(pxNew->xWCET, pxNew->xPeriod, pxNew->xPeriod);
+
+                if (ulNewUtilisation > (ulLimit - ulUtilisation))
+                {
+                    xReturn = pdFAIL;
+                }
+                else
+                {
+                    ulUtilisation += ulNewUtilisation;
+                }
+            }
+        }
+
+        /* E.C. the new mode starts when the last unfinished old job reaches
+         * its deadline, so the switch never takes longer than the longest
+         * relative deadline of the old tasks.  A job that already missed its
+         * deadline does not hold the new mode back. */
+        if ((xReturn == pdPASS) && (xAbortOldJobs == pdFALSE))
+        {
+            for (uxTask = 0; uxTask < uxOldTasks; uxTask++)
+            {
+                pxTCB = pxOldTasks[uxTask];
+
+                if ((prvTaskHasActiveJob(pxTCB) != pdFALSE) &&
+                    ((TickType_t)(pxTCB->xTaskDeadline - xNow) <= pxTCB->xTaskRelativeDeadline) &&
+                    ((TickType_t)(pxTCB->xTaskDeadline - xNow) > (TickType_t)(xModeStart - xNow)))
+                {
+                    xModeStart = pxTCB->xTaskDeadline;
+                }
+            }
+        }
+
+        if (xReturn == pdPASS)
+        {
+            for (uxCreated = 0; uxCreated < uxNewTasks; uxCreated++)
+            {
+                pxNew = &(pxNewTasks[uxCreated]);
+                xReturn = prvCreateEDFTask(pxNew->pxTaskCode, pxNew->pcName, pxNew->usStackDepth, pxNew->pvParameters, pxNew->uxPriority, pxNew->pxCreatedTask,
+                                           pxNew->xPeriod, pxNew->xPeriod, (TickType_t)(xModeStart - xNow) + pxNew->xOffset, taskNOT_SPORADIC);
+
+                if (xReturn != pdPASS)
+                {
+                    break;
+                }
+            }
+
+            if (xReturn != pdPASS)
+            {
+                /* E.C. out of memory, leave the old mode as it was. */
+                while (uxCreated > (UBaseType_t)0U)
+                {
+                    uxCreated--;
+                    vTaskDelete(*(pxNewTasks[uxCreated].pxCreatedTask));
+                    *(pxNewTasks[uxCreated].pxCreatedTask) = NULL;
+                }
+            }
+        }
+
+        if (xReturn == pdPASS)
+        {
+            for (uxTask = 0; uxTask < uxNewTasks; uxTask++)
+            {
+                pxNew = &(pxNewTasks[uxTask]);
+                pxTCB = *(pxNew->pxCreatedTask);
+                pxTCB->xTaskWCET = pxNew->xWCET;
+                pxTCB->ulTaskUtilisation = prvComputeUtilisation(pxNew->xWCET, pxNew->xPeriod, pxNew->xPeriod);
+            }
+
+            /* The old tasks were taken out of the total by the admission
+             * check, so clear their share before vTaskDelete() sees it. */
+            for (uxTask = 0; uxTask < uxOldTasks; uxTask++)
+            {
+                pxOldTasks[uxTask]->ulTaskUtilisation = 0UL;
+                pxOldTasks[uxTask]->ulTaskUtilisationHI = 0UL;
+            }
+
+            ulTotalUtilisation = ulUtilisation;
+            ulHIUtilisationLO = ulHILO;
+            ulHIUtilisationHI = ulHIHI;
+            prvUpdateCriticality();
+
+            xModeChangeStats.xRequestTime = xNow;
+            xModeChangeStats.xReleaseTime = xModeStart;
+            xModeChangeStats.xLastLatency = (TickType_t)(xModeStart - xNow);
+
+            if (xModeChangeStats.xLastLatency > xModeChangeStats.xMaxLatency)
+            {
+                xModeChangeStats.xMaxLatency = xModeChangeStats.xLastLatency;
+            }
+
+            for (uxTask = 0; uxTask < uxOldTasks; uxTask++)
+            {
+                pxTCB = pxOldTasks[uxTask];
+
+                if (pxTCB == pxCurrentTCB)
+                {
+                    /* A task cannot delete itself with the scheduler
+                     * suspended.  It leaves at the end of its job, or as soon
+                     * as the scheduler is resumed if its job is aborted. */
+                    pxTCB->ucRetiring = (uint8_t)pdTRUE;
+                    xModeChangeStats.uxRetiringTasks++;
+                    xRetireSelf = xAbortOldJobs;
+                }
+                else if ((xAbortOldJobs != pdFALSE) || (prvTaskHasActiveJob(pxTCB) == pdFALSE))
+                {
+                    vTaskDelete(pxTCB);
+                }
+                else
+                {
+                    pxTCB->ucRetiring = (uint8_t)pdTRUE;
+                    xModeChangeStats.uxRetiringTasks++;
+                }
+            }
+
+            if (xModeChangeStats.uxRetiringTasks == (UBaseType_t)0U)
+            {
+                xModeChangeStats.xRetiredTime = xNow;
+            }
+
+            prvElasticCompress();
+        }
+    }
+    (void)xTaskResumeAll();
+
+    if (xRetireSelf != pdFALSE)
+    {
+        vTaskDelete(NULL);
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetModeChangeStats(ModeChangeStats_t *const pxModeChangeStats)
+{
+    configASSERT(pxModeChangeStats);
+
+    taskENTER_CRITICAL();
+    {
+        *pxModeChangeStats = xModeChangeStats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_STATIC_TASK_SET == 0 ) */
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_SCHEDULER == 1) && (INCLUDE_vTaskSuspend == 1)
+
+static BaseType_t prvReleaseSporadicJob(TCB_t *const pxTCB,
+                                        BaseType_t *const pxYieldRequired)
+{
+    BaseType_t xReturn = pdPASS;
+
+    configASSERT(pxTCB->ucSporadicState != taskNOT_SPORADIC);
+
+    if (pxTCB->ucSporadicState == taskSPORADIC_WAITING)
+    {
+        if (uxSchedulerSuspended == (UBaseType_t)pdFALSE)
+        {
+            (void)uxListRemove(&(pxTCB->xStateListItem));
+            pxTCB->ucSporadicState = taskSPORADIC_RELEASED;
+
+            if ((TickType_t)(xTickCount - pxTCB->xTaskReleaseTime) >= pxTCB->xTaskPeriod)
+            {
+                /* The deadline is relative to the actual release. */
+                prvReleaseJob(pxTCB, xTickCount);
+                prvAddTaskToReadyList(pxTCB);
+                taskEDF_STAMP_RELEASE(pxTCB);
+                *pxYieldRequired = taskEDF_PREEMPTS_CURRENT(pxTCB);
+            }
+            else
+            {
+                /* Released before the minimum inter-arrival time elapsed.
+                 * The release is deferred until it has, and
+                 * xTaskIncrementTick() then releases the job and sets its
+                 * deadline. */
+                pxTCB->ucWaitingForPeriod = (uint8_t)pdTRUE;
+                prvAddTaskToDelayedList(pxTCB, pxTCB->xTaskReleaseTime + pxTCB->xTaskPeriod);
+            }
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed while the
+             * scheduler is suspended.  Hold the task in the pending ready
+             * list, it checks the minimum inter-arrival time itself when it
+             * runs. */
+            pxTCB->ucSporadicState = taskSPORADIC_DEFERRED;
+            pxTCB->xTaskDeadline = xTickCount + pxTCB->xTaskNextRelativeDeadline;
+            listINSERT_END(&(xPendingReadyList), &(pxTCB->xEventListItem));
+            taskEDF_STAMP_RELEASE(pxTCB);
+            *pxYieldRequired = taskEDF_PREEMPTS_CURRENT(pxTCB);
+        }
+    }
+    else if (pxTCB->ucPendingReleases < taskSPORADIC_MAX_PENDING_RELEASES)
+    {
+        /* The task has not finished with an earlier release yet, it serves
+         * this one the next time it calls xTaskWaitForRelease(). */
+        pxTCB->ucPendingReleases++;
+    }
+    else
+    {
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskWaitForRelease(void)
+{
+    BaseType_t xReturn;
+
+    configASSERT(pxCurrentTCB->ucSporadicState != taskNOT_SPORADIC);
+
+    taskEDF_RETIRE_IF_REQUESTED();
+
+    taskENTER_CRITICAL();
+    {
+        prvCompleteJob();
+
+        if (pxCurrentTCB->ucPendingReleases == 0U)
+        {
+            /* The job is complete and no other release arrived while it
+             * ran, so wait for the next one. */
+            pxCurrentTCB->ucSporadicState = taskSPORADIC_WAITING;
+            prvAddCurrentTaskToDelayedList(portMAX_DELAY, pdTRUE);
+
+            /* All ports are written to allow a yield in a critical
+             * section (some will yield immediately, others wait until the
+             * critical section exits) - but it is not something that
+             * application code should ever do. */
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            /* Serve a release that arrived while the job ran, once the
+             * minimum inter-arrival time allows it. */
+            pxCurrentTCB->ucPendingReleases--;
+            pxCurrentTCB->ucSporadicState = taskSPORADIC_DEFERRED;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    taskENTER_CRITICAL();
+    {
+        if (pxCurrentTCB->ucSporadicState == taskSPORADIC_DEFERRED)
+        {
+            pxCurrentTCB->ucSporadicState = taskSPORADIC_RELEASED;
+
+            if ((TickType_t)(xTickCount - pxCurrentTCB->xTaskReleaseTime) >= pxCurrentTCB->xTaskPeriod)
+            {
+                /* Move the task to the position of its new deadline. */
+                (void)uxListRemove(&(pxCurrentTCB->xStateListItem));
+                prvReleaseJob(pxCurrentTCB, xTickCount);
+                prvAddTaskToReadyList(pxCurrentTCB);
+            }
+            else
+            {
+                pxCurrentTCB->ucWaitingForPeriod = (uint8_t)pdTRUE;
+                prvAddCurrentTaskToDelayedList((pxCurrentTCB->xTaskReleaseTime + pxCurrentTCB->xTaskPeriod) - xTickCount, pdFALSE);
+            }
+
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Anything other than a release means the wait was ended by
+         * vTaskSuspend() or xTaskAbortDelay(). */
+        if (pxCurrentTCB->ucSporadicState == taskSPORADIC_RELEASED)
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        pxCurrentTCB->ucSporadicState = taskSPORADIC_JOB_ACTIVE;
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskReleaseSporadic(TaskHandle_t xTask)
+{
+    TCB_t *const pxTCB = xTask;
+    BaseType_t xReturn, xYieldRequired = pdFALSE;
+
+    configASSERT(pxTCB);
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvReleaseSporadicJob(pxTCB, &xYieldRequired);
+
+        if (xYieldRequired != pdFALSE)
+        {
+            taskYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskReleaseSporadicFromISR(TaskHandle_t xTask,
+                                       BaseType_t *pxHigherPriorityTaskWoken)
+{
+    TCB_t *const pxTCB = xTask;
+    BaseType_t xReturn, xYieldRequired = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(pxTCB);
+
+    /* See the comment in xTaskResumeFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = prvReleaseSporadicJob(pxTCB, &xYieldRequired);
+
+        if (xYieldRequired != pdFALSE)
+        {
+            if (pxHigherPriorityTaskWoken != NULL)
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+
+            /* Mark that a yield is pending in case the user is not using
+             * the "xHigherPriorityTaskWoken" parameter. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
 
     return xReturn;
 }
 
-#endif /* E.C.	EDF Periodic Task */
-
-#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) */
 /*-----------------------------------------------------------*/
 
 static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
@@ -1060,6 +4199,53 @@ static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE(&(pxNewTCB->xEventListItem), (TickType_t)configMAX_PRIORITIES - (TickType_t)uxPriority); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     listSET_LIST_ITEM_OWNER(&(pxNewTCB->xEventListItem), pxNewTCB);
 
+#if (configUSE_EDF_SCHEDULER == 1)
+    {
+        /* E.C. tasks are released when they are created unless
+         * xPeriodicTaskCreateWithOffset() says otherwise. */
+        pxNewTCB->xTaskReleaseTime = xTickCount;
+        pxNewTCB->xTaskRelativeDeadline = (TickType_t)0U;
+        pxNewTCB->xTaskNextPeriod = (TickType_t)0U;
+        pxNewTCB->xTaskNextRelativeDeadline = (TickType_t)0U;
+        pxNewTCB->xTaskDeadline = xTickCount;
+        pxNewTCB->ucSporadicState = taskNOT_SPORADIC;
+        pxNewTCB->ucPendingReleases = 0U;
+        pxNewTCB->ucRetiring = (uint8_t)pdFALSE;
+        pxNewTCB->xTaskWCET = (TickType_t)0U;
+        pxNewTCB->ulTaskUtilisation = 0UL;
+        vListInitialiseItem(&(pxNewTCB->xElasticListItem));
+        listSET_LIST_ITEM_OWNER(&(pxNewTCB->xElasticListItem), pxNewTCB);
+        pxNewTCB->ucFirmM = 0U;
+        pxNewTCB->ucFirmK = 0U;
+        pxNewTCB->ucSkippedJobs = 0U;
+        pxNewTCB->ucWaitingForPeriod = (uint8_t)pdFALSE;
+        pxNewTCB->ulSkipHistory = 0UL;
+        pxNewTCB->ucCriticality = (uint8_t)eTaskCriticalityLO;
+        pxNewTCB->xTaskWCETHI = (TickType_t)0U;
+        pxNewTCB->ulTaskUtilisationHI = 0UL;
+        pxNewTCB->xJobExecutionTime = (TickType_t)0U;
+        (void)memset((void *)&(pxNewTCB->xJobStats), 0x00, sizeof(TaskJobStats_t));
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+        pxNewTCB->ucReleaseLatencyPending = (uint8_t)pdFALSE;
+        pxNewTCB->ulLastReleaseLatency = (configRUN_TIME_COUNTER_TYPE)0;
+        pxNewTCB->ulMaxReleaseLatency = (configRUN_TIME_COUNTER_TYPE)0;
+#endif
+
+#if (configJOB_TRACE_LENGTH > 0) && (configGENERATE_RUN_TIME_STATS == 1)
+        pxNewTCB->ulJobRunTimeStart = (configRUN_TIME_COUNTER_TYPE)0;
+#endif
+
+#if (taskEDF_TRACK_JOB_START == 1)
+        pxNewTCB->ucJobStarted = (uint8_t)pdFALSE;
+#endif
+
+#if (configUSE_JOB_HISTOGRAMS == 1)
+        (void)memset((void *)&(pxNewTCB->xHistograms[0]), 0x00, sizeof(pxNewTCB->xHistograms));
+#endif
+    }
+#endif
+
 #if (portUSING_MPU_WRAPPERS == 1)
     {
         vPortStoreTaskMPUSettings(&(pxNewTCB->xMPUSettings), xRegions, pxNewTCB->pxStack, ulStackDepth);
@@ -1176,13 +4362,9 @@ static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB)
              * so far. */
             if (xSchedulerRunning == pdFALSE)
             {
-/* E.C. select the task with nearest deadline to be the current task */
-#if (configUSE_EDF_SCHEDULER == 1)
-                {
-                    pxCurrentTCB = (TCB_t *)listGET_OWNER_OF_HEAD_ENTRY(&(xReadyTasksListEDF));
-                }
-
-#else
+/* E.C. the task with nearest deadline is selected once the new task is in
+ * the EDF ready list, see below. */
+#if (configUSE_EDF_SCHEDULER == 0)
                 if (pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority)
                 {
                     pxCurrentTCB = pxNewTCB;
@@ -1209,7 +4391,37 @@ static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB)
 #endif /* configUSE_TRACE_FACILITY */
         traceTASK_CREATE(pxNewTCB);
 
+#if (configUSE_EDF_SCHEDULER == 1)
+        {
+            /* E.C. a task created with a release offset waits in the Blocked
+             * state until its first job is released, and a sporadic task
+             * waits until it is released by xTaskReleaseSporadic(). */
+#if (INCLUDE_vTaskSuspend == 1)
+            if (pxNewTCB->ucSporadicState == taskSPORADIC_WAITING)
+            {
+                listINSERT_END(&xSuspendedTaskList, &(pxNewTCB->xStateListItem));
+            }
+            else
+#endif
+            if (pxNewTCB->xTaskReleaseTime != xTickCount)
+            {
+                pxNewTCB->ucWaitingForPeriod = (uint8_t)pdTRUE;
+                prvAddTaskToDelayedList(pxNewTCB, pxNewTCB->xTaskReleaseTime);
+            }
+            else
+            {
+                prvAddTaskToReadyList(pxNewTCB);
+            }
+
+            /* E.C. select the task with nearest deadline to be the current task */
+            if ((xSchedulerRunning == pdFALSE) && (listLIST_IS_EMPTY(&(xReadyTasksListEDF)) == pdFALSE))
+            {
+                pxCurrentTCB = (TCB_t *)listGET_OWNER_OF_HEAD_ENTRY(&(xReadyTasksListEDF));
+            }
+        }
+#else
         prvAddTaskToReadyList(pxNewTCB);
+#endif
 
         portSETUP_TCB(pxNewTCB);
     }
@@ -1219,7 +4431,15 @@ static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB)
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
+#if (configUSE_EDF_SCHEDULER == 1)
+        /* E.C. under EDF that is a job released now with a nearer deadline.
+         * A task created with an offset, or a sporadic task, has no job
+         * released yet. */
+        if ((listIS_CONTAINED_WITHIN(&xReadyTasksListEDF, &(pxNewTCB->xStateListItem)) != pdFALSE) &&
+            (taskEDF_PREEMPTS_CURRENT(pxNewTCB) != pdFALSE))
+#else
         if (pxCurrentTCB->uxPriority < pxNewTCB->uxPriority)
+#endif
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1247,6 +4467,41 @@ void vTaskDelete(TaskHandle_t xTaskToDelete)
          * being deleted. */
         pxTCB = prvGetTCBFromHandle(xTaskToDelete);
 
+#if (configUSE_EDF_SCHEDULER == 1)
+        {
+            /* E.C. the processor time admitted for the task is free again.
+             * The elastic tasks get it back at the next compression. */
+            if (pxTCB->ucCriticality == (uint8_t)eTaskCriticalityHI)
+            {
+                ulHIUtilisationLO -= pxTCB->ulTaskUtilisation;
+                ulHIUtilisationHI -= pxTCB->ulTaskUtilisationHI;
+                pxTCB->ulTaskUtilisationHI = 0UL;
+            }
+
+            ulTotalUtilisation -= pxTCB->ulTaskUtilisation;
+            pxTCB->ulTaskUtilisation = 0UL;
+            prvUpdateCriticality();
+
+            if (listLIST_ITEM_CONTAINER(&(pxTCB->xElasticListItem)) != NULL)
+            {
+                (void)uxListRemove(&(pxTCB->xElasticListItem));
+            }
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configUSE_EDF_STATIC_TASK_SET == 0)
+            if (pxTCB->ucRetiring != (uint8_t)pdFALSE)
+            {
+                pxTCB->ucRetiring = (uint8_t)pdFALSE;
+                xModeChangeStats.uxRetiringTasks--;
+
+                if (xModeChangeStats.uxRetiringTasks == (UBaseType_t)0U)
+                {
+                    xModeChangeStats.xRetiredTime = xTickCount;
+                }
+            }
+#endif
+        }
+#endif
+
         /* Remove task from the ready/delayed list. */
         if (uxListRemove(&(pxTCB->xStateListItem)) == (UBaseType_t)0)
         {
@@ -1349,12 +4604,30 @@ BaseType_t xTaskDelayUntil(TickType_t *const pxPreviousWakeTime,
     configASSERT((xTimeIncrement > 0U));
     configASSERT(uxSchedulerSuspended == 0);
 
+#if (configUSE_EDF_SCHEDULER == 1)
+    taskEDF_RETIRE_IF_REQUESTED();
+#endif
+
     vTaskSuspendAll();
     {
         /* Minor optimisation.  The tick count cannot change in this
          * block. */
         const TickType_t xConstTickCount = xTickCount;
 
+#if (configUSE_EDF_SCHEDULER == 1)
+        {
+            prvCompleteJob();
+
+            /* E.C. jobs skipped by the kernel moved the release of the job
+             * that just completed on by whole periods. */
+            if (pxCurrentTCB->ucSkippedJobs != 0U)
+            {
+                pxCurrentTCB->ucSkippedJobs = 0U;
+                *pxPreviousWakeTime = pxCurrentTCB->xTaskReleaseTime;
+            }
+        }
+#endif
+
         /* Generate the tick time at which the task wants to wake. */
         xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
 
@@ -1389,6 +4662,39 @@ BaseType_t xTaskDelayUntil(TickType_t *const pxPreviousWakeTime,
             }
         }
 
+#if (configUSE_EDF_SCHEDULER == 1)
+        if (xShouldDelay == pdFALSE)
+        {
+            /* E.C. the next job is already due, the task is overrunning.  An
+             * (m,k)-firm task skips as many of its overdue jobs as the
+             * constraint and the load allow.  A job that is not skipped is
+             * released now, with the deadline of its release time, so an
+             * overrunning task does not keep the earlier deadline of the job
+             * that just completed. */
+            TickType_t xOverdue = xConstTickCount - xTimeToWake;
+
+            while (prvSkipFirmJob(pxCurrentTCB, xTimeToWake) != pdFALSE)
+            {
+                xTimeToWake += xTimeIncrement;
+
+                if (xOverdue < xTimeIncrement)
+                {
+                    xShouldDelay = pdTRUE;
+                    break;
+                }
+
+                xOverdue -= xTimeIncrement;
+            }
+
+            if (xShouldDelay == pdFALSE)
+            {
+                (void)uxListRemove(&(pxCurrentTCB->xStateListItem));
+                prvReleaseJob(pxCurrentTCB, xTimeToWake);
+                prvAddTaskToReadyList(pxCurrentTCB);
+            }
+        }
+#endif
+
         /* Update the wake time ready for the next call. */
         *pxPreviousWakeTime = xTimeToWake;
 
@@ -1396,6 +4702,11 @@ BaseType_t xTaskDelayUntil(TickType_t *const pxPreviousWakeTime,
         {
             traceTASK_DELAY_UNTIL(xTimeToWake);
 
+#if (configUSE_EDF_SCHEDULER == 1)
+            /* E.C. see prvResumeIntoPeriod(). */
+            pxCurrentTCB->ucWaitingForPeriod = (uint8_t)pdTRUE;
+#endif
+
             /* prvAddCurrentTaskToDelayedList() needs the block time, not
              * the time to wake, so subtract the current tick count. */
             prvAddCurrentTaskToDelayedList(xTimeToWake - xConstTickCount, pdFALSE);
@@ -1536,6 +4847,17 @@ eTaskState eTaskGetState(TaskHandle_t xTask)
                     eReturn = eSuspended;
                 }
 #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+
+#if (configUSE_EDF_SCHEDULER == 1)
+                {
+                    /* E.C. or waiting for the next release of a sporadic
+                     * task. */
+                    if (pxTCB->ucSporadicState == taskSPORADIC_WAITING)
+                    {
+                        eReturn = eBlocked;
+                    }
+                }
+#endif
             }
             else
             {
@@ -1739,7 +5061,7 @@ void vTaskPrioritySet(TaskHandle_t xTask,
 
             /* Only reset the event list item value if the value is not
              * being used for anything else. */
-            if ((listGET_LIST_ITEM_VALUE(&(pxTCB->xEventListItem)) & taskEVENT_LIST_ITEM_VALUE_IN_USE) == 0UL)
+            if (taskEVENT_LIST_ITEM_VALUE_HOLDS_PRIORITY(pxTCB) != pdFALSE)
             {
                 listSET_LIST_ITEM_VALUE(&(pxTCB->xEventListItem), ((TickType_t)configMAX_PRIORITIES - (TickType_t)uxNewPriority)); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
             }
@@ -1752,7 +5074,7 @@ void vTaskPrioritySet(TaskHandle_t xTask,
              * nothing more than change its priority variable. However, if
              * the task is in a ready list it needs to be removed and placed
              * in the list appropriate to its new priority. */
-            if (listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[uxPriorityUsedOnEntry]), &(pxTCB->xStateListItem)) != pdFALSE)
+            if (taskIS_IN_PRIORITY_READY_LIST(uxPriorityUsedOnEntry, pxTCB) != pdFALSE)
             {
                 /* The task is currently in its ready list - remove before
                  * adding it to its new ready list.  As we are in a critical
@@ -1848,6 +5170,18 @@ void vTaskSuspend(TaskHandle_t xTaskToSuspend)
             }
         }
 #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+
+#if (configUSE_EDF_SCHEDULER == 1)
+        {
+            if (pxTCB->ucSporadicState == taskSPORADIC_WAITING)
+            {
+                /* E.C. the task was waiting for a release but is now
+                 * suspended.  Releases are counted as pending until it is
+                 * resumed. */
+                pxTCB->ucSporadicState = taskSPORADIC_JOB_ACTIVE;
+            }
+        }
+#endif
     }
     taskEXIT_CRITICAL();
 
@@ -1925,7 +5259,14 @@ static BaseType_t prvTaskIsTaskSuspended(const TaskHandle_t xTask)
              * state, or because is is blocked with no timeout? */
             if (listIS_CONTAINED_WITHIN(NULL, &(pxTCB->xEventListItem)) != pdFALSE) /*lint !e961.  The cast is only redundant when NULL is used. */
             {
-                xReturn = pdTRUE;
+#if (configUSE_EDF_SCHEDULER == 1)
+                /* E.C. a sporadic task waiting for its next release is
+                 * Blocked, not Suspended. */
+                if (pxTCB->ucSporadicState != taskSPORADIC_WAITING)
+#endif
+                {
+                    xReturn = pdTRUE;
+                }
             }
             else
             {
@@ -1948,6 +5289,51 @@ static BaseType_t prvTaskIsTaskSuspended(const TaskHandle_t xTask)
 #endif /* INCLUDE_vTaskSuspend */
 /*-----------------------------------------------------------*/
 
+#if (configUSE_EDF_SCHEDULER == 1) && (INCLUDE_vTaskSuspend == 1)
+
+static BaseType_t prvResumeIntoPeriod(TCB_t *const pxTCB)
+{
+    /* The state list item still holds the release the task was waiting for. */
+    TickType_t xNextRelease = listGET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem));
+    const TickType_t xLate = xTickCount - xNextRelease;
+    TickType_t xMissed;
+    BaseType_t xReturn = pdFALSE;
+
+    /* The release is never more than a period ahead, so a difference of more
+     * than half the tick range means it has not been reached yet. */
+    if ((xLate != (TickType_t)0U) && (xLate <= (portMAX_DELAY >> 1)))
+    {
+        xMissed = ((xLate - (TickType_t)1U) / pxTCB->xTaskPeriod) + (TickType_t)1U;
+        xNextRelease += xMissed * pxTCB->xTaskPeriod;
+
+        /* The task moves its own wake time on to the next release when it
+         * next completes a job, as it does for a skipped firm job. */
+        if (xMissed < (TickType_t)(0xFFU - pxTCB->ucSkippedJobs))
+        {
+            pxTCB->ucSkippedJobs += (uint8_t)xMissed;
+        }
+        else
+        {
+            pxTCB->ucSkippedJobs = (uint8_t)0xFFU;
+        }
+    }
+
+    if (xNextRelease == xTickCount)
+    {
+        prvReleaseJob(pxTCB, xTickCount);
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        prvAddTaskToDelayedList(pxTCB, xNextRelease);
+    }
+
+    return xReturn;
+}
+
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if (INCLUDE_vTaskSuspend == 1)
 
 void vTaskResume(TaskHandle_t xTaskToResume)
@@ -1970,6 +5356,26 @@ void vTaskResume(TaskHandle_t xTaskToResume)
                 /* The ready list can be accessed even if the scheduler is
                  * suspended because this is inside a critical section. */
                 (void)uxListRemove(&(pxTCB->xStateListItem));
+
+#if (configUSE_EDF_SCHEDULER == 1)
+                /* E.C. a job that was released before the task was suspended
+                 * keeps its deadline, and runs now only if that is nearer than
+                 * the deadline of the running job.  A task that was waiting for
+                 * its next period may have to go on waiting. */
+                if ((pxTCB->ucWaitingForPeriod == (uint8_t)pdFALSE) || (prvResumeIntoPeriod(pxTCB) != pdFALSE))
+                {
+                    prvAddTaskToReadyList(pxTCB);
+
+                    if (taskEDF_PREEMPTS_CURRENT(pxTCB))
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+#else
                 prvAddTaskToReadyList(pxTCB);
 
                 /* A higher priority task may have just been resumed. */
@@ -1984,6 +5390,7 @@ void vTaskResume(TaskHandle_t xTaskToResume)
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+#endif
             }
             else
             {
@@ -2041,6 +5448,25 @@ BaseType_t xTaskResumeFromISR(TaskHandle_t xTaskToResume)
             {
                 /* Ready lists can be accessed so move the task from the
                  * suspended list to the ready list directly. */
+#if (configUSE_EDF_SCHEDULER == 1)
+                /* E.C. as in vTaskResume(). */
+                (void)uxListRemove(&(pxTCB->xStateListItem));
+
+                if ((pxTCB->ucWaitingForPeriod == (uint8_t)pdFALSE) || (prvResumeIntoPeriod(pxTCB) != pdFALSE))
+                {
+                    prvAddTaskToReadyList(pxTCB);
+
+                    if (taskEDF_PREEMPTS_CURRENT(pxTCB))
+                    {
+                        xYieldRequired = pdTRUE;
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+#else
                 if (pxTCB->uxPriority >= pxCurrentTCB->uxPriority)
                 {
                     xYieldRequired = pdTRUE;
@@ -2057,6 +5483,7 @@ BaseType_t xTaskResumeFromISR(TaskHandle_t xTaskToResume)
 
                 (void)uxListRemove(&(pxTCB->xStateListItem));
                 prvAddTaskToReadyList(pxTCB);
+#endif
             }
             else
             {
@@ -2079,10 +5506,120 @@ BaseType_t xTaskResumeFromISR(TaskHandle_t xTaskToResume)
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ((INCLUDE_xTaskResumeFromISR == 1) && (INCLUDE_vTaskSuspend == 1) && (configUSE_EDF_SCHEDULER == 1))
+
+BaseType_t xTaskReleaseJobFromISR(TaskHandle_t xTaskToRelease,
+                                  TickType_t xRelativeDeadline)
+{
+    BaseType_t xYieldRequired = pdFALSE;
+    TCB_t *const pxTCB = xTaskToRelease;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT(xTaskToRelease);
+
+    /* See the comment in xTaskResumeFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if (prvTaskIsTaskSuspended(pxTCB) != pdFALSE)
+        {
+            traceTASK_RESUME_FROM_ISR(pxTCB);
+
+            /* E.C. the job is released now.  Its deadline is kept in the TCB
+             * so it is not lost if the task has to wait in the pending ready
+             * list. */
+            pxTCB->xTaskReleaseTime = xTickCount;
+            pxTCB->xTaskDeadline = xTickCount + xRelativeDeadline;
+            taskEDF_CLEAR_JOB_STARTED(pxTCB);
+            taskEDF_STAMP_RELEASE(pxTCB);
+
+            /* Check the ready lists can be accessed. */
+            if (uxSchedulerSuspended == (UBaseType_t)pdFALSE)
+            {
+                (void)uxListRemove(&(pxTCB->xStateListItem));
+                prvAddTaskToReadyList(pxTCB);
+
+                if (taskEDF_PREEMPTS_CURRENT(pxTCB))
+                {
+                    xYieldRequired = pdTRUE;
+
+                    /* Mark that a yield is pending in case the user is not
+                     * using the return value to initiate a context switch
+                     * from the ISR using portYIELD_FROM_ISR. */
+                    xYieldPending = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The delayed or ready lists cannot be accessed so the task
+                 * is held in the pending ready list until the scheduler is
+                 * unsuspended. */
+                vListInsertEnd(&(xPendingReadyList), &(pxTCB->xEventListItem));
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+    return xYieldRequired;
+}
+
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ((configUSE_EDF_SCHEDULER == 1) && (configGENERATE_RUN_TIME_STATS == 1))
+
+void vTaskGetReleaseLatency(TaskHandle_t xTask,
+                            configRUN_TIME_COUNTER_TYPE *const pulLastLatency,
+                            configRUN_TIME_COUNTER_TYPE *const pulMaxLatency)
+{
+    TCB_t *pxTCB;
+
+    taskENTER_CRITICAL();
+    {
+        pxTCB = prvGetTCBFromHandle(xTask);
+
+        if (pulLastLatency != NULL)
+        {
+            *pulLastLatency = pxTCB->ulLastReleaseLatency;
+        }
+
+        if (pulMaxLatency != NULL)
+        {
+            *pulMaxLatency = pxTCB->ulMaxReleaseLatency;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configGENERATE_RUN_TIME_STATS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 void vTaskStartScheduler(void)
 {
     BaseType_t xReturn;
 
+#if (configUSE_EDF_STATIC_TASK_SET == 1)
+    {
+        /* E.C. every task of edf_task_set.h must exist before the idle task
+         * is created, the kernel is not started otherwise. */
+        configASSERT(uxStaticTasksCreated == (UBaseType_t)edfTASK_SET_COUNT);
+
+        if (uxStaticTasksCreated != (UBaseType_t)edfTASK_SET_COUNT)
+        {
+            return;
+        }
+    }
+#endif
+
 /* Add the idle task at the lowest priority. */
 #if (configSUPPORT_STATIC_ALLOCATION == 1)
     {
@@ -2174,7 +5711,15 @@ void vTaskStartScheduler(void)
         }
 #endif
 
+#if (configUSE_EDF_SCHEDULER == 1)
+        {
+            /* E.C. tasks created with a release offset are already waiting
+             * in the delayed list. */
+            prvResetNextTaskUnblockTime();
+        }
+#else
         xNextTaskUnblockTime = portMAX_DELAY;
+#endif
         xSchedulerRunning = pdTRUE;
         xTickCount = (TickType_t)configINITIAL_TICK_COUNT;
 
@@ -2186,6 +5731,11 @@ void vTaskStartScheduler(void)
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+/* E.C. the first task is started without vTaskSwitchContext(). */
+#if (configUSE_EDF_SCHEDULER == 1)
+        taskEDF_RECORD_JOB_START(pxCurrentTCB);
+#endif
+
         traceTASK_SWITCHED_IN();
 
         /* Setting up the timer tick is hardware specific and thus in the
@@ -2251,6 +5801,51 @@ void vTaskSuspendAll(void)
 
 #if (configUSE_TICKLESS_IDLE != 0)
 
+#if (configUSE_EDF_SCHEDULER == 1)
+
+/* E.C. the priority ready lists are not used by EDF.  The processor is idle
+ * while the idle task is the only job in the EDF ready list, and stays idle
+ * until the next job is released.  Every release that is not triggered by an
+ * interrupt goes through the delayed list (periodic jobs, deferred sporadic
+ * releases, skipped firm jobs), so xNextTaskUnblockTime is the end of the idle
+ * gap.  The job of the idle task has no deadline, and unless the task set is
+ * static it is re-released on every tick, so the ticks stepped over when the
+ * processor wakes change nothing but its release time. */
+static TickType_t prvGetExpectedIdleTime(void)
+{
+    TickType_t xReturn;
+
+    if (pxCurrentTCB != xIdleTaskHandle)
+    {
+        xReturn = 0;
+    }
+    else if (listCURRENT_LIST_LENGTH(&xReadyTasksListEDF) > (UBaseType_t)1)
+    {
+        /* Other jobs are ready: the idle task is running ahead of them on a
+         * slack grant, or they were dropped in HI mode.  Only the next tick
+         * can let them run. */
+        xReturn = 0;
+    }
+    else if (eCriticalityMode == eTaskCriticalityHI)
+    {
+        /* The next tick returns the system to LO criticality mode. */
+        xReturn = 0;
+    }
+    else if (uxSlackWaiting != 0U)
+    {
+        /* Background work is waiting to be run. */
+        xReturn = 0;
+    }
+    else
+    {
+        xReturn = xNextTaskUnblockTime - xTickCount;
+    }
+
+    return xReturn;
+}
+
+#else
+
 static TickType_t prvGetExpectedIdleTime(void)
 {
     TickType_t xReturn;
@@ -2309,9 +5904,113 @@ static TickType_t prvGetExpectedIdleTime(void)
     return xReturn;
 }
 
+#endif /* configUSE_EDF_SCHEDULER */
+
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static BaseType_t prvMergePendingReady(void)
+{
+    List_t xTaken;
+    List_t xBatch;
+    TCB_t *pxTCB;
+    ListItem_t *pxItem;
+    ListItem_t *pxPosition;
+    const ListItem_t *const pxReadyEnd = listGET_END_MARKER(&xReadyTasksListEDF);
+    UBaseType_t uxMerged;
+    BaseType_t xReturn = pdFALSE;
+
+    vListInitialise(&xTaken);
+    vListInitialise(&xBatch);
+
+    /* Interrupts add to xPendingReadyList while the scheduler is suspended,
+     * and look at the state list item to tell whether a task is suspended.
+     * Both items are taken off their lists with interrupts masked, so an
+     * interrupt cannot find a task half moved and ready it a second time.
+     * The state list item goes into xTaken, it keeps its value, which
+     * prvResumeIntoPeriod() needs. */
+    taskENTER_CRITICAL();
+    {
+        while (listLIST_IS_EMPTY(&xPendingReadyList) == pdFALSE)
+        {
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY((&xPendingReadyList)); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            listREMOVE_ITEM(&(pxTCB->xEventListItem));
+            portMEMORY_BARRIER();
+            listREMOVE_ITEM(&(pxTCB->xStateListItem));
+            listINSERT_END(&xTaken, &(pxTCB->xStateListItem));
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    uxMerged = listCURRENT_LIST_LENGTH(&xTaken);
+
+    /* Sort the batch by deadline.  A task is readied at most once, its event
+     * list item can only be in xPendingReadyList once, so the batch holds k <=
+     * uxCurrentNumberOfTasks tasks, usually one or two.  The insertion sort
+     * takes O(k^2) steps, all with interrupts enabled. */
+    while (listLIST_IS_EMPTY(&xTaken) == pdFALSE)
+    {
+        pxTCB = listGET_OWNER_OF_HEAD_ENTRY((&xTaken)); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        listREMOVE_ITEM(&(pxTCB->xStateListItem));
+
+#if (INCLUDE_vTaskSuspend == 1)
+        /* A task resumed from an interrupt may have to go on waiting for its
+         * next period. */
+        if ((pxTCB->ucWaitingForPeriod != (uint8_t)pdFALSE) && (prvResumeIntoPeriod(pxTCB) == pdFALSE))
+        {
+            uxMerged--;
+            continue;
+        }
+#endif
+
+        listSET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem), pxTCB->xTaskDeadline);
+        vListInsert(&xBatch, &(pxTCB->xStateListItem));
+    }
+
+    if (uxMerged > (UBaseType_t)0U)
+    {
+        /* The batch is sorted, so only its head can preempt. */
+        pxTCB = listGET_OWNER_OF_HEAD_ENTRY((&xBatch)); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+        if (taskEDF_PREEMPTS_CURRENT(pxTCB))
+        {
+            xReturn = pdTRUE;
+        }
+
+        /* Merge, walking the ready list once.  A task goes after ready tasks
+         * with the same deadline, as vListInsert() would put it. */
+        pxPosition = listGET_HEAD_ENTRY(&xReadyTasksListEDF);
+
+        while (listLIST_IS_EMPTY(&xBatch) == pdFALSE)
+        {
+            pxItem = listGET_HEAD_ENTRY(&xBatch);
+
+            while ((pxPosition != pxReadyEnd) && (listGET_LIST_ITEM_VALUE(pxPosition) <= listGET_LIST_ITEM_VALUE(pxItem)))
+            {
+                pxPosition = listGET_NEXT(pxPosition);
+            }
+
+            pxTCB = listGET_LIST_ITEM_OWNER(pxItem); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            listREMOVE_ITEM(pxItem);
+            traceMOVED_TASK_TO_READY_STATE(pxTCB);
+            taskEDF_LIST_INSERT_BEFORE(&xReadyTasksListEDF, pxPosition, pxItem);
+            tracePOST_MOVED_TASK_TO_READY_STATE(pxTCB);
+        }
+
+        /* Tasks may have left the delayed list before their timeout. */
+        prvResetNextTaskUnblockTime();
+
+        traceTASK_PENDING_READY_MERGED(uxMerged);
+    }
+
+    return xReturn;
+}
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*----------------------------------------------------------*/
+
 BaseType_t xTaskResumeAll(void)
 {
     TCB_t *pxTCB = NULL;
@@ -2321,6 +6020,16 @@ BaseType_t xTaskResumeAll(void)
      * previous call to vTaskSuspendAll(). */
     configASSERT(uxSchedulerSuspended);
 
+/* E.C. merge the tasks readied while the scheduler was suspended into the EDF
+ * ready list as one batch, before the scheduler is resumed.  Tasks readied by
+ * interrupts after this are moved one by one below. */
+#if (configUSE_EDF_SCHEDULER == 1)
+    if ((uxSchedulerSuspended == (UBaseType_t)1U) && (prvMergePendingReady() != pdFALSE))
+    {
+        xYieldPending = pdTRUE;
+    }
+#endif
+
     /* It is possible that an ISR caused a task to be removed from an event
      * list while the scheduler was suspended.  If this was the case then the
      * removed task will have been added to the xPendingReadyList.  Once the
@@ -2342,11 +6051,24 @@ BaseType_t xTaskResumeAll(void)
                     listREMOVE_ITEM(&(pxTCB->xEventListItem));
                     portMEMORY_BARRIER();
                     listREMOVE_ITEM(&(pxTCB->xStateListItem));
+
+#if (configUSE_EDF_SCHEDULER == 1) && (INCLUDE_vTaskSuspend == 1)
+                    /* E.C. see prvMergePendingReady(). */
+                    if ((pxTCB->ucWaitingForPeriod != (uint8_t)pdFALSE) && (prvResumeIntoPeriod(pxTCB) == pdFALSE))
+                    {
+                        continue;
+                    }
+#endif
+
                     prvAddTaskToReadyList(pxTCB);
 
                     /* If the moved task has a priority higher than or equal to
                      * the current task then a yield must be performed. */
+#if (configUSE_EDF_SCHEDULER == 1)
+                    if (taskEDF_PREEMPTS_CURRENT(pxTCB))
+#else
                     if (pxTCB->uxPriority >= pxCurrentTCB->uxPriority)
+#endif
                     {
                         xYieldPending = pdTRUE;
                     }
@@ -2565,7 +6287,9 @@ static TCB_t *prvSearchForNameWithinSingleList(List_t *pxList,
 
 TaskHandle_t xTaskGetHandle(const char *pcNameToQuery) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 {
+#if (configUSE_EDF_SCHEDULER == 0)
     UBaseType_t uxQueue = configMAX_PRIORITIES;
+#endif
     TCB_t *pxTCB;
 
     /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
@@ -2573,6 +6297,8 @@ TaskHandle_t xTaskGetHandle(const char *pcNameToQuery) /*lint !e971 Unqualified
 
     vTaskSuspendAll();
     {
+/* E.C. under EDF every ready task is in the EDF ready list. */
+#if (configUSE_EDF_SCHEDULER == 0)
         /* Search the ready lists. */
         do
         {
@@ -2585,6 +6311,9 @@ TaskHandle_t xTaskGetHandle(const char *pcNameToQuery) /*lint !e971 Unqualified
                 break;
             }
         } while (uxQueue > (UBaseType_t)tskIDLE_PRIORITY); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+#else
+        pxTCB = prvSearchForNameWithinSingleList(&xReadyTasksListEDF, pcNameToQuery);
+#endif
 
         /* Search the delayed lists. */
         if (pxTCB == NULL)
@@ -2631,7 +6360,10 @@ UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray,
                                  const UBaseType_t uxArraySize,
                                  configRUN_TIME_COUNTER_TYPE *const pulTotalRunTime)
 {
-    UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+    UBaseType_t uxTask = 0;
+#if (configUSE_EDF_SCHEDULER == 0)
+    UBaseType_t uxQueue = configMAX_PRIORITIES;
+#endif
 
     vTaskSuspendAll();
     {
@@ -2639,12 +6371,17 @@ UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray,
         if (uxArraySize >= uxCurrentNumberOfTasks)
         {
             /* Fill in an TaskStatus_t structure with information on each
-             * task in the Ready state. */
+             * task in the Ready state.  E.C. under EDF they are all in the EDF
+             * ready list. */
+#if (configUSE_EDF_SCHEDULER == 0)
             do
             {
                 uxQueue--;
                 uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[uxTask]), &(pxReadyTasksLists[uxQueue]), eReady);
             } while (uxQueue > (UBaseType_t)tskIDLE_PRIORITY); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+#else
+            uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[uxTask]), &xReadyTasksListEDF, eReady);
+#endif
 
             /* Fill in an TaskStatus_t structure with information on each
              * task in the Blocked state. */
@@ -2879,10 +6616,57 @@ BaseType_t xTaskIncrementTick(void)
          * delayed lists if it wraps to 0. */
         xTickCount = xConstTickCount;
 
-/* E.C. update idle task deadline */
 #if (configUSE_EDF_SCHEDULER == 1)
         pxTCB = prvGetTCBFromHandle(xIdleTaskHandle);
-        listSET_LIST_ITEM_VALUE(&((pxTCB)->xStateListItem), (pxTCB)->xTaskPeriod + xTickCount);
+
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
+        /* E.C. re-release the idle task, its job never has a deadline */
+        prvReleaseJob(pxTCB, xTickCount);
+
+        /* E.C. charge the tick to the job that ran through it.  A HI job
+         * that runs past its LO mode WCET switches the system to HI mode; the
+         * first tick the processor idles in HI mode switches it back. */
+        if (pxCurrentTCB != pxTCB)
+        {
+            pxCurrentTCB->xJobExecutionTime++;
+
+            if ((eCriticalityMode == eTaskCriticalityLO) &&
+                (pxCurrentTCB->ucCriticality == (uint8_t)eTaskCriticalityHI) &&
+                (pxCurrentTCB->xJobExecutionTime > pxCurrentTCB->xTaskWCET))
+            {
+                prvSetCriticalityMode(eTaskCriticalityHI);
+                xSwitchRequired = pdTRUE;
+            }
+        }
+        else if (eCriticalityMode == eTaskCriticalityHI)
+        {
+            prvSetCriticalityMode(eTaskCriticalityLO);
+            xSwitchRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+#else
+        /* E.C. charge the tick to the job that ran through it.  A static task
+         * set has no HI tasks to overrun, and the job of the idle task keeps
+         * the deadline it was created with, so it is never re-released. */
+        if (pxCurrentTCB != pxTCB)
+        {
+            pxCurrentTCB->xJobExecutionTime++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+#endif
+
+        /* E.C. background work runs ahead of the jobs while there is slack
+         * for it. */
+        if (prvSlackServerTick(pxTCB) != pdFALSE)
+        {
+            xSwitchRequired = pdTRUE;
+        }
 #endif
 
         if (xConstTickCount == (TickType_t)0U) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
@@ -2939,6 +6723,27 @@ BaseType_t xTaskIncrementTick(void)
                     /* It is time to remove the item from the Blocked state. */
                     listREMOVE_ITEM(&(pxTCB->xStateListItem));
 
+/* E.C. a task that is only waiting for its next period may have the job
+ * skipped, it then goes straight back to the delayed list.  One delayed in
+ * the middle of its job, or blocked with a timeout, is not releasing a job. */
+#if (configUSE_EDF_SCHEDULER == 1)
+                    if ((pxTCB->ucWaitingForPeriod != (uint8_t)pdFALSE) &&
+                        (prvSkipFirmJob(pxTCB, xConstTickCount) != pdFALSE))
+                    {
+                        /* The task moves its own wake time on when it
+                         * next completes a job. */
+                        if (pxTCB->ucSkippedJobs < (uint8_t)0xFFU)
+                        {
+                            pxTCB->ucSkippedJobs++;
+                        }
+
+                        taskEDF_TAKE_NEXT_TIMING(pxTCB);
+                        pxTCB->xTaskReleaseTime = xConstTickCount;
+                        prvAddTaskToDelayedList(pxTCB, xConstTickCount + pxTCB->xTaskPeriod);
+                        continue;
+                    }
+#endif
+
                     /* Is the task waiting on an event also?  If so remove
                      * it from the event list. */
                     if (listLIST_ITEM_CONTAINER(&(pxTCB->xEventListItem)) != NULL)
@@ -2953,10 +6758,18 @@ BaseType_t xTaskIncrementTick(void)
                     /* Place the unblocked task into the appropriate ready
                      * list. */
 
-/* E.C. calculate task new deadline before adding to ready list*/
+/* E.C. only a task waiting for its next period, or for a deferred sporadic
+ * release, starts a new job.  A task woken from vTaskDelay() or a timed out
+ * wait is in the middle of its job and keeps its deadline and the execution
+ * time it has used so far. */
 #if (configUSE_EDF_SCHEDULER == 1)
+                    if (pxTCB->ucWaitingForPeriod != (uint8_t)pdFALSE)
                     {
-                        listSET_LIST_ITEM_VALUE(&((pxTCB)->xStateListItem), (pxTCB)->xTaskPeriod + xTickCount);
+                        prvReleaseJob(pxTCB, xTickCount);
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
 #endif
 
@@ -2966,10 +6779,23 @@ BaseType_t xTaskIncrementTick(void)
  * context switch if preemption is turned off. */
 #if (configUSE_PREEMPTION == 1)
                     {
-/* E.C. Force Context Switch once the deadlines are updated */
+/* E.C. Force Context Switch once the deadlines are updated.  The deadlines
+ * of a static task set only change here, so the switch is only needed if the
+ * new job preempts the running one. */
 #if (configUSE_EDF_SCHEDULER == 1)
                         {
+#if (configUSE_EDF_STATIC_TASK_SET == 0)
                             xSwitchRequired = pdTRUE;
+#else
+                            if (taskEDF_PREEMPTS_CURRENT(pxTCB) != pdFALSE)
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+#endif
                         }
 #else
                         /* Preemption is on, but a context switch should
@@ -2998,7 +6824,7 @@ BaseType_t xTaskIncrementTick(void)
 /* Tasks of equal priority to the currently running task will share
  * processing time (time slice) if preemption is on, and the application
  * writer has not explicitly turned time slicing off. */
-#if ((configUSE_PREEMPTION == 1) && (configUSE_TIME_SLICING == 1))
+#if ((configUSE_PREEMPTION == 1) && (configUSE_TIME_SLICING == 1) && (taskUSE_PRIORITY_READY_LISTS == 1))
         {
             if (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[pxCurrentTCB->uxPriority])) > (UBaseType_t)1)
             {
@@ -3009,7 +6835,7 @@ BaseType_t xTaskIncrementTick(void)
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( taskUSE_PRIORITY_READY_LISTS == 1 ) ) */
 
 #if (configUSE_TICK_HOOK == 1)
         {
@@ -3170,6 +6996,11 @@ BaseType_t xTaskCallApplicationTaskHook(TaskHandle_t xTask,
 
 void vTaskSwitchContext(void)
 {
+#if (configUSE_SWITCH_PROFILER == 1)
+    uint32_t ulProfileMarks[eTaskSwitchTotal + 1];
+    UBaseType_t uxPhase;
+#endif
+
     if (uxSchedulerSuspended != (UBaseType_t)pdFALSE)
     {
         /* The scheduler is currently suspended - do not allow a context
@@ -3178,9 +7009,13 @@ void vTaskSwitchContext(void)
     }
     else
     {
+        taskPROFILE_MARK(eTaskSwitchRunTime);
+
         xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
 
+        /* E.C. the run time counter is read before traceTASK_SWITCHED_OUT(),
+         * so both trace hooks can use ulTotalRunTime and a switch reads the
+         * counter once. */
 #if (configGENERATE_RUN_TIME_STATS == 1)
         {
 #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
@@ -3193,9 +7028,12 @@ void vTaskSwitchContext(void)
              * accumulated time so far.  The time the task started running was
              * stored in ulTaskSwitchedInTime.  Note that there is no overflow
              * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
+             * overflows.  E.C. configRUN_TIME_COUNTER_TYPE can be made 64 bits
+             * wide, with a 32-bit hardware timer extended by the application,
+             * so that it never does in practice.  The guard against negative
+             * values is to protect against suspect run time stat counter
+             * implementations - which are provided by the application, not the
+             * kernel. */
             if (ulTotalRunTime > ulTaskSwitchedInTime)
             {
                 pxCurrentTCB->ulRunTimeCounter += (ulTotalRunTime - ulTaskSwitchedInTime);
@@ -3209,9 +7047,17 @@ void vTaskSwitchContext(void)
         }
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+        taskPROFILE_MARK(eTaskSwitchTraceOut);
+
+        traceTASK_SWITCHED_OUT();
+
+        taskPROFILE_MARK(eTaskSwitchStackCheck);
+
         /* Check for stack overflow, if configured. */
         taskCHECK_FOR_STACK_OVERFLOW();
 
+        taskPROFILE_MARK(eTaskSwitchSelect);
+
 /* Before the currently running task is switched out, save its errno. */
 #if (configUSE_POSIX_ERRNO == 1)
         {
@@ -3229,11 +7075,48 @@ void vTaskSwitchContext(void)
 #else
         {
             pxCurrentTCB = (TCB_t *)listGET_OWNER_OF_HEAD_ENTRY(&(xReadyTasksListEDF));
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+            {
+                /* E.C. first time in since the job was released by an
+                 * event. */
+                if (pxCurrentTCB->ucReleaseLatencyPending != (uint8_t)pdFALSE)
+                {
+                    pxCurrentTCB->ucReleaseLatencyPending = (uint8_t)pdFALSE;
+                    pxCurrentTCB->ulLastReleaseLatency = ulTotalRunTime - pxCurrentTCB->ulReleaseRunTime;
+
+                    if (pxCurrentTCB->ulLastReleaseLatency > pxCurrentTCB->ulMaxReleaseLatency)
+                    {
+                        pxCurrentTCB->ulMaxReleaseLatency = pxCurrentTCB->ulLastReleaseLatency;
+                    }
+                }
+            }
+#endif
+
+            taskEDF_RECORD_JOB_START(pxCurrentTCB);
         }
 #endif
 
+        taskPROFILE_MARK(eTaskSwitchTraceIn);
+
         traceTASK_SWITCHED_IN();
 
+        taskPROFILE_MARK(eTaskSwitchTotal);
+
+#if (configUSE_SWITCH_PROFILER == 1)
+        {
+            /* E.C. the samples are recorded once the switch is timed so the
+             * recording is not counted in any phase. */
+            for (uxPhase = (UBaseType_t)eTaskSwitchRunTime; uxPhase < (UBaseType_t)eTaskSwitchTotal; uxPhase++)
+            {
+                prvRecordSwitchCycles((eTaskSwitchPhase)uxPhase, prvProfileElapsed(ulProfileMarks[uxPhase], ulProfileMarks[uxPhase + 1U]));
+            }
+
+            ulLastSwitchCycles = prvProfileElapsed(ulProfileMarks[eTaskSwitchRunTime], ulProfileMarks[eTaskSwitchTotal]);
+            prvRecordSwitchCycles(eTaskSwitchTotal, ulLastSwitchCycles);
+        }
+#endif
+
 /* After the new task is switched in, update the global errno. */
 #if (configUSE_POSIX_ERRNO == 1)
         {
@@ -3252,6 +7135,95 @@ void vTaskSwitchContext(void)
 }
 /*-----------------------------------------------------------*/
 
+#if (configUSE_SWITCH_PROFILER == 1)
+
+static uint32_t prvProfileElapsed(uint32_t ulStart,
+                                  uint32_t ulEnd)
+{
+    uint32_t ulElapsed = ulEnd - ulStart;
+
+    if (ulEnd < ulStart)
+    {
+        /* The counter was reset in between.  Wrapping round 32 bits has
+         * already been allowed for by the subtraction. */
+        ulElapsed += (uint32_t)configPROFILER_COUNTER_PERIOD;
+    }
+
+    return ulElapsed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSwitchCycles(eTaskSwitchPhase ePhase,
+                                  uint32_t ulCycles)
+{
+    TaskSwitchProfile_t *const pxProfile = &(xSwitchProfile[ePhase]);
+    UBaseType_t uxBucket = 0U;
+    uint32_t ulScaled = ulCycles >> 1;
+
+    while ((ulScaled != 0UL) && (uxBucket < ((UBaseType_t)configSWITCH_PROFILE_BUCKETS - (UBaseType_t)1U)))
+    {
+        ulScaled >>= 1;
+        uxBucket++;
+    }
+
+    pxProfile->ulBuckets[uxBucket]++;
+
+    if ((pxProfile->ulSamples == 0UL) || (ulCycles < pxProfile->ulMinCycles))
+    {
+        pxProfile->ulMinCycles = ulCycles;
+    }
+
+    if (ulCycles > pxProfile->ulMaxCycles)
+    {
+        pxProfile->ulMaxCycles = ulCycles;
+    }
+
+    pxProfile->ulSamples++;
+    pxProfile->ullTotalCycles += (uint64_t)ulCycles;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetSwitchProfile(eTaskSwitchPhase ePhase,
+                           TaskSwitchProfile_t *const pxProfile)
+{
+    configASSERT(pxProfile);
+    configASSERT(ePhase <= eTaskSwitchPort);
+
+    taskENTER_CRITICAL();
+    {
+        *pxProfile = xSwitchProfile[ePhase];
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskResetSwitchProfile(void)
+{
+    taskENTER_CRITICAL();
+    {
+        (void)memset((void *)xSwitchProfile, 0x00, sizeof(xSwitchProfile));
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskProfilePortSample(uint32_t ulCycles)
+{
+    /* Only the saving and restoring is left once the time spent choosing the
+     * next task is taken off. */
+    if (ulCycles > ulLastSwitchCycles)
+    {
+        prvRecordSwitchCycles(eTaskSwitchPort, ulCycles - ulLastSwitchCycles);
+    }
+    else
+    {
+        prvRecordSwitchCycles(eTaskSwitchPort, 0UL);
+    }
+}
+
+#endif /* configUSE_SWITCH_PROFILER */
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnEventList(List_t *const pxEventList,
                            const TickType_t xTicksToWait)
 {
@@ -3271,6 +7243,16 @@ void vTaskPlaceOnEventList(List_t *const pxEventList,
      *
      * The queue that contains the event list is locked, preventing
      * simultaneous access from interrupts. */
+#if (configUSE_EDF_SCHEDULER == 1)
+    {
+        /* E.C. all EDF tasks share the same priority, so order the event list
+         * by the absolute deadline of the waiting job instead.  The most
+         * urgent waiter is then the first to be woken.  Priority changes
+         * leave the value alone, see
+         * taskEVENT_LIST_ITEM_VALUE_HOLDS_PRIORITY(). */
+        listSET_LIST_ITEM_VALUE(&(pxCurrentTCB->xEventListItem), pxCurrentTCB->xTaskDeadline);
+    }
+#endif
     vListInsert(pxEventList, &(pxCurrentTCB->xEventListItem));
 
     prvAddCurrentTaskToDelayedList(xTicksToWait, pdTRUE);
@@ -3320,6 +7302,14 @@ void vTaskPlaceOnEventListRestricted(List_t *const pxEventList,
      * In this case it is assume that this is the only task that is going to
      * be waiting on this event list, so the faster vListInsertEnd() function
      * can be used in place of vListInsert. */
+#if (configUSE_EDF_SCHEDULER == 1)
+    {
+        /* E.C. keyed on the deadline of the job all the same, as by
+         * vTaskPlaceOnEventList(), so the value never holds a priority and
+         * stays in order if another task is placed on the list after it. */
+        listSET_LIST_ITEM_VALUE(&(pxCurrentTCB->xEventListItem), pxCurrentTCB->xTaskDeadline);
+    }
+#endif
     listINSERT_END(pxEventList, &(pxCurrentTCB->xEventListItem));
 
     /* If the task should block indefinitely then set the block time to a
@@ -3345,8 +7335,9 @@ BaseType_t xTaskRemoveFromEventList(const List_t *const pxEventList)
     /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
      * called from a critical section within an ISR. */
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
+    /* The event list is sorted in priority order (E.C. deadline order under
+     * EDF), so the first in the list can be removed as it is known to be the
+     * highest priority.  Remove the TCB from
      * the delayed list, and add it to the ready list.
      *
      * If an event is for a queue that is locked then this function will never
@@ -3385,11 +7376,16 @@ BaseType_t xTaskRemoveFromEventList(const List_t *const pxEventList)
         listINSERT_END(&(xPendingReadyList), &(pxUnblockedTCB->xEventListItem));
     }
 
+#if (configUSE_EDF_SCHEDULER == 1)
+    if (taskEDF_PREEMPTS_CURRENT(pxUnblockedTCB))
+#else
     if (pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority)
+#endif
     {
         /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
+         * priority (E.C. or an earlier deadline) than the calling task.  This
+         * allows the calling task to know if it should force a context switch
+         * now. */
         xReturn = pdTRUE;
 
         /* Mark that a yield is pending in case the user is not using the
@@ -3443,7 +7439,11 @@ void vTaskRemoveFromUnorderedEventList(ListItem_t *pxEventListItem,
     listREMOVE_ITEM(&(pxUnblockedTCB->xStateListItem));
     prvAddTaskToReadyList(pxUnblockedTCB);
 
+#if (configUSE_EDF_SCHEDULER == 1)
+    if (taskEDF_PREEMPTS_CURRENT(pxUnblockedTCB))
+#else
     if (pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority)
+#endif
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -3624,7 +7624,7 @@ static portTASK_FUNCTION(prvIdleTask, pvParameters)
         }
 #endif /* configUSE_PREEMPTION */
 
-#if ((configUSE_PREEMPTION == 1) && (configIDLE_SHOULD_YIELD == 1))
+#if ((configUSE_PREEMPTION == 1) && (configIDLE_SHOULD_YIELD == 1) && (taskUSE_PRIORITY_READY_LISTS == 1))
         {
             /* When using preemption tasks of equal priority will be
              * timesliced.  If a task that is sharing the idle priority is ready
@@ -3644,7 +7644,14 @@ static portTASK_FUNCTION(prvIdleTask, pvParameters)
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) && ( taskUSE_PRIORITY_READY_LISTS == 1 ) ) */
+
+#if (configUSE_EDF_SCHEDULER == 1)
+        {
+            /* E.C. run the work queued with xTaskRunInSlack(). */
+            prvRunSlackWork();
+        }
+#endif
 
 #if (configUSE_IDLE_HOOK == 1)
         {
@@ -3827,18 +7834,23 @@ void vTaskAllocateMPURegions(TaskHandle_t xTaskToModify,
 
 static void prvInitialiseTaskLists(void)
 {
+#if (taskUSE_PRIORITY_READY_LISTS == 1)
     UBaseType_t uxPriority;
+#endif
 /*E.C. initialises the new made EDF ready list*/
 #if (configUSE_EDF_SCHEDULER == 1)
 
     vListInitialise(&(xReadyTasksListEDF)); /* Initialise the EDF ready list */
+    vListInitialise(&(xElasticTaskList));
 
 #endif
 
+#if (taskUSE_PRIORITY_READY_LISTS == 1)
     for (uxPriority = (UBaseType_t)0U; uxPriority < (UBaseType_t)configMAX_PRIORITIES; uxPriority++)
     {
         vListInitialise(&(pxReadyTasksLists[uxPriority]));
     }
+#endif
 
     vListInitialise(&xDelayedTaskList1);
     vListInitialise(&xDelayedTaskList2);
@@ -4138,8 +8150,8 @@ static void prvDeleteTCB(TCB_t *pxTCB)
     {
         /* The task can only have been allocated dynamically - free both
          * the stack and TCB. */
-        vPortFreeStack(pxTCB->pxStack);
-        vPortFree(pxTCB);
+        prvFreeStack(pxTCB->pxStack);
+        prvFreeTCB(pxTCB);
     }
 #elif (tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
     {
@@ -4150,14 +8162,14 @@ static void prvDeleteTCB(TCB_t *pxTCB)
         {
             /* Both the stack and TCB were allocated dynamically, so both
              * must be freed. */
-            vPortFreeStack(pxTCB->pxStack);
-            vPortFree(pxTCB);
+            prvFreeStack(pxTCB->pxStack);
+            prvFreeTCB(pxTCB);
         }
         else if (pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY)
         {
             /* Only the stack was statically allocated, so the TCB is the
              * only memory that must be freed. */
-            vPortFree(pxTCB);
+            prvFreeTCB(pxTCB);
         }
         else
         {
@@ -4173,6 +8185,163 @@ static void prvDeleteTCB(TCB_t *pxTCB)
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if (configUSE_TASK_SLAB_ALLOCATOR == 1)
+
+static void *prvSlabTake(TaskSlab_t *pxSlab)
+{
+    void *pvBlock;
+
+    taskENTER_CRITICAL();
+    {
+        if (pxSlab->pvFreeList != NULL)
+        {
+            pvBlock = pxSlab->pvFreeList;
+            pxSlab->pvFreeList = *((void **)pvBlock);
+        }
+        else if (pxSlab->uxNextUnused < pxSlab->uxBlocks)
+        {
+            pvBlock = (void *)&(pxSlab->pucStorage[pxSlab->uxNextUnused * pxSlab->xBlockSize]);
+            pxSlab->uxNextUnused++;
+        }
+        else
+        {
+            /* E.C. the slab is exhausted, the caller falls back to the
+             * heap. */
+            pvBlock = NULL;
+            pxSlab->ulHeapFallbacks++;
+        }
+
+        if (pvBlock != NULL)
+        {
+            pxSlab->uxInUse++;
+
+            if (pxSlab->uxInUse > pxSlab->uxMaxInUse)
+            {
+                pxSlab->uxMaxInUse = pxSlab->uxInUse;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSlabGive(TaskSlab_t *pxSlab,
+                              void *pvBlock)
+{
+    BaseType_t xReturn = pdFALSE;
+
+    /* E.C. only blocks that lie inside the slab's storage belong to it,
+     * anything else came from the heap.  An empty slab has no storage. */
+    if ((pxSlab->uxBlocks > 0U) &&
+        ((uint8_t *)pvBlock >= pxSlab->pucStorage) &&
+        ((uint8_t *)pvBlock < &(pxSlab->pucStorage[pxSlab->uxBlocks * pxSlab->xBlockSize])))
+    {
+        taskENTER_CRITICAL();
+        {
+            *((void **)pvBlock) = pxSlab->pvFreeList;
+            pxSlab->pvFreeList = pvBlock;
+            pxSlab->uxInUse--;
+        }
+        taskEXIT_CRITICAL();
+
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static TCB_t *prvAllocateTCB(void)
+{
+    TCB_t *pxTCB = (TCB_t *)prvSlabTake(&(xTaskSlabs[eTaskSlabTCB]));
+
+    if (pxTCB == NULL)
+    {
+        pxTCB = (TCB_t *)pvPortMalloc(sizeof(TCB_t));
+    }
+
+    return pxTCB;
+}
+/*-----------------------------------------------------------*/
+
+static StackType_t *prvAllocateStack(configSTACK_DEPTH_TYPE usStackDepth)
+{
+    StackType_t *pxStack = NULL;
+
+    /* E.C. use the smallest stack block the task fits in.  A task may get a
+     * larger block than it asked for, the rest of the block is never used. */
+    if (usStackDepth <= (configSTACK_DEPTH_TYPE)configTASK_SLAB_SMALL_STACK_DEPTH)
+    {
+        pxStack = (StackType_t *)prvSlabTake(&(xTaskSlabs[eTaskSlabSmallStack]));
+    }
+    else if (usStackDepth <= (configSTACK_DEPTH_TYPE)configTASK_SLAB_LARGE_STACK_DEPTH)
+    {
+        pxStack = (StackType_t *)prvSlabTake(&(xTaskSlabs[eTaskSlabLargeStack]));
+    }
+    else
+    {
+        /* E.C. no slab has blocks this large. */
+        taskENTER_CRITICAL();
+        {
+            xTaskSlabs[eTaskSlabLargeStack].ulHeapFallbacks++;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (pxStack == NULL)
+    {
+        pxStack = (StackType_t *)pvPortMallocStack((((size_t)usStackDepth) * sizeof(StackType_t)));
+    }
+
+    return pxStack;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeTCB(TCB_t *pxTCB)
+{
+    if (prvSlabGive(&(xTaskSlabs[eTaskSlabTCB]), (void *)pxTCB) == pdFALSE)
+    {
+        vPortFree(pxTCB);
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeStack(StackType_t *pxStack)
+{
+    if ((prvSlabGive(&(xTaskSlabs[eTaskSlabSmallStack]), (void *)pxStack) == pdFALSE) &&
+        (prvSlabGive(&(xTaskSlabs[eTaskSlabLargeStack]), (void *)pxStack) == pdFALSE))
+    {
+        vPortFreeStack(pxStack);
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskGetSlabStats(eTaskSlab eSlab,
+                       TaskSlabStats_t *pxSlabStats)
+{
+    TaskSlab_t *pxSlab;
+
+    configASSERT(eSlab <= eTaskSlabLargeStack);
+    configASSERT(pxSlabStats);
+
+    pxSlab = &(xTaskSlabs[eSlab]);
+
+    taskENTER_CRITICAL();
+    {
+        pxSlabStats->uxBlocks = pxSlab->uxBlocks;
+        pxSlabStats->xBlockSize = pxSlab->xBlockSize;
+        pxSlabStats->uxInUse = pxSlab->uxInUse;
+        pxSlabStats->uxMaxInUse = pxSlab->uxMaxInUse;
+        pxSlabStats->ulHeapFallbacks = pxSlab->ulHeapFallbacks;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* configUSE_TASK_SLAB_ALLOCATOR */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime(void)
 {
     if (listLIST_IS_EMPTY(pxDelayedTaskList) != pdFALSE)
@@ -4259,7 +8428,7 @@ BaseType_t xTaskPriorityInherit(TaskHandle_t const pxMutexHolder)
             /* Adjust the mutex holder state to account for its new
              * priority.  Only reset the event list item value if the value is
              * not being used for anything else. */
-            if ((listGET_LIST_ITEM_VALUE(&(pxMutexHolderTCB->xEventListItem)) & taskEVENT_LIST_ITEM_VALUE_IN_USE) == 0UL)
+            if (taskEVENT_LIST_ITEM_VALUE_HOLDS_PRIORITY(pxMutexHolderTCB) != pdFALSE)
             {
                 listSET_LIST_ITEM_VALUE(&(pxMutexHolderTCB->xEventListItem), (TickType_t)configMAX_PRIORITIES - (TickType_t)pxCurrentTCB->uxPriority); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
             }
@@ -4270,7 +8439,7 @@ BaseType_t xTaskPriorityInherit(TaskHandle_t const pxMutexHolder)
 
             /* If the task being modified is in the ready state it will need
              * to be moved into a new list. */
-            if (listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[pxMutexHolderTCB->uxPriority]), &(pxMutexHolderTCB->xStateListItem)) != pdFALSE)
+            if (taskIS_IN_PRIORITY_READY_LIST(pxMutexHolderTCB->uxPriority, pxMutexHolderTCB) != pdFALSE)
             {
                 if (uxListRemove(&(pxMutexHolderTCB->xStateListItem)) == (UBaseType_t)0)
                 {
@@ -4374,8 +8543,11 @@ BaseType_t xTaskPriorityDisinherit(TaskHandle_t const pxMutexHolder)
 
                 /* Reset the event list item value.  It cannot be in use for
                  * any other purpose if this task is running, and it must be
-                 * running to give back the mutex. */
+                 * running to give back the mutex.  E.C. under EDF it never
+                 * holds the priority. */
+#if (configUSE_EDF_SCHEDULER == 0)
                 listSET_LIST_ITEM_VALUE(&(pxTCB->xEventListItem), (TickType_t)configMAX_PRIORITIES - (TickType_t)pxTCB->uxPriority); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+#endif
                 prvAddTaskToReadyList(pxTCB);
 
                 /* Return true to indicate that a context switch is required.
@@ -4460,7 +8632,7 @@ void vTaskPriorityDisinheritAfterTimeout(TaskHandle_t const pxMutexHolder,
 
                 /* Only reset the event list item value if the value is not
                  * being used for anything else. */
-                if ((listGET_LIST_ITEM_VALUE(&(pxTCB->xEventListItem)) & taskEVENT_LIST_ITEM_VALUE_IN_USE) == 0UL)
+                if (taskEVENT_LIST_ITEM_VALUE_HOLDS_PRIORITY(pxTCB) != pdFALSE)
                 {
                     listSET_LIST_ITEM_VALUE(&(pxTCB->xEventListItem), (TickType_t)configMAX_PRIORITIES - (TickType_t)uxPriorityToUse); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
@@ -4475,7 +8647,7 @@ void vTaskPriorityDisinheritAfterTimeout(TaskHandle_t const pxMutexHolder,
                  * from its current state list if it is in the Ready state as
                  * the task's priority is going to change and there is one
                  * Ready list per priority. */
-                if (listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[uxPriorityUsedOnEntry]), &(pxTCB->xStateListItem)) != pdFALSE)
+                if (taskIS_IN_PRIORITY_READY_LIST(uxPriorityUsedOnEntry, pxTCB) != pdFALSE)
                 {
                     if (uxListRemove(&(pxTCB->xStateListItem)) == (UBaseType_t)0)
                     {
@@ -4831,6 +9003,249 @@ void vTaskGetRunTimeStats(char *pcWriteBuffer)
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
 /*-----------------------------------------------------------*/
 
+#if (configUSE_EDF_SCHEDULER == 1) && (((configUSE_TRACE_FACILITY == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0)) || (configUSE_JOB_HISTOGRAMS == 1) || (configJOB_TRACE_LENGTH > 0))
+
+static char *prvAppendText(char *pcBuffer,
+                           const char *const pcEnd,
+                           const char *pcText)
+{
+    while ((pcBuffer < pcEnd) && (*pcText != (char)0x00))
+    {
+        *pcBuffer = *pcText;
+        pcBuffer++;
+        pcText++;
+    }
+
+    return pcBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static char *prvAppendNumber(char *pcBuffer,
+                             const char *const pcEnd,
+                             configRUN_TIME_COUNTER_TYPE ulValue)
+{
+    char cDigits[20]; /* Enough for a 64-bit value. */
+    UBaseType_t uxDigits = 0U;
+
+    pcBuffer = prvAppendText(pcBuffer, pcEnd, "\t");
+
+    do
+    {
+        cDigits[uxDigits] = (char)('0' + (char)(ulValue % 10U));
+        uxDigits++;
+        ulValue /= 10U;
+    } while (ulValue != 0U);
+
+    while ((uxDigits > 0U) && (pcBuffer < pcEnd))
+    {
+        uxDigits--;
+        *pcBuffer = cDigits[uxDigits];
+        pcBuffer++;
+    }
+
+    return pcBuffer;
+}
+
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) || ( configUSE_JOB_HISTOGRAMS == 1 ) || ( configJOB_TRACE_LENGTH > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_SCHEDULER == 1) && (configUSE_TRACE_FACILITY == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0)
+
+void vTaskStatsIteratorInit(TaskStatsIterator_t *const pxIterator)
+{
+    configASSERT(pxIterator);
+
+    pxIterator->uxLastTaskNumber = 0U;
+    pxIterator->xHeaderWritten = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xTaskStatsIteratorNext(TaskStatsIterator_t *const pxIterator,
+                              char *const pcBuffer,
+                              size_t xBufferLength)
+{
+    const TCB_t *pxTCB;
+    const TCB_t *pxNextTCB = NULL;
+    const ListItem_t *pxItem = NULL;
+    UBaseType_t uxList = 0U;
+    char cName[configMAX_TASK_NAME_LEN];
+    eTaskState eState = eInvalid;
+    char cStatus;
+    TickType_t xPeriod = 0U;
+    TickType_t xDeadline = 0U;
+    TaskJobStats_t xJobStats;
+    char *pcWrite = pcBuffer;
+    const char *pcEnd;
+    size_t x;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    configRUN_TIME_COUNTER_TYPE ulRunTime = 0U;
+    configRUN_TIME_COUNTER_TYPE ulTotalTime;
+#endif
+
+    configASSERT(pxIterator);
+    configASSERT(pcBuffer);
+    configASSERT(xBufferLength > (size_t)0U);
+
+    /* Leave room for the terminating null. */
+    pcEnd = &(pcBuffer[xBufferLength - (size_t)1U]);
+
+    if (pxIterator->xHeaderWritten == pdFALSE)
+    {
+        pxIterator->xHeaderWritten = pdTRUE;
+        pcWrite = prvAppendText(pcWrite, pcEnd, "Task");
+
+        for (x = (size_t)4U; (x < (size_t)(configMAX_TASK_NAME_LEN - 1)) && (pcWrite < pcEnd); x++)
+        {
+            *pcWrite = ' ';
+            pcWrite++;
+        }
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+        pcWrite = prvAppendText(pcWrite, pcEnd, "\tS\tPeriod\tDeadline\tMisses\tLate\tMaxLate\tRunTime\t%\r\n");
+#else
+        pcWrite = prvAppendText(pcWrite, pcEnd, "\tS\tPeriod\tDeadline\tMisses\tLate\tMaxLate\r\n");
+#endif
+    }
+    else
+    {
+        /* Find the task created next after the last one listed, copying
+         * what is needed so it can be formatted with the scheduler
+         * running. */
+        vTaskSuspendAll();
+        {
+            for (pxTCB = prvNextEDFTask(&uxList, &pxItem); pxTCB != NULL; pxTCB = prvNextEDFTask(&uxList, &pxItem))
+            {
+                if ((pxTCB->uxTCBNumber > pxIterator->uxLastTaskNumber) &&
+                    ((pxNextTCB == NULL) || (pxTCB->uxTCBNumber < pxNextTCB->uxTCBNumber)))
+                {
+                    pxNextTCB = pxTCB;
+                }
+            }
+
+            if (pxNextTCB != NULL)
+            {
+                pxIterator->uxLastTaskNumber = pxNextTCB->uxTCBNumber;
+
+                for (x = (size_t)0U; x < (size_t)configMAX_TASK_NAME_LEN; x++)
+                {
+                    cName[x] = pxNextTCB->pcTaskName[x];
+                }
+
+                cName[configMAX_TASK_NAME_LEN - 1] = (char)0x00;
+                eState = eTaskGetState((TaskHandle_t)pxNextTCB);
+                xPeriod = pxNextTCB->xTaskPeriod;
+                xDeadline = pxNextTCB->xTaskDeadline;
+                xJobStats = pxNextTCB->xJobStats;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+                ulRunTime = pxNextTCB->ulRunTimeCounter;
+#endif
+            }
+        }
+        (void)xTaskResumeAll();
+
+        if (pxNextTCB != NULL)
+        {
+            switch (eState)
+            {
+            case eRunning:
+                cStatus = tskRUNNING_CHAR;
+                break;
+
+            case eReady:
+                cStatus = tskREADY_CHAR;
+                break;
+
+            case eBlocked:
+                cStatus = tskBLOCKED_CHAR;
+                break;
+
+            case eSuspended:
+                cStatus = tskSUSPENDED_CHAR;
+                break;
+
+            case eDeleted:
+                cStatus = tskDELETED_CHAR;
+                break;
+
+            case eInvalid: /* Fall through. */
+            default:
+                cStatus = '?';
+                break;
+            }
+
+            /* Pad the name as prvWriteNameToBuffer() does so the columns
+             * line up. */
+            pcWrite = prvAppendText(pcWrite, pcEnd, cName);
+
+            for (x = strlen(cName); (x < (size_t)(configMAX_TASK_NAME_LEN - 1)) && (pcWrite < pcEnd); x++)
+            {
+                *pcWrite = ' ';
+                pcWrite++;
+            }
+
+            pcWrite = prvAppendText(pcWrite, pcEnd, "\t");
+
+            if (pcWrite < pcEnd)
+            {
+                *pcWrite = cStatus;
+                pcWrite++;
+            }
+
+            pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xPeriod);
+
+            if (xDeadline >= taskEDF_IDLE_DEADLINE)
+            {
+                pcWrite = prvAppendText(pcWrite, pcEnd, "\t-");
+            }
+            else
+            {
+                pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xDeadline);
+            }
+
+            pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xJobStats.ulDeadlineMisses);
+            pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xJobStats.xLastLateness);
+            pcWrite = prvAppendNumber(pcWrite, pcEnd, (configRUN_TIME_COUNTER_TYPE)xJobStats.xMaxLateness);
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+            {
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE(ulTotalTime);
+#else
+                ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+#endif
+
+                /* For percentage calculations, rounded down as
+                 * vTaskGetRunTimeStats() does. */
+                ulTotalTime /= 100U;
+
+                pcWrite = prvAppendNumber(pcWrite, pcEnd, ulRunTime);
+
+                if (ulTotalTime > 0U)
+                {
+                    pcWrite = prvAppendNumber(pcWrite, pcEnd, ulRunTime / ulTotalTime);
+                    pcWrite = prvAppendText(pcWrite, pcEnd, "%");
+                }
+                else
+                {
+                    pcWrite = prvAppendText(pcWrite, pcEnd, "\t-");
+                }
+            }
+#endif
+
+            pcWrite = prvAppendText(pcWrite, pcEnd, "\r\n");
+        }
+    }
+
+    *pcWrite = (char)0x00;
+
+    return (size_t)(pcWrite - pcBuffer);
+}
+
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue(void)
 {
     TickType_t uxReturn;
@@ -5449,7 +9864,13 @@ configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent(void)
 {
     configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
 
+/* E.C. read the counter the same way as vTaskSwitchContext() so the idle run
+ * time and the total are on the same, possibly extended, time base. */
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+    portALT_GET_RUN_TIME_COUNTER_VALUE(ulTotalTime);
+#else
     ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+#endif
 
     /* For percentage calculations. */
     ulTotalTime /= (configRUN_TIME_COUNTER_TYPE)100;
@@ -5581,6 +10002,41 @@ static void prvAddCurrentTaskToDelayedList(TickType_t xTicksToWait,
     }
 #endif /* INCLUDE_vTaskSuspend */
 }
+/*-----------------------------------------------------------*/
+
+#if (configUSE_EDF_SCHEDULER == 1)
+
+static void prvAddTaskToDelayedList(TCB_t *pxTCB,
+                                    const TickType_t xTimeToWake)
+{
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, with the task not
+     * referenced from any other state list. */
+
+    /* The list item will be inserted in wake time order. */
+    listSET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem), xTimeToWake);
+
+    if (xTimeToWake < xTickCount)
+    {
+        /* Wake time has overflowed.  Place this item in the overflow list. */
+        vListInsert(pxOverflowDelayedTaskList, &(pxTCB->xStateListItem));
+    }
+    else
+    {
+        /* The wake time has not overflowed, so the current block list is used. */
+        vListInsert(pxDelayedTaskList, &(pxTCB->xStateListItem));
+
+        if (xTimeToWake < xNextTaskUnblockTime)
+        {
+            xNextTaskUnblockTime = xTimeToWake;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+
+#endif /* configUSE_EDF_SCHEDULER */
 
 /* Code below here allows additional code to be inserted into this source file,
  * especially where access to file scope functions and data is needed (for example
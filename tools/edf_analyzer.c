@@ -0,0 +1,559 @@
+/*
+ * Offline EDF schedulability analyzer for job traces recorded on the target.
+ *
+ * Set JOB_TRACE_OUTPUT to 1 in FreeRTOSConfig.h and capture the UART output to a file.
+ * Each completed job is sent as a line written by xTaskJobTraceFormat():
+ *
+ *     J <name> <period> <relative deadline> <release> <response> <execution>
+ *
+ * tab separated, periods and times in ticks except the execution time, which
+ * is in run time counter counts.  Other lines in the capture are skipped.
+ *
+ * For each task the largest execution time seen, plus an optional margin, is
+ * taken as its WCET.  The task set is then checked with the EDF processor
+ * demand criterion: the demand bound function
+ *
+ *     dbf(t) = sum over tasks of max(0, floor((t - D) / T) + 1) * C
+ *
+ * must not exceed t at any absolute deadline t up to the end of the longest
+ * synchronous busy period.  The report gives the utilisation, how much every
+ * WCET could grow by before a deadline can be missed, the interval where that
+ * limit is reached, and the shortest period each task could run at with the
+ * others unchanged.
+ *
+ * Build on the host, it is not part of the firmware:
+ *
+ *     cc -std=c99 -O2 -o edf_analyzer tools/edf_analyzer.c
+ *
+ * Usage:
+ *
+ *     edf_analyzer [-r counts_per_tick] [-m margin_percent] [trace_file]
+ *
+ * -r is the number of run time counter counts per tick, 60 on the LPC2129
+ * with timer 1 at 60 kHz and a 1 kHz tick (the default is 1, for traces that
+ * record execution times in ticks).  -m adds a safety margin to every
+ * observed WCET.  The trace is read from stdin if no file is given.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define analyzerMAX_TASKS      32
+#define analyzerMAX_NAME_LEN   32
+#define analyzerMAX_LINE_LEN   256
+
+/* Checkpoints are only examined up to this many ticks, which bounds the run
+ * time when the utilisation is very close to 1. */
+#define analyzerMAX_INTERVAL   10000000.0
+
+typedef struct xANALYZER_TASK
+{
+    char cName[analyzerMAX_NAME_LEN];
+    unsigned long ulPeriod;           /* Ticks, from the latest job. */
+    unsigned long ulDeadline;         /* Ticks relative to a release, from the latest job. */
+    unsigned long ulJobs;             /* Jobs in the trace. */
+    unsigned long ulMaxExecution;     /* Counts. */
+    double dTotalExecution;           /* Counts, for the average. */
+    unsigned long ulMaxResponse;      /* Ticks. */
+    double dWCET;                     /* Ticks, with the margin, used by the analysis. */
+} AnalyzerTask_t;
+
+/* Result of checking a task set with the demand criterion. */
+typedef struct xANALYZER_RESULT
+{
+    double dUtilisation;
+    double dScale;                    /* Largest factor every WCET can be multiplied by. */
+    double dCriticalInterval;         /* Where dScale is reached, 0 if by the utilisation. */
+    double dCriticalDemand;           /* dbf() at dCriticalInterval. */
+    int iTruncated;                   /* Non-zero if checkpoints were cut off at analyzerMAX_INTERVAL. */
+} AnalyzerResult_t;
+
+static AnalyzerTask_t xTasks[analyzerMAX_TASKS];
+static int iNumberOfTasks = 0;
+
+/*
+ * Parse one line of the trace into the task table.  Returns 0 if the line is
+ * not a job record.
+ */
+static int prvParseLine(char *pcLine);
+
+/*
+ * Demand of the task set in an interval of dInterval ticks starting at a
+ * synchronous release.
+ */
+static double prvDemand(const AnalyzerTask_t *pxTaskSet,
+                        int iTasks,
+                        double dInterval);
+
+/*
+ * Update the smallest t / dbf(t) in *pxResult with every absolute deadline t
+ * in (dFrom, dTo].
+ */
+static void prvCheckDeadlines(const AnalyzerTask_t *pxTaskSet,
+                              int iTasks,
+                              double dFrom,
+                              double dTo,
+                              AnalyzerResult_t *pxResult);
+
+/*
+ * Check the task set, filling *pxResult.  The utilisation must not be 0.
+ * Returns non-zero if it is schedulable, that is if dScale is at least 1.
+ */
+static int prvAnalyze(const AnalyzerTask_t *pxTaskSet,
+                      int iTasks,
+                      AnalyzerResult_t *pxResult);
+
+/*
+ * Shortest whole number of ticks task iTask could have as its period with
+ * every other task unchanged.  An implicit deadline follows the period, a
+ * constrained one is kept unless it would exceed the period.
+ */
+static unsigned long prvShortestPeriod(int iTask);
+/*-----------------------------------------------------------*/
+
+static int prvParseLine(char *pcLine)
+{
+    char *pcField[7];
+    char *pcSave = pcLine;
+    AnalyzerTask_t *pxTask = NULL;
+    unsigned long ulPeriod, ulDeadline, ulResponse, ulExecution;
+    int iFields = 0;
+    int i;
+
+    /* Split the line at tabs, the name itself has no tabs in it. */
+    while ((iFields < 7) && (pcSave != NULL))
+    {
+        pcField[iFields] = pcSave;
+        iFields++;
+        pcSave = strchr(pcSave, '\t');
+
+        if (pcSave != NULL)
+        {
+            *pcSave = '\0';
+            pcSave++;
+        }
+    }
+
+    if ((iFields < 7) || (strcmp(pcField[0], "J") != 0))
+    {
+        return 0;
+    }
+
+    /* Names padded with spaces, as in the stats table, match unpadded ones. */
+    for (i = (int)strlen(pcField[1]); (i > 0) && (pcField[1][i - 1] == ' '); i--)
+    {
+        pcField[1][i - 1] = '\0';
+    }
+
+    ulPeriod = strtoul(pcField[2], NULL, 10);
+    ulDeadline = strtoul(pcField[3], NULL, 10);
+    ulResponse = strtoul(pcField[5], NULL, 10);
+    ulExecution = strtoul(pcField[6], NULL, 10);
+
+    if (ulPeriod == 0UL)
+    {
+        /* Not a periodic or sporadic task. */
+        return 0;
+    }
+
+    for (i = 0; i < iNumberOfTasks; i++)
+    {
+        if (strncmp(xTasks[i].cName, pcField[1], analyzerMAX_NAME_LEN - 1) == 0)
+        {
+            pxTask = &(xTasks[i]);
+            break;
+        }
+    }
+
+    if (pxTask == NULL)
+    {
+        if (iNumberOfTasks == analyzerMAX_TASKS)
+        {
+            fprintf(stderr, "edf_analyzer: more than %d tasks, %s ignored\n", analyzerMAX_TASKS, pcField[1]);
+            return 0;
+        }
+
+        pxTask = &(xTasks[iNumberOfTasks]);
+        iNumberOfTasks++;
+        memset(pxTask, 0, sizeof(*pxTask));
+        strncpy(pxTask->cName, pcField[1], analyzerMAX_NAME_LEN - 1);
+    }
+
+    /* Elastic tasks change period, the latest one is what they run at. */
+    pxTask->ulPeriod = ulPeriod;
+    pxTask->ulDeadline = ((ulDeadline == 0UL) || (ulDeadline > ulPeriod)) ? ulPeriod : ulDeadline;
+    pxTask->ulJobs++;
+    pxTask->dTotalExecution += (double)ulExecution;
+
+    if (ulExecution > pxTask->ulMaxExecution)
+    {
+        pxTask->ulMaxExecution = ulExecution;
+    }
+
+    if (ulResponse > pxTask->ulMaxResponse)
+    {
+        pxTask->ulMaxResponse = ulResponse;
+    }
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
+
+static double prvDemand(const AnalyzerTask_t *pxTaskSet,
+                        int iTasks,
+                        double dInterval)
+{
+    double dDemand = 0.0;
+    double dJobs;
+    int i;
+
+    for (i = 0; i < iTasks; i++)
+    {
+        if (dInterval >= (double)pxTaskSet[i].ulDeadline)
+        {
+            /* Jobs released and due within the interval. */
+            dJobs = (double)((unsigned long)((dInterval - (double)pxTaskSet[i].ulDeadline) / (double)pxTaskSet[i].ulPeriod)) + 1.0;
+            dDemand += dJobs * pxTaskSet[i].dWCET;
+        }
+    }
+
+    return dDemand;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckDeadlines(const AnalyzerTask_t *pxTaskSet,
+                              int iTasks,
+                              double dFrom,
+                              double dTo,
+                              AnalyzerResult_t *pxResult)
+{
+    double dDeadline;
+    double dDemand;
+    int i;
+
+    /* The demand only steps up at absolute deadlines, so those are the only
+     * intervals where t / dbf(t) can reach a new minimum. */
+    for (i = 0; i < iTasks; i++)
+    {
+        dDeadline = (double)pxTaskSet[i].ulDeadline;
+
+        if (dDeadline <= dFrom)
+        {
+            dDeadline += (double)((unsigned long)((dFrom - dDeadline) / (double)pxTaskSet[i].ulPeriod) + 1UL) *
+                         (double)pxTaskSet[i].ulPeriod;
+        }
+
+        for ( ; dDeadline <= dTo; dDeadline += (double)pxTaskSet[i].ulPeriod)
+        {
+            dDemand = prvDemand(pxTaskSet, iTasks, dDeadline);
+
+            if ((dDemand > 0.0) && ((dDeadline / dDemand) < pxResult->dScale))
+            {
+                pxResult->dScale = dDeadline / dDemand;
+                pxResult->dCriticalInterval = dDeadline;
+                pxResult->dCriticalDemand = dDemand;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvAnalyze(const AnalyzerTask_t *pxTaskSet,
+                      int iTasks,
+                      AnalyzerResult_t *pxResult)
+{
+    double dHyperperiod = 1.0;
+    double dMaxDeadline = 0.0;
+    double dBlocking = 0.0;
+    double dRepeat;
+    double dChecked;
+    double dBound;
+    double dA, dB;
+    int i;
+
+    memset(pxResult, 0, sizeof(*pxResult));
+
+    for (i = 0; i < iTasks; i++)
+    {
+        pxResult->dUtilisation += pxTaskSet[i].dWCET / (double)pxTaskSet[i].ulPeriod;
+        dBlocking += (double)(pxTaskSet[i].ulPeriod - pxTaskSet[i].ulDeadline) *
+                     (pxTaskSet[i].dWCET / (double)pxTaskSet[i].ulPeriod);
+
+        if ((double)pxTaskSet[i].ulDeadline > dMaxDeadline)
+        {
+            dMaxDeadline = (double)pxTaskSet[i].ulDeadline;
+        }
+
+        /* Least common multiple of the periods, given up on once it is past
+         * anything that would be checked. */
+        if (dHyperperiod <= analyzerMAX_INTERVAL)
+        {
+            dA = dHyperperiod;
+            dB = (double)pxTaskSet[i].ulPeriod;
+
+            while (dB > 0.0)
+            {
+                dRepeat = dA - ((double)((unsigned long)(dA / dB)) * dB);
+                dA = dB;
+                dB = dRepeat;
+            }
+
+            dHyperperiod = (dHyperperiod / dA) * (double)pxTaskSet[i].ulPeriod;
+        }
+    }
+
+    /* In the long run demand grows at the utilisation. */
+    pxResult->dScale = 1.0 / pxResult->dUtilisation;
+
+    /* Demand one hyperperiod later is the same plus U * H, so its ratio to
+     * the interval lies between the earlier ratio and 1 / U.  Nothing past
+     * the first hyperperiod and the longest deadline needs to be checked. */
+    dRepeat = dHyperperiod + dMaxDeadline;
+
+    if (dRepeat > analyzerMAX_INTERVAL)
+    {
+        dRepeat = analyzerMAX_INTERVAL;
+    }
+
+    /* When the WCETs are scaled by a with a * U < 1, dbf(t) <= t can only
+     * fail before the bound of Baruah, Rosier and Howell,
+     * a * sum((T - D) * U_i) / (1 - a * U).  Check up to the bound for the
+     * unscaled set, then up to the bound for the scale found, which can only
+     * be lower than the one it was found with. */
+    dChecked = 0.0;
+
+    for (i = 0; i < 2; i++)
+    {
+        dA = (i == 0) ? 1.0 : pxResult->dScale;
+        dBound = dRepeat;
+
+        if ((dA * pxResult->dUtilisation) < 1.0)
+        {
+            dBound = (dA * dBlocking) / (1.0 - (dA * pxResult->dUtilisation));
+
+            if (dBound < dMaxDeadline)
+            {
+                dBound = dMaxDeadline;
+            }
+
+            if (dBound > dRepeat)
+            {
+                dBound = dRepeat;
+            }
+        }
+
+        if (dBound > dChecked)
+        {
+            prvCheckDeadlines(pxTaskSet, iTasks, dChecked, dBound, pxResult);
+            dChecked = dBound;
+        }
+    }
+
+    if ((dChecked < (dHyperperiod + dMaxDeadline)) && (dChecked >= analyzerMAX_INTERVAL))
+    {
+        pxResult->iTruncated = 1;
+    }
+
+    return (pxResult->dScale >= 1.0) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvShortestPeriod(int iTask)
+{
+    AnalyzerTask_t xTrial[analyzerMAX_TASKS];
+    AnalyzerResult_t xResult;
+    const int iImplicit = (xTasks[iTask].ulDeadline == xTasks[iTask].ulPeriod) ? 1 : 0;
+    unsigned long ulLow, ulHigh, ulMid;
+
+    memcpy(xTrial, xTasks, sizeof(xTrial[0]) * (size_t)iNumberOfTasks);
+
+    /* No period can be shorter than one job. */
+    ulLow = (unsigned long)xTasks[iTask].dWCET;
+
+    if ((double)ulLow < xTasks[iTask].dWCET)
+    {
+        ulLow++;
+    }
+
+    if (ulLow == 0UL)
+    {
+        ulLow = 1UL;
+    }
+
+    ulHigh = xTasks[iTask].ulPeriod;
+
+    /* Demand only grows as the period shrinks, so search for the shortest
+     * period that is still schedulable. */
+    while (ulLow < ulHigh)
+    {
+        ulMid = ulLow + ((ulHigh - ulLow) / 2UL);
+        xTrial[iTask].ulPeriod = ulMid;
+
+        if ((iImplicit != 0) || (xTrial[iTask].ulDeadline > ulMid))
+        {
+            xTrial[iTask].ulDeadline = ulMid;
+        }
+        else
+        {
+            xTrial[iTask].ulDeadline = xTasks[iTask].ulDeadline;
+        }
+
+        if (prvAnalyze(xTrial, iNumberOfTasks, &xResult) != 0)
+        {
+            ulHigh = ulMid;
+        }
+        else
+        {
+            ulLow = ulMid + 1UL;
+        }
+    }
+
+    return ulHigh;
+}
+/*-----------------------------------------------------------*/
+
+int main(int argc,
+         char **argv)
+{
+    char cLine[analyzerMAX_LINE_LEN];
+    FILE *pxFile = stdin;
+    const char *pcFileName = NULL;
+    double dCountsPerTick = 1.0;
+    double dMargin = 0.0;
+    unsigned long ulRecords = 0UL;
+    unsigned long ulShortest;
+    AnalyzerResult_t xResult;
+    int iSchedulable;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-r") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            dCountsPerTick = strtod(argv[i], NULL);
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && ((i + 1) < argc))
+        {
+            i++;
+            dMargin = strtod(argv[i], NULL);
+        }
+        else if ((argv[i][0] != '-') && (pcFileName == NULL))
+        {
+            pcFileName = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-r counts_per_tick] [-m margin_percent] [trace_file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if ((dCountsPerTick <= 0.0) || (dMargin < 0.0))
+    {
+        fprintf(stderr, "edf_analyzer: counts per tick must be positive and the margin not negative\n");
+        return 2;
+    }
+
+    if (pcFileName != NULL)
+    {
+        pxFile = fopen(pcFileName, "r");
+
+        if (pxFile == NULL)
+        {
+            perror(pcFileName);
+            return 2;
+        }
+    }
+
+    while (fgets(cLine, (int)sizeof(cLine), pxFile) != NULL)
+    {
+        cLine[strcspn(cLine, "\r\n")] = '\0';
+        ulRecords += (unsigned long)prvParseLine(cLine);
+    }
+
+    if (pxFile != stdin)
+    {
+        fclose(pxFile);
+    }
+
+    if (iNumberOfTasks == 0)
+    {
+        fprintf(stderr, "edf_analyzer: no job records found\n");
+        return 2;
+    }
+
+    for (i = 0; i < iNumberOfTasks; i++)
+    {
+        xTasks[i].dWCET = ((double)xTasks[i].ulMaxExecution / dCountsPerTick) * (1.0 + (dMargin / 100.0));
+    }
+
+    printf("%lu jobs of %d tasks, WCET = largest execution time seen + %.1f%%\n\n", ulRecords, iNumberOfTasks, dMargin);
+    printf("%-*s %8s %8s %8s %10s %10s %10s %8s\n", analyzerMAX_NAME_LEN / 2, "Task", "Period", "Deadline", "Jobs",
+           "AvgExec", "WCET", "MaxResp", "Util%");
+
+    for (i = 0; i < iNumberOfTasks; i++)
+    {
+        printf("%-*s %8lu %8lu %8lu %10.3f %10.3f %10lu %8.2f\n", analyzerMAX_NAME_LEN / 2, xTasks[i].cName,
+               xTasks[i].ulPeriod, xTasks[i].ulDeadline, xTasks[i].ulJobs,
+               (xTasks[i].dTotalExecution / (double)xTasks[i].ulJobs) / dCountsPerTick, xTasks[i].dWCET,
+               xTasks[i].ulMaxResponse, (100.0 * xTasks[i].dWCET) / (double)xTasks[i].ulPeriod);
+    }
+
+    for (i = 0; (i < iNumberOfTasks) && (xTasks[i].ulMaxExecution == 0UL); i++)
+    {
+    }
+
+    if (i == iNumberOfTasks)
+    {
+        printf("\nNo execution time was recorded, is the run time counter running?\n");
+        return 2;
+    }
+
+    iSchedulable = prvAnalyze(xTasks, iNumberOfTasks, &xResult);
+
+    printf("\nUtilisation: %.2f%%\n", 100.0 * xResult.dUtilisation);
+
+    if (iSchedulable != 0)
+    {
+        printf("Schedulable: yes, every WCET can grow by %.2f%% before a deadline can be missed\n",
+               100.0 * (xResult.dScale - 1.0));
+    }
+    else
+    {
+        printf("Schedulable: NO, every WCET must shrink by %.2f%% for all deadlines to be met\n",
+               100.0 * (1.0 - xResult.dScale));
+    }
+
+    if (xResult.dCriticalInterval > 0.0)
+    {
+        printf("Critical interval: [0, %.0f] ticks, demand %.3f ticks, slack %.3f ticks\n",
+               xResult.dCriticalInterval, xResult.dCriticalDemand,
+               xResult.dCriticalInterval - xResult.dCriticalDemand);
+    }
+    else
+    {
+        printf("Critical interval: none shorter than the long run, the utilisation is the limit\n");
+    }
+
+    if (xResult.iTruncated != 0)
+    {
+        printf("Warning: deadlines after %.0f ticks were not checked\n", analyzerMAX_INTERVAL);
+    }
+
+    if (iSchedulable != 0)
+    {
+        printf("\nShortest period of each task with the others unchanged:\n");
+
+        for (i = 0; i < iNumberOfTasks; i++)
+        {
+            ulShortest = prvShortestPeriod(i);
+            printf("%-*s %8lu -> %8lu ticks (%.1f%% shorter)\n", analyzerMAX_NAME_LEN / 2, xTasks[i].cName,
+                   xTasks[i].ulPeriod, ulShortest,
+                   (100.0 * (double)(xTasks[i].ulPeriod - ulShortest)) / (double)xTasks[i].ulPeriod);
+        }
+    }
+
+    return (iSchedulable != 0) ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/*
+ * Kernel configuration of the EDF fuzzer, see edf_fuzz.c.
+ *
+ * The scheduler options follow the firmware's FreeRTOSConfig.h, so the fuzzer
+ * runs the same paths through tasks.c as the target.  The hardware specific
+ * parts are replaced by the host simulation port, and the hooks and trace
+ * macros feed the reference model in edf_fuzz.c.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                1
+#define configUSE_IDLE_HOOK                 1
+#define configUSE_TICK_HOOK                 1
+#define configCPU_CLOCK_HZ                  ((unsigned long)60000000)
+#define configTICK_RATE_HZ                  ((TickType_t)1000)
+#define configMAX_PRIORITIES                (4)
+#define configMINIMAL_STACK_SIZE            ((unsigned short)90)
+#define configTOTAL_HEAP_SIZE               ((size_t)64 * 1024)
+#define configMAX_TASK_NAME_LEN             (8)
+#define configUSE_TRACE_FACILITY            1
+#define configUSE_16_BIT_TICKS              0
+#define configIDLE_SHOULD_YIELD             1
+#define configQUEUE_REGISTRY_SIZE           0
+
+#define INCLUDE_vTaskPrioritySet            1
+#define INCLUDE_uxTaskPriorityGet           1
+#define INCLUDE_vTaskDelete                 1
+#define INCLUDE_vTaskCleanUpResources       0
+#define INCLUDE_vTaskSuspend                1
+#define INCLUDE_vTaskDelayUntil             1
+#define INCLUDE_vTaskDelay                  1
+#define INCLUDE_eTaskGetState               1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+#define configUSE_EDF_SCHEDULER             1
+#define configUSE_STATS_FORMATTING_FUNCTIONS 1
+#define configUSE_APPLICATION_TASK_TAG      1
+
+/* The fuzzer creates at most fuzzMAX_TASKS tasks, each once, plus the idle
+ * task. */
+#define configUSE_TASK_SLAB_ALLOCATOR       1
+#define configTASK_SLAB_TCBS                8
+#define configTASK_SLAB_SMALL_STACK_DEPTH   100
+#define configTASK_SLAB_SMALL_STACKS        8
+#define configTASK_SLAB_LARGE_STACK_DEPTH   200
+#define configTASK_SLAB_LARGE_STACKS        2
+
+#define configUSE_JOB_HISTOGRAMS            1
+#define configJOB_HISTOGRAM_SUB_BUCKET_BITS 2
+#define configJOB_HISTOGRAM_BUCKETS         24
+#define configJOB_TRACE_LENGTH              16
+
+/* The run time counter counts simulated microseconds, see port.c. */
+#define configGENERATE_RUN_TIME_STATS       1
+#define configRUN_TIME_COUNTER_TYPE         uint64_t
+#define configRUN_TIME_COUNTER_HZ           1000000UL
+extern configRUN_TIME_COUNTER_TYPE ulPortRunTimeCounter;
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()    (ulPortRunTimeCounter)
+
+/* Build with -DconfigUSE_SWITCH_PROFILER=1 to time the phases of each context
+ * switch, in host nanoseconds, see port.c. */
+#ifndef configUSE_SWITCH_PROFILER
+#define configUSE_SWITCH_PROFILER           0
+#endif
+extern uint32_t ulPortProfilerCycles(void);
+#define portPROFILER_GET_CYCLES()           ulPortProfilerCycles()
+/*-----------------------------------------------------------*/
+
+/* A failed assertion is reported like a divergence from the model. */
+extern void vFuzzAssertCalled(const char *pcFile,
+                              unsigned long ulLine);
+#define configASSERT(x)                     \
+    if ((x) == 0)                           \
+    {                                       \
+        vFuzzAssertCalled(__FILE__, __LINE__); \
+    }
+
+/* Every task the kernel switches in is checked against the model. */
+extern void vFuzzTaskSwitchedIn(void *pvTask);
+#define traceTASK_SWITCHED_IN()             vFuzzTaskSwitchedIn(pxCurrentTCB)
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,1620 @@
+/*
+ * Randomised test of the EDF scheduler in tasks.c against a reference model.
+ *
+ * Each trial generates a task set from a seed.  There are periodic tasks, some
+ * with a release offset and some created later by another task, and sporadic
+ * tasks.  Every task owns a queue.  In each job a task makes a scripted
+ * sequence of calls: it does simulated work, calls vTaskDelay(), creates,
+ * deletes, suspends and resumes other tasks, sends to queues, receives from
+ * its own queue with a timeout, and releases sporadic tasks.  It ends the job
+ * with xTaskDelayUntilNextPeriod() or xTaskWaitForRelease().
+ *
+ * The trial runs on the host simulation port in port.c, through the kernel
+ * itself, with a reference model of EDF stepped alongside it.  The model is
+ * checked at every context switch, before every call and every tick of work,
+ * and after every call returns:
+ *
+ *  - the task switched in, or running, must be ready in the model and have the
+ *    earliest deadline of the ready jobs.  Jobs with equal deadlines may run in
+ *    either order;
+ *  - the idle task may only run while no job is ready;
+ *  - eTaskGetState() of every other task must match the model;
+ *  - return values, and the wake time kept by xTaskDelayUntilNextPeriod(),
+ *    must match the model;
+ *  - no job in the job trace may have run for longer than its response time.
+ *
+ * The model follows these rules:
+ *
+ *  - the deadline of a job is its release time plus the relative deadline of
+ *    the task, which is the period of a periodic task;
+ *  - a task whose block time runs out waiting for its next period, or for a
+ *    deferred sporadic release, starts a new job on that tick;
+ *  - a task woken from vTaskDelay(), by a queue send or by its queue timeout
+ *    keeps the deadline of its job;
+ *  - a resumed task keeps the deadline of its job if the job had not
+ *    completed.  A task that was waiting for its next period resumes into the
+ *    period it should be in: it waits for the next period boundary, and the
+ *    releases missed while it was suspended are skipped;
+ *  - sporadic releases follow xTaskReleaseSporadic() and xTaskWaitForRelease()
+ *    in edf_scheduler.h.
+ *
+ * A trial that diverges from the model, fails a kernel assertion, crashes or
+ * hangs is shrunk by removing tasks, jobs, calls and ticks for as long as the
+ * same kind of failure remains.  The smallest failing trial is printed as a
+ * reproducer, followed by the last events before the failure.  Save the
+ * reproducer to a file and pass it to -r to run it again.
+ *
+ * Build on the host against a FreeRTOS V10.5.1 kernel for include/, list.c and
+ * queue.c, it is not part of the firmware:
+ *
+ *     cc -std=gnu99 -O2 -o edf_fuzz -Itools/edf_fuzz -I. -I$KERNEL/include \
+ *         tools/edf_fuzz/edf_fuzz.c tools/edf_fuzz/port.c tasks.c \
+ *         load_generator.c $KERNEL/list.c $KERNEL/queue.c
+ *
+ * Usage:
+ *
+ *     edf_fuzz [-s seed] [-n trials] [-t ticks] [-c calls] [-r reproducer]
+ *
+ * Trial i uses seed + i (the default seed is 1, 1000 trials of 1000 ticks).
+ * -c lists the calls the scripts may contain, by their letter in a
+ * reproducer, all of "wdcxsrqgp" by default.  Exits with 1 if a trial failed,
+ * 2 on a usage error.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "edf_scheduler.h"
+#include "load_generator.h"
+
+#define fuzzMAX_TASKS           6
+#define fuzzMAX_JOBS            4  /* Scripts per task, job n runs script n % jobs. */
+#define fuzzMAX_CALLS           6  /* Calls per script. */
+#define fuzzMAX_QUEUE_LENGTH    3
+#define fuzzMAX_LINE_LEN        256
+#define fuzzLOG_LENGTH          24
+#define fuzzLOG_LINE_LEN        96
+
+/* Work is done a tick at a time, so the model is checked between ticks. */
+#define fuzzTICK_US             (1000000UL / configTICK_RATE_HZ)
+
+/* A trial that runs for longer than this has hung. */
+#define fuzzTIMEOUT_SECONDS     10U
+
+/* Calls a script may contain, with the weight each is generated with. */
+#define fuzzALL_CALLS           "wdcxsrqgp"
+static const char cCallWeights[] = "wwwwwwddccxssrrqqqgggppp";
+
+/* Outcome of a trial, also the exit status of the process that runs it. */
+typedef enum
+{
+    eFuzzPass = 0,
+    eFuzzOrder = 10, /* A task ran that is not ready or not the earliest deadline. */
+    eFuzzIdle,       /* The idle task ran while a job was ready. */
+    eFuzzState,      /* eTaskGetState() differs from the model. */
+    eFuzzReturn,     /* A call returned a different value. */
+    eFuzzTrace,      /* A job trace record is impossible. */
+    eFuzzAssert,     /* configASSERT() failed. */
+    eFuzzCrash,      /* Killed by a signal. */
+    eFuzzHang        /* Did not finish within fuzzTIMEOUT_SECONDS. */
+} eFuzzResult;
+
+typedef struct xFUZZ_CALL
+{
+    char cCall;      /* Letter of the call, see prvRunCall(). */
+    uint8_t ucArg;   /* Ticks, or the index of the task called on. */
+} FuzzCall_t;
+
+typedef struct xFUZZ_JOB
+{
+    UBaseType_t uxCalls;
+    FuzzCall_t xCalls[fuzzMAX_CALLS];
+} FuzzJob_t;
+
+typedef struct xFUZZ_TASK
+{
+    BaseType_t xPresent;      /* pdFALSE if the task is not in the trial. */
+    BaseType_t xSporadic;
+    BaseType_t xAtStart;      /* Created before the scheduler starts, otherwise by a 'c' call. */
+    TickType_t xPeriod;       /* Minimum inter-arrival time of a sporadic task. */
+    TickType_t xDeadline;     /* Relative, the period of a periodic task. */
+    TickType_t xOffset;
+    UBaseType_t uxPriority;   /* Not used by EDF, but random so a decision taken by priority shows. */
+    UBaseType_t uxQueueLength;
+    UBaseType_t uxJobs;
+    FuzzJob_t xJobs[fuzzMAX_JOBS];
+} FuzzTask_t;
+
+typedef struct xFUZZ_TRIAL
+{
+    unsigned long ulSeed;
+    TickType_t xTicks;
+    FuzzTask_t xTasks[fuzzMAX_TASKS];
+} FuzzTrial_t;
+
+/* What a trial that failed reported. */
+typedef struct xFUZZ_REPORT
+{
+    eFuzzResult eResult;
+    TickType_t xTick;
+    char cMessage[fuzzMAX_LINE_LEN];
+} FuzzReport_t;
+
+/* The state of a task in the model. */
+typedef enum
+{
+    eModelDormant = 0, /* Not created yet. */
+    eModelReady,       /* Ready or running. */
+    eModelDelayed,     /* In vTaskDelay(). */
+    eModelPeriod,      /* Waiting for its next period. */
+    eModelQueue,       /* Blocked on its queue. */
+    eModelRelease,     /* Sporadic, waiting to be released. */
+    eModelDeferred,    /* Sporadic, released before its minimum inter-arrival time. */
+    eModelSuspended,
+    eModelDeleted
+} eModelState;
+
+typedef struct xMODEL_TASK
+{
+    eModelState eState;
+    eModelState eSuspendedFrom;   /* The state a suspended task resumes from. */
+    TickType_t xRelease;
+    TickType_t xDeadline;         /* Absolute. */
+    TickType_t xWake;             /* When a Blocked state times out. */
+    TickType_t xPreviousWakeTime; /* The task's copy, for xTaskDelayUntilNextPeriod(). */
+    BaseType_t xResync;           /* Periods were skipped, the next wake time follows the release. */
+    BaseType_t xReceiving;        /* In xQueueReceive(), which checks the queue again when switched in. */
+    BaseType_t xResult;           /* Expected return value of the blocking call in progress. */
+    UBaseType_t uxPendingReleases;
+    UBaseType_t uxItems;          /* On the queue of the task. */
+} ModelTask_t;
+
+static const char *const pcStateNames[] =
+{
+    "not created", "ready", "delayed", "waiting for its next period", "blocked on its queue",
+    "waiting for a release", "deferred", "suspended", "deleted"
+};
+
+static const char *const pcResultNames[] =
+{
+    "wrong task ran", "idle ran", "wrong state", "wrong return value", "wrong job trace", "assertion failed", "crashed", "hung"
+};
+
+/* State of the trial running in this process. */
+static FuzzTrial_t xTrial;
+static ModelTask_t xModel[fuzzMAX_TASKS];
+static TaskHandle_t xHandles[fuzzMAX_TASKS];
+static QueueHandle_t xQueues[fuzzMAX_TASKS];
+static TickType_t xNow = 0U;
+static int iReportPipe = -1;
+static BaseType_t xVerbose = pdFALSE;
+static char cLog[fuzzLOG_LENGTH][fuzzLOG_LINE_LEN];
+static unsigned long ulLogged = 0UL;
+
+/* Generator state. */
+static uint32_t ulRandomState;
+
+/*
+ * Random number in [0, ulRange).
+ */
+static uint32_t prvRandom(uint32_t ulRange);
+
+/*
+ * Fill *pxTrial from ulSeed, with scripts made of the calls in pcCalls.
+ */
+static void prvGenerate(FuzzTrial_t *pxTrial,
+                        unsigned long ulSeed,
+                        TickType_t xTicks,
+                        const char *pcCalls);
+
+/*
+ * Run *pxTrial in a child process.  *pxReport says how it ended.  With xShow
+ * set the child prints its log if it fails.
+ */
+static eFuzzResult prvRunTrial(const FuzzTrial_t *pxTrial,
+                               BaseType_t xShow,
+                               FuzzReport_t *pxReport);
+
+/*
+ * Shrink *pxTrial for as long as it fails with the same result.
+ */
+static void prvMinimise(FuzzTrial_t *pxTrial,
+                        FuzzReport_t *pxReport);
+
+/*
+ * Write *pxTrial as a reproducer, which prvReadTrial() reads back.
+ */
+static void prvWriteTrial(FILE *pxFile,
+                          const FuzzTrial_t *pxTrial,
+                          const FuzzReport_t *pxReport);
+static int prvReadTrial(FILE *pxFile,
+                        FuzzTrial_t *pxTrial);
+
+/*
+ * The body of every task of a trial.
+ */
+static void prvFuzzTask(void *pvParameters);
+
+/*
+ * Make call *pxCall from task uxTask.
+ */
+static void prvRunCall(UBaseType_t uxTask,
+                       const FuzzCall_t *pxCall);
+
+/*
+ * End the trial with eResult.  Does not return.
+ */
+static void prvFail(eFuzzResult eResult,
+                    const char *pcFormat,
+                    ...);
+
+/*
+ * Add a line to the log of the last events, printed if the trial fails.
+ */
+static void prvLog(const char *pcFormat,
+                   ...);
+
+/*
+ * Checks against the model.
+ */
+static void prvCheckRunning(UBaseType_t uxTask,
+                            const char *pcWhere);
+static void prvCheckEarliest(UBaseType_t uxTask,
+                             const char *pcWhere);
+static void prvCheckIdle(const char *pcWhere);
+static void prvCheckStates(UBaseType_t uxRunning);
+static void prvCheckJobTrace(void);
+static void prvCheckReturn(UBaseType_t uxTask,
+                           const char *pcCall,
+                           BaseType_t xReturned);
+
+/*
+ * Model updates, made just before the kernel is called.
+ */
+static void prvModelRelease(UBaseType_t uxTask,
+                            TickType_t xReleaseTime);
+static void prvModelCreate(UBaseType_t uxTask);
+static void prvModelResume(UBaseType_t uxTask);
+static BaseType_t prvModelSend(UBaseType_t uxTask);
+static BaseType_t prvModelReleaseSporadic(UBaseType_t uxTask);
+static void prvModelReceiveAgain(UBaseType_t uxTask);
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom(uint32_t ulRange)
+{
+    /* xorshift32, as in load_generator.c. */
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return (uint32_t)(((uint64_t)ulRandomState * (uint64_t)ulRange) >> 32);
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerate(FuzzTrial_t *pxTrial,
+                        unsigned long ulSeed,
+                        TickType_t xTicks,
+                        const char *pcCalls)
+{
+    char cWeights[sizeof(cCallWeights)];
+    UBaseType_t uxTasks, uxTask, uxJob, uxCall, uxWeights = 0U;
+    UBaseType_t uxLater[fuzzMAX_TASKS], uxSporadic[fuzzMAX_TASKS];
+    UBaseType_t uxLaterTasks = 0U, uxSporadicTasks = 0U;
+    FuzzTask_t *pxTask;
+    FuzzCall_t *pxCall;
+    size_t x;
+
+    memset(pxTrial, 0x00, sizeof(FuzzTrial_t));
+    pxTrial->ulSeed = ulSeed;
+    pxTrial->xTicks = xTicks;
+
+    /* Mixing the seed keeps neighbouring seeds apart, and xorshift never
+     * leaves 0. */
+    ulRandomState = (uint32_t)(ulSeed * 2654435761UL) ^ 0x9E3779B9UL;
+
+    if (ulRandomState == 0UL)
+    {
+        ulRandomState = 1UL;
+    }
+
+    for (x = 0; x < strlen(cCallWeights); x++)
+    {
+        if (strchr(pcCalls, cCallWeights[x]) != NULL)
+        {
+            cWeights[uxWeights++] = cCallWeights[x];
+        }
+    }
+
+    uxTasks = 2U + (UBaseType_t)prvRandom(fuzzMAX_TASKS - 1U);
+
+    for (uxTask = 0U; uxTask < uxTasks; uxTask++)
+    {
+        pxTask = &(pxTrial->xTasks[uxTask]);
+        pxTask->xPresent = pdTRUE;
+        pxTask->xSporadic = ((uxTask > 0U) && (prvRandom(4U) == 0U)) ? pdTRUE : pdFALSE;
+        pxTask->xAtStart = ((uxTask == 0U) || (prvRandom(4U) != 0U)) ? pdTRUE : pdFALSE;
+        pxTask->uxPriority = (UBaseType_t)prvRandom(configMAX_PRIORITIES);
+        pxTask->uxQueueLength = 1U + (UBaseType_t)prvRandom(fuzzMAX_QUEUE_LENGTH);
+
+        if (pxTask->xSporadic != pdFALSE)
+        {
+            pxTask->xPeriod = 5U + prvRandom(56U);
+            pxTask->xDeadline = 3U + prvRandom(pxTask->xPeriod - 2U);
+            uxSporadic[uxSporadicTasks++] = uxTask;
+        }
+        else
+        {
+            /* A few periods are longer than the 200 ticks the idle task was
+             * created with. */
+            pxTask->xPeriod = (prvRandom(8U) == 0U) ? (150U + prvRandom(251U)) : (5U + prvRandom(56U));
+            pxTask->xDeadline = pxTask->xPeriod;
+            pxTask->xOffset = (prvRandom(3U) == 0U) ? prvRandom(pxTask->xPeriod) : 0U;
+        }
+
+        if (pxTask->xAtStart == pdFALSE)
+        {
+            uxLater[uxLaterTasks++] = uxTask;
+        }
+    }
+
+    for (uxTask = 0U; uxTask < uxTasks; uxTask++)
+    {
+        pxTask = &(pxTrial->xTasks[uxTask]);
+        pxTask->uxJobs = 1U + (UBaseType_t)prvRandom(fuzzMAX_JOBS);
+
+        for (uxJob = 0U; uxJob < pxTask->uxJobs; uxJob++)
+        {
+            pxTask->xJobs[uxJob].uxCalls = (uxWeights == 0U) ? 0U : (UBaseType_t)prvRandom(fuzzMAX_CALLS + 1U);
+
+            for (uxCall = 0U; uxCall < pxTask->xJobs[uxJob].uxCalls; uxCall++)
+            {
+                pxCall = &(pxTask->xJobs[uxJob].xCalls[uxCall]);
+                pxCall->cCall = cWeights[prvRandom(uxWeights)];
+
+                switch (pxCall->cCall)
+                {
+                    case 'w':
+                        pxCall->ucArg = (uint8_t)(1U + prvRandom(3U));
+                        break;
+
+                    case 'd':
+                        pxCall->ucArg = (uint8_t)(1U + prvRandom(5U));
+                        break;
+
+                    case 'g':
+                        pxCall->ucArg = (uint8_t)(1U + prvRandom(8U));
+                        break;
+
+                    case 'c':
+                        if (uxLaterTasks == 0U)
+                        {
+                            pxCall->cCall = 'w';
+                            pxCall->ucArg = 1U;
+                        }
+                        else
+                        {
+                            pxCall->ucArg = (uint8_t)uxLater[prvRandom(uxLaterTasks)];
+                        }
+                        break;
+
+                    case 'p':
+                        pxCall->ucArg = (uint8_t)((uxSporadicTasks == 0U) ? prvRandom(uxTasks) : uxSporadic[prvRandom(uxSporadicTasks)]);
+                        break;
+
+                    default:
+                        /* Any task, including the caller. */
+                        pxCall->ucArg = (uint8_t)prvRandom(uxTasks);
+                        break;
+                }
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLog(const char *pcFormat,
+                   ...)
+{
+    char *pcLine = cLog[ulLogged % fuzzLOG_LENGTH];
+    va_list xArgs;
+    int iLength;
+
+    iLength = snprintf(pcLine, fuzzLOG_LINE_LEN, "%6lu  ", (unsigned long)xNow);
+
+    va_start(xArgs, pcFormat);
+    (void)vsnprintf(&(pcLine[iLength]), (size_t)(fuzzLOG_LINE_LEN - iLength), pcFormat, xArgs);
+    va_end(xArgs);
+
+    ulLogged++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFail(eFuzzResult eResult,
+                    const char *pcFormat,
+                    ...)
+{
+    FuzzReport_t xReport;
+    unsigned long ulLine;
+    va_list xArgs;
+
+    memset(&xReport, 0x00, sizeof(xReport));
+    xReport.eResult = eResult;
+    xReport.xTick = xNow;
+
+    va_start(xArgs, pcFormat);
+    (void)vsnprintf(xReport.cMessage, sizeof(xReport.cMessage), pcFormat, xArgs);
+    va_end(xArgs);
+
+    if (iReportPipe >= 0)
+    {
+        (void)!write(iReportPipe, &xReport, sizeof(xReport));
+    }
+
+    if (xVerbose != pdFALSE)
+    {
+        printf("\nLast events before tick %lu, %s: %s\n", (unsigned long)xNow, pcResultNames[eResult - eFuzzOrder], xReport.cMessage);
+
+        for (ulLine = (ulLogged > fuzzLOG_LENGTH) ? (ulLogged - fuzzLOG_LENGTH) : 0UL; ulLine < ulLogged; ulLine++)
+        {
+            printf("%s\n", cLog[ulLine % fuzzLOG_LENGTH]);
+        }
+
+        fflush(stdout);
+    }
+
+    _exit((int)eResult);
+}
+/*-----------------------------------------------------------*/
+
+void vFuzzAssertCalled(const char *pcFile,
+                       unsigned long ulLine)
+{
+    prvFail(eFuzzAssert, "configASSERT() failed at %s:%lu", pcFile, ulLine);
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvTaskIndex(const void *pvTask)
+{
+    UBaseType_t uxTask;
+
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        if ((xHandles[uxTask] != NULL) && ((const void *)xHandles[uxTask] == pvTask))
+        {
+            break;
+        }
+    }
+
+    if (uxTask == fuzzMAX_TASKS)
+    {
+        prvFail(eFuzzOrder, "a task the model does not know ran");
+    }
+
+    return uxTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckEarliest(UBaseType_t uxTask,
+                             const char *pcWhere)
+{
+    UBaseType_t uxOther;
+
+    for (uxOther = 0U; uxOther < fuzzMAX_TASKS; uxOther++)
+    {
+        if ((xModel[uxOther].eState == eModelReady) && (xModel[uxOther].xDeadline < xModel[uxTask].xDeadline))
+        {
+            prvFail(eFuzzOrder, "T%u (deadline %lu) %s while T%u is ready with the earlier deadline %lu",
+                    (unsigned)uxTask, (unsigned long)xModel[uxTask].xDeadline, pcWhere,
+                    (unsigned)uxOther, (unsigned long)xModel[uxOther].xDeadline);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckIdle(const char *pcWhere)
+{
+    UBaseType_t uxTask;
+
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        if (xModel[uxTask].eState == eModelReady)
+        {
+            prvFail(eFuzzIdle, "the idle task %s while T%u is ready with deadline %lu",
+                    pcWhere, (unsigned)uxTask, (unsigned long)xModel[uxTask].xDeadline);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStates(UBaseType_t uxRunning)
+{
+    UBaseType_t uxTask;
+    eTaskState eExpected, eActual;
+
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        switch (xModel[uxTask].eState)
+        {
+            case eModelDormant:
+            case eModelDeleted:
+                continue;
+
+            case eModelReady:
+                eExpected = eReady;
+                break;
+
+            case eModelSuspended:
+                eExpected = eSuspended;
+                break;
+
+            default:
+                eExpected = eBlocked;
+                break;
+        }
+
+        if (uxTask == uxRunning)
+        {
+            continue;
+        }
+
+        eActual = eTaskGetState(xHandles[uxTask]);
+
+        if (eActual != eExpected)
+        {
+            prvFail(eFuzzState, "T%u is %s but eTaskGetState() returned %d, not %d",
+                    (unsigned)uxTask, pcStateNames[xModel[uxTask].eState], (int)eActual, (int)eExpected);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckJobTrace(void)
+{
+    TaskJobRecord_t xRecord;
+
+    /* The run time counter only advances with the tick, so a job cannot run
+     * for longer than the ticks from its release to its completion. */
+    while (xTaskJobTraceRead(&xRecord) == pdPASS)
+    {
+        if ((uint64_t)xRecord.ulExecutionTime >
+            ((uint64_t)xRecord.xResponseTime * (configRUN_TIME_COUNTER_HZ / configTICK_RATE_HZ)))
+        {
+            prvFail(eFuzzTrace, "the job released on %lu ran for %lu counts in %lu ticks",
+                    (unsigned long)xRecord.xReleaseTime, (unsigned long)xRecord.ulExecutionTime,
+                    (unsigned long)xRecord.xResponseTime);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckRunning(UBaseType_t uxTask,
+                            const char *pcWhere)
+{
+    if ((xModel[uxTask].eState != eModelReady) || (xModel[uxTask].xReceiving != pdFALSE))
+    {
+        prvFail(eFuzzOrder, "T%u is running %s but is %s", (unsigned)uxTask, pcWhere,
+                (xModel[uxTask].xReceiving != pdFALSE) ? "still in xQueueReceive()" : pcStateNames[xModel[uxTask].eState]);
+    }
+
+    prvCheckEarliest(uxTask, "is running");
+    prvCheckStates(uxTask);
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckReturn(UBaseType_t uxTask,
+                           const char *pcCall,
+                           BaseType_t xReturned)
+{
+    prvCheckRunning(uxTask, "after a call");
+
+    if (xReturned != xModel[uxTask].xResult)
+    {
+        prvFail(eFuzzReturn, "%s in T%u returned %ld, not %ld", pcCall, (unsigned)uxTask,
+                (long)xReturned, (long)xModel[uxTask].xResult);
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vFuzzTaskSwitchedIn(void *pvTask)
+{
+    UBaseType_t uxTask;
+
+    if (pvTask == (void *)xTaskGetIdleTaskHandle())
+    {
+        prvLog("idle switched in");
+        prvCheckIdle("was switched in");
+    }
+    else
+    {
+        uxTask = prvTaskIndex(pvTask);
+        prvLog("T%u switched in, deadline %lu", (unsigned)uxTask, (unsigned long)xModel[uxTask].xDeadline);
+
+        if (xModel[uxTask].eState != eModelReady)
+        {
+            prvFail(eFuzzOrder, "T%u was switched in but is %s", (unsigned)uxTask, pcStateNames[xModel[uxTask].eState]);
+        }
+
+        prvCheckEarliest(uxTask, "was switched in");
+
+        if (xModel[uxTask].xReceiving != pdFALSE)
+        {
+            prvModelReceiveAgain(uxTask);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook(void)
+{
+    UBaseType_t uxTask;
+    ModelTask_t *pxModel;
+
+    xNow++;
+
+    if (xNow != xTaskGetTickCountFromISR())
+    {
+        prvFail(eFuzzState, "the tick count is %lu", (unsigned long)xTaskGetTickCountFromISR());
+    }
+
+    /* A task whose block time runs out is ready again.  Only one waiting
+     * for its next period, or for a deferred release, starts a new job. */
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        pxModel = &(xModel[uxTask]);
+
+        if (((pxModel->eState == eModelDelayed) || (pxModel->eState == eModelPeriod) ||
+             (pxModel->eState == eModelQueue) || (pxModel->eState == eModelDeferred)) &&
+            (pxModel->xWake == xNow))
+        {
+            prvLog("T%u woken from %s", (unsigned)uxTask, pcStateNames[pxModel->eState]);
+
+            if ((pxModel->eState == eModelPeriod) || (pxModel->eState == eModelDeferred))
+            {
+                prvModelRelease(uxTask, xNow);
+            }
+
+            pxModel->eState = eModelReady;
+        }
+    }
+
+    if (xNow >= xTrial.xTicks)
+    {
+        vTaskEndScheduler();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook(void)
+{
+    prvCheckIdle("is running");
+    prvCheckStates(fuzzMAX_TASKS);
+    prvCheckJobTrace();
+    vPortSimulateTicks(1U);
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelRelease(UBaseType_t uxTask,
+                            TickType_t xReleaseTime)
+{
+    xModel[uxTask].xRelease = xReleaseTime;
+    xModel[uxTask].xDeadline = xReleaseTime + xTrial.xTasks[uxTask].xDeadline;
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelCreate(UBaseType_t uxTask)
+{
+    const FuzzTask_t *const pxTask = &(xTrial.xTasks[uxTask]);
+    ModelTask_t *const pxModel = &(xModel[uxTask]);
+
+    if (pxTask->xSporadic != pdFALSE)
+    {
+        /* The first release is never deferred. */
+        pxModel->eState = eModelRelease;
+        pxModel->xRelease = xNow - pxTask->xPeriod;
+    }
+    else if (pxTask->xOffset != 0U)
+    {
+        pxModel->eState = eModelPeriod;
+        pxModel->xWake = xNow + pxTask->xOffset;
+    }
+    else
+    {
+        pxModel->eState = eModelReady;
+        prvModelRelease(uxTask, xNow);
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelResume(UBaseType_t uxTask)
+{
+    const TickType_t xPeriod = xTrial.xTasks[uxTask].xPeriod;
+    ModelTask_t *const pxModel = &(xModel[uxTask]);
+    TickType_t xNext;
+
+    pxModel->eState = eModelReady;
+
+    if (pxModel->eSuspendedFrom == eModelPeriod)
+    {
+        /* The first period boundary from now. */
+        xNext = pxModel->xWake;
+
+        if (xNext < xNow)
+        {
+            xNext += ((xNow - xNext + xPeriod - 1U) / xPeriod) * xPeriod;
+            pxModel->xResync = pdTRUE;
+        }
+
+        if (xNext == xNow)
+        {
+            prvModelRelease(uxTask, xNow);
+        }
+        else
+        {
+            pxModel->eState = eModelPeriod;
+            pxModel->xWake = xNext;
+        }
+    }
+
+    /* Otherwise the job carries on with its deadline, and a receiver checks
+     * its queue again. */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvModelSend(UBaseType_t uxTask)
+{
+    ModelTask_t *const pxReceiver = &(xModel[uxTask]);
+    BaseType_t xReturn = errQUEUE_FULL;
+
+    if (pxReceiver->uxItems < xTrial.xTasks[uxTask].uxQueueLength)
+    {
+        pxReceiver->uxItems++;
+        xReturn = pdPASS;
+
+        if (pxReceiver->eState == eModelQueue)
+        {
+            /* Woken with the deadline it has. */
+            pxReceiver->eState = eModelReady;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelReceiveAgain(UBaseType_t uxTask)
+{
+    ModelTask_t *const pxModel = &(xModel[uxTask]);
+
+    if (pxModel->uxItems > 0U)
+    {
+        pxModel->uxItems--;
+        pxModel->xResult = pdPASS;
+        pxModel->xReceiving = pdFALSE;
+    }
+    else if (xNow >= pxModel->xWake)
+    {
+        pxModel->xResult = errQUEUE_EMPTY;
+        pxModel->xReceiving = pdFALSE;
+    }
+    else
+    {
+        /* Resumed with the queue still empty, it blocks for the rest of its
+         * timeout. */
+        pxModel->eState = eModelQueue;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvModelReleaseSporadic(UBaseType_t uxTask)
+{
+    ModelTask_t *const pxModel = &(xModel[uxTask]);
+    BaseType_t xReturn = pdPASS;
+
+    if (pxModel->eState == eModelRelease)
+    {
+        pxModel->xResult = pdPASS;
+
+        if ((TickType_t)(xNow - pxModel->xRelease) >= xTrial.xTasks[uxTask].xPeriod)
+        {
+            pxModel->eState = eModelReady;
+            prvModelRelease(uxTask, xNow);
+        }
+        else
+        {
+            pxModel->eState = eModelDeferred;
+            pxModel->xWake = pxModel->xRelease + xTrial.xTasks[uxTask].xPeriod;
+        }
+    }
+    else if (pxModel->uxPendingReleases < 0xFFU)
+    {
+        pxModel->uxPendingReleases++;
+    }
+    else
+    {
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunCall(UBaseType_t uxTask,
+                       const FuzzCall_t *pxCall)
+{
+    const UBaseType_t uxArg = (UBaseType_t)pxCall->ucArg;
+    ModelTask_t *const pxModel = &(xModel[uxTask]);
+    ModelTask_t *pxTarget = NULL;
+    const FuzzTask_t *pxTargetTask = NULL;
+    TaskHandle_t xTarget;
+    BaseType_t xReturn;
+    uint32_t ulItem = 0UL;
+    UBaseType_t uxTick;
+
+    if ((pxCall->cCall != 'w') && (pxCall->cCall != 'd') && (pxCall->cCall != 'g'))
+    {
+        if ((uxArg >= fuzzMAX_TASKS) || (xTrial.xTasks[uxArg].xPresent == pdFALSE))
+        {
+            /* The task was removed from the trial. */
+            return;
+        }
+
+        pxTarget = &(xModel[uxArg]);
+        pxTargetTask = &(xTrial.xTasks[uxArg]);
+    }
+
+    prvCheckRunning(uxTask, "before a call");
+
+    switch (pxCall->cCall)
+    {
+        case 'w':
+            for (uxTick = 0U; uxTick < uxArg; uxTick++)
+            {
+                if (uxTick > 0U)
+                {
+                    prvCheckRunning(uxTask, "in its work");
+                }
+
+                vLoadGeneratorRun(fuzzTICK_US);
+            }
+            break;
+
+        case 'd':
+            prvLog("T%u vTaskDelay(%u)", (unsigned)uxTask, (unsigned)uxArg);
+            pxModel->eState = eModelDelayed;
+            pxModel->xWake = xNow + uxArg;
+            vTaskDelay(uxArg);
+            break;
+
+        case 'c':
+            if (pxTarget->eState == eModelDormant)
+            {
+                prvLog("T%u creates T%u", (unsigned)uxTask, (unsigned)uxArg);
+                prvModelCreate(uxArg);
+                pxModel->xResult = pdPASS;
+
+                if (pxTargetTask->xSporadic != pdFALSE)
+                {
+                    xReturn = xSporadicTaskCreate(prvFuzzTask, "T", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)uxArg,
+                                                  pxTargetTask->uxPriority, &(xHandles[uxArg]),
+                                                  pxTargetTask->xPeriod, pxTargetTask->xDeadline);
+                }
+                else
+                {
+                    xReturn = xPeriodicTaskCreateWithOffset(prvFuzzTask, "T", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)uxArg,
+                                                            pxTargetTask->uxPriority, &(xHandles[uxArg]),
+                                                            pxTargetTask->xPeriod, pxTargetTask->xOffset);
+                }
+
+                prvCheckReturn(uxTask, "task create", xReturn);
+            }
+            break;
+
+        case 'x':
+            if ((pxTarget->eState != eModelDormant) && (pxTarget->eState != eModelDeleted))
+            {
+                prvLog("T%u deletes T%u", (unsigned)uxTask, (unsigned)uxArg);
+                pxTarget->eState = eModelDeleted;
+                xTarget = xHandles[uxArg];
+                xHandles[uxArg] = NULL;
+                vTaskDelete((uxArg == uxTask) ? NULL : xTarget);
+            }
+            break;
+
+        case 's':
+            if ((pxTargetTask->xSporadic == pdFALSE) && (pxTarget->eState != eModelDormant) &&
+                (pxTarget->eState != eModelDeleted) && (pxTarget->eState != eModelSuspended))
+            {
+                prvLog("T%u suspends T%u (%s)", (unsigned)uxTask, (unsigned)uxArg, pcStateNames[pxTarget->eState]);
+                pxTarget->eSuspendedFrom = pxTarget->eState;
+                pxTarget->eState = eModelSuspended;
+                vTaskSuspend((uxArg == uxTask) ? NULL : xHandles[uxArg]);
+            }
+            break;
+
+        case 'r':
+            if (pxTarget->eState == eModelSuspended)
+            {
+                prvLog("T%u resumes T%u", (unsigned)uxTask, (unsigned)uxArg);
+                prvModelResume(uxArg);
+                vTaskResume(xHandles[uxArg]);
+            }
+            break;
+
+        case 'q':
+            prvLog("T%u sends to the queue of T%u", (unsigned)uxTask, (unsigned)uxArg);
+            pxModel->xResult = prvModelSend(uxArg);
+            xReturn = xQueueSend(xQueues[uxArg], &ulItem, 0U);
+            prvCheckReturn(uxTask, "xQueueSend()", xReturn);
+            break;
+
+        case 'g':
+            prvLog("T%u receives, timeout %u", (unsigned)uxTask, (unsigned)uxArg);
+
+            if (pxModel->uxItems > 0U)
+            {
+                pxModel->uxItems--;
+                pxModel->xResult = pdPASS;
+            }
+            else
+            {
+                pxModel->eState = eModelQueue;
+                pxModel->xWake = xNow + uxArg;
+                pxModel->xReceiving = pdTRUE;
+            }
+
+            xReturn = xQueueReceive(xQueues[uxTask], &ulItem, uxArg);
+            prvCheckReturn(uxTask, "xQueueReceive()", xReturn);
+            break;
+
+        case 'p':
+            if ((pxTargetTask->xSporadic != pdFALSE) && (pxTarget->eState != eModelDormant) &&
+                (pxTarget->eState != eModelDeleted))
+            {
+                prvLog("T%u releases T%u", (unsigned)uxTask, (unsigned)uxArg);
+                pxModel->xResult = prvModelReleaseSporadic(uxArg);
+                xReturn = xTaskReleaseSporadic(xHandles[uxArg]);
+                prvCheckReturn(uxTask, "xTaskReleaseSporadic()", xReturn);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFuzzTask(void *pvParameters)
+{
+    const UBaseType_t uxTask = (UBaseType_t)(uintptr_t)pvParameters;
+    const FuzzTask_t *const pxTask = &(xTrial.xTasks[uxTask]);
+    ModelTask_t *const pxModel = &(xModel[uxTask]);
+    TickType_t xPreviousWakeTime = xTaskGetTickCount();
+    const FuzzJob_t *pxJob;
+    UBaseType_t uxJob, uxCall;
+    BaseType_t xReturn;
+
+    pxModel->xPreviousWakeTime = xPreviousWakeTime;
+
+    for (uxJob = 0U;; uxJob++)
+    {
+        if (pxTask->uxJobs > 0U)
+        {
+            pxJob = &(pxTask->xJobs[uxJob % pxTask->uxJobs]);
+
+            for (uxCall = 0U; uxCall < pxJob->uxCalls; uxCall++)
+            {
+                prvRunCall(uxTask, &(pxJob->xCalls[uxCall]));
+            }
+        }
+
+        prvCheckRunning(uxTask, "at the end of its job");
+
+        if (pxTask->xSporadic != pdFALSE)
+        {
+            prvLog("T%u waits for a release", (unsigned)uxTask);
+            pxModel->xResult = pdPASS;
+
+            if (pxModel->uxPendingReleases == 0U)
+            {
+                pxModel->eState = eModelRelease;
+            }
+            else
+            {
+                pxModel->uxPendingReleases--;
+
+                if ((TickType_t)(xNow - pxModel->xRelease) >= pxTask->xPeriod)
+                {
+                    prvModelRelease(uxTask, xNow);
+                }
+                else
+                {
+                    pxModel->eState = eModelDeferred;
+                    pxModel->xWake = pxModel->xRelease + pxTask->xPeriod;
+                }
+            }
+
+            xReturn = xTaskWaitForRelease();
+            prvCheckReturn(uxTask, "xTaskWaitForRelease()", xReturn);
+        }
+        else
+        {
+            prvLog("T%u waits for its next period", (unsigned)uxTask);
+
+            if (pxModel->xResync != pdFALSE)
+            {
+                pxModel->xResync = pdFALSE;
+                pxModel->xPreviousWakeTime = pxModel->xRelease;
+            }
+
+            pxModel->xPreviousWakeTime += pxTask->xPeriod;
+
+            if (pxModel->xPreviousWakeTime > xNow)
+            {
+                pxModel->eState = eModelPeriod;
+                pxModel->xWake = pxModel->xPreviousWakeTime;
+                pxModel->xResult = pdTRUE;
+            }
+            else
+            {
+                /* Overrunning, the next job is already due. */
+                prvModelRelease(uxTask, pxModel->xPreviousWakeTime);
+                pxModel->xResult = pdFALSE;
+            }
+
+            xReturn = xTaskDelayUntilNextPeriod(&xPreviousWakeTime);
+            prvCheckReturn(uxTask, "xTaskDelayUntilNextPeriod()", xReturn);
+
+            if (xPreviousWakeTime != pxModel->xPreviousWakeTime)
+            {
+                prvFail(eFuzzReturn, "the wake time of T%u is %lu, not %lu", (unsigned)uxTask,
+                        (unsigned long)xPreviousWakeTime, (unsigned long)pxModel->xPreviousWakeTime);
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTrialMain(void)
+{
+    const FuzzTask_t *pxTask;
+    UBaseType_t uxTask;
+    BaseType_t xReturn;
+
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        if (xTrial.xTasks[uxTask].xPresent != pdFALSE)
+        {
+            xQueues[uxTask] = xQueueCreate(xTrial.xTasks[uxTask].uxQueueLength, sizeof(uint32_t));
+            configASSERT(xQueues[uxTask]);
+        }
+    }
+
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        pxTask = &(xTrial.xTasks[uxTask]);
+
+        if ((pxTask->xPresent != pdFALSE) && (pxTask->xAtStart != pdFALSE))
+        {
+            prvModelCreate(uxTask);
+
+            if (pxTask->xSporadic != pdFALSE)
+            {
+                xReturn = xSporadicTaskCreate(prvFuzzTask, "T", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)uxTask,
+                                              pxTask->uxPriority, &(xHandles[uxTask]), pxTask->xPeriod, pxTask->xDeadline);
+            }
+            else
+            {
+                xReturn = xPeriodicTaskCreateWithOffset(prvFuzzTask, "T", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)uxTask,
+                                                        pxTask->uxPriority, &(xHandles[uxTask]), pxTask->xPeriod, pxTask->xOffset);
+            }
+
+            configASSERT(xReturn == pdPASS);
+        }
+    }
+
+    /* Returns when vApplicationTickHook() ends the trial. */
+    vTaskStartScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static eFuzzResult prvRunTrial(const FuzzTrial_t *pxTrial,
+                               BaseType_t xShow,
+                               FuzzReport_t *pxReport)
+{
+    int iPipe[2];
+    int iStatus;
+    pid_t xChild;
+    ssize_t xRead;
+
+    memset(pxReport, 0x00, sizeof(FuzzReport_t));
+
+    if (pipe(iPipe) != 0)
+    {
+        perror("pipe");
+        exit(2);
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    xChild = fork();
+
+    if (xChild < 0)
+    {
+        perror("fork");
+        exit(2);
+    }
+
+    if (xChild == 0)
+    {
+        /* Each trial starts from a fresh copy of the kernel's state. */
+        close(iPipe[0]);
+        iReportPipe = iPipe[1];
+        xVerbose = xShow;
+        xTrial = *pxTrial;
+        alarm(fuzzTIMEOUT_SECONDS);
+        prvTrialMain();
+        _exit(eFuzzPass);
+    }
+
+    close(iPipe[1]);
+    xRead = read(iPipe[0], pxReport, sizeof(FuzzReport_t));
+    close(iPipe[0]);
+    (void)waitpid(xChild, &iStatus, 0);
+
+    if (WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == eFuzzPass))
+    {
+        pxReport->eResult = eFuzzPass;
+    }
+    else if (xRead != (ssize_t)sizeof(FuzzReport_t))
+    {
+        /* Nothing was reported, the child died. */
+        pxReport->xTick = pxTrial->xTicks;
+
+        if (WIFSIGNALED(iStatus) && (WTERMSIG(iStatus) == SIGALRM))
+        {
+            pxReport->eResult = eFuzzHang;
+            snprintf(pxReport->cMessage, sizeof(pxReport->cMessage), "no result after %u seconds", fuzzTIMEOUT_SECONDS);
+        }
+        else
+        {
+            pxReport->eResult = eFuzzCrash;
+            snprintf(pxReport->cMessage, sizeof(pxReport->cMessage), "exit status 0x%x", (unsigned)iStatus);
+        }
+    }
+
+    return pxReport->eResult;
+}
+/*-----------------------------------------------------------*/
+
+/* Keep *pxCandidate if it still fails as *pxReport did. */
+static BaseType_t prvTryShrink(FuzzTrial_t *pxTrial,
+                               const FuzzTrial_t *pxCandidate,
+                               FuzzReport_t *pxReport)
+{
+    FuzzReport_t xReport;
+    BaseType_t xReturn = pdFALSE;
+
+    if ((prvRunTrial(pxCandidate, pdFALSE, &xReport) == pxReport->eResult) && (xReport.xTick <= pxReport->xTick))
+    {
+        *pxTrial = *pxCandidate;
+        *pxReport = xReport;
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMinimise(FuzzTrial_t *pxTrial,
+                        FuzzReport_t *pxReport)
+{
+    FuzzTrial_t xCandidate;
+    FuzzTask_t *pxTask;
+    FuzzJob_t *pxJob;
+    UBaseType_t uxTask, uxJob, uxCall;
+    BaseType_t xShrunk;
+
+    do
+    {
+        xShrunk = pdFALSE;
+
+        /* Nothing after the failing tick matters. */
+        if (pxTrial->xTicks > (pxReport->xTick + 1U))
+        {
+            xCandidate = *pxTrial;
+            xCandidate.xTicks = pxReport->xTick + 1U;
+            xShrunk |= prvTryShrink(pxTrial, &xCandidate, pxReport);
+        }
+
+        for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+        {
+            if (pxTrial->xTasks[uxTask].xPresent != pdFALSE)
+            {
+                xCandidate = *pxTrial;
+                xCandidate.xTasks[uxTask].xPresent = pdFALSE;
+                xShrunk |= prvTryShrink(pxTrial, &xCandidate, pxReport);
+            }
+        }
+
+        for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+        {
+            for (uxJob = 0U; uxJob < pxTrial->xTasks[uxTask].uxJobs; uxJob++)
+            {
+                /* Drop the job. */
+                xCandidate = *pxTrial;
+                pxTask = &(xCandidate.xTasks[uxTask]);
+                memmove(&(pxTask->xJobs[uxJob]), &(pxTask->xJobs[uxJob + 1U]), (pxTask->uxJobs - uxJob - 1U) * sizeof(FuzzJob_t));
+                pxTask->uxJobs--;
+
+                if (prvTryShrink(pxTrial, &xCandidate, pxReport) != pdFALSE)
+                {
+                    xShrunk = pdTRUE;
+                    uxJob--;
+                    continue;
+                }
+
+                for (uxCall = 0U; uxCall < pxTrial->xTasks[uxTask].xJobs[uxJob].uxCalls; uxCall++)
+                {
+                    /* Drop the call. */
+                    xCandidate = *pxTrial;
+                    pxJob = &(xCandidate.xTasks[uxTask].xJobs[uxJob]);
+                    memmove(&(pxJob->xCalls[uxCall]), &(pxJob->xCalls[uxCall + 1U]), (pxJob->uxCalls - uxCall - 1U) * sizeof(FuzzCall_t));
+                    pxJob->uxCalls--;
+
+                    if (prvTryShrink(pxTrial, &xCandidate, pxReport) != pdFALSE)
+                    {
+                        xShrunk = pdTRUE;
+                        uxCall--;
+                        continue;
+                    }
+
+                    /* Fewer ticks of work, delay or timeout. */
+                    pxJob = &(pxTrial->xTasks[uxTask].xJobs[uxJob]);
+
+                    if ((strchr("wdg", pxJob->xCalls[uxCall].cCall) != NULL) && (pxJob->xCalls[uxCall].ucArg > 1U))
+                    {
+                        xCandidate = *pxTrial;
+                        xCandidate.xTasks[uxTask].xJobs[uxJob].xCalls[uxCall].ucArg--;
+                        xShrunk |= prvTryShrink(pxTrial, &xCandidate, pxReport);
+                    }
+                }
+            }
+
+            /* Simpler parameters. */
+            pxTask = &(pxTrial->xTasks[uxTask]);
+
+            if ((pxTask->xPresent != pdFALSE) && (pxTask->xOffset != 0U))
+            {
+                xCandidate = *pxTrial;
+                xCandidate.xTasks[uxTask].xOffset = 0U;
+                xShrunk |= prvTryShrink(pxTrial, &xCandidate, pxReport);
+            }
+
+            if ((pxTask->xPresent != pdFALSE) && (pxTask->uxPriority != 0U))
+            {
+                xCandidate = *pxTrial;
+                xCandidate.xTasks[uxTask].uxPriority = 0U;
+                xShrunk |= prvTryShrink(pxTrial, &xCandidate, pxReport);
+            }
+
+            if ((pxTask->xPresent != pdFALSE) && (pxTask->uxQueueLength > 1U))
+            {
+                xCandidate = *pxTrial;
+                xCandidate.xTasks[uxTask].uxQueueLength = 1U;
+                xShrunk |= prvTryShrink(pxTrial, &xCandidate, pxReport);
+            }
+        }
+    } while (xShrunk != pdFALSE);
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteTrial(FILE *pxFile,
+                          const FuzzTrial_t *pxTrial,
+                          const FuzzReport_t *pxReport)
+{
+    const FuzzTask_t *pxTask;
+    const FuzzJob_t *pxJob;
+    UBaseType_t uxTask, uxJob, uxCall;
+
+    fprintf(pxFile, "# edf_fuzz seed %lu, tick %lu, %s: %s\n", pxTrial->ulSeed, (unsigned long)pxReport->xTick,
+            pcResultNames[pxReport->eResult - eFuzzOrder], pxReport->cMessage);
+    fprintf(pxFile, "ticks %lu\n", (unsigned long)pxTrial->xTicks);
+
+    for (uxTask = 0U; uxTask < fuzzMAX_TASKS; uxTask++)
+    {
+        pxTask = &(pxTrial->xTasks[uxTask]);
+
+        if (pxTask->xPresent == pdFALSE)
+        {
+            continue;
+        }
+
+        if (pxTask->xSporadic != pdFALSE)
+        {
+            fprintf(pxFile, "task %u sporadic %lu deadline %lu", (unsigned)uxTask, (unsigned long)pxTask->xPeriod,
+                    (unsigned long)pxTask->xDeadline);
+        }
+        else
+        {
+            fprintf(pxFile, "task %u periodic %lu offset %lu", (unsigned)uxTask, (unsigned long)pxTask->xPeriod,
+                    (unsigned long)pxTask->xOffset);
+        }
+
+        fprintf(pxFile, " priority %u queue %u %s\n", (unsigned)pxTask->uxPriority, (unsigned)pxTask->uxQueueLength,
+                (pxTask->xAtStart != pdFALSE) ? "start" : "later");
+
+        for (uxJob = 0U; uxJob < pxTask->uxJobs; uxJob++)
+        {
+            pxJob = &(pxTask->xJobs[uxJob]);
+            fprintf(pxFile, "job %u", (unsigned)uxTask);
+
+            for (uxCall = 0U; uxCall < pxJob->uxCalls; uxCall++)
+            {
+                fprintf(pxFile, " %c%u", pxJob->xCalls[uxCall].cCall, (unsigned)pxJob->xCalls[uxCall].ucArg);
+            }
+
+            fprintf(pxFile, "\n");
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvReadTrial(FILE *pxFile,
+                        FuzzTrial_t *pxTrial)
+{
+    char cLine[fuzzMAX_LINE_LEN];
+    char *pcToken, *pcValue, *pcSave;
+    FuzzTask_t *pxTask = NULL;
+    FuzzJob_t *pxJob;
+    unsigned long ulValue;
+    unsigned long ulLine = 0UL;
+
+    memset(pxTrial, 0x00, sizeof(FuzzTrial_t));
+    pxTrial->xTicks = 1000U;
+
+    while (fgets(cLine, (int)sizeof(cLine), pxFile) != NULL)
+    {
+        ulLine++;
+        cLine[strcspn(cLine, "#\r\n")] = '\0';
+        pcToken = strtok_r(cLine, " \t", &pcSave);
+
+        if (pcToken == NULL)
+        {
+            continue;
+        }
+
+        if (strcmp(pcToken, "ticks") == 0)
+        {
+            pcToken = strtok_r(NULL, " \t", &pcSave);
+
+            if (pcToken == NULL)
+            {
+                break;
+            }
+
+            pxTrial->xTicks = (TickType_t)strtoul(pcToken, NULL, 10);
+
+            if (pxTrial->xTicks == 0U)
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        if ((strcmp(pcToken, "task") != 0) && (strcmp(pcToken, "job") != 0))
+        {
+            break;
+        }
+
+        pcToken = strtok_r(NULL, " \t", &pcSave);
+        ulValue = (pcToken != NULL) ? strtoul(pcToken, NULL, 10) : fuzzMAX_TASKS;
+
+        if (ulValue >= fuzzMAX_TASKS)
+        {
+            break;
+        }
+
+        pxTask = &(pxTrial->xTasks[ulValue]);
+
+        if (cLine[0] == 'j')
+        {
+            if (pxTask->uxJobs >= fuzzMAX_JOBS)
+            {
+                break;
+            }
+
+            pxJob = &(pxTask->xJobs[pxTask->uxJobs++]);
+
+            while (((pcToken = strtok_r(NULL, " \t", &pcSave)) != NULL) && (pxJob->uxCalls < fuzzMAX_CALLS) &&
+                   (strchr(fuzzALL_CALLS, pcToken[0]) != NULL))
+            {
+                pxJob->xCalls[pxJob->uxCalls].cCall = pcToken[0];
+                pxJob->xCalls[pxJob->uxCalls].ucArg = (uint8_t)strtoul(&(pcToken[1]), NULL, 10);
+                pxJob->uxCalls++;
+            }
+
+            if (pcToken != NULL)
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        pxTask->xPresent = pdTRUE;
+        pxTask->xAtStart = pdTRUE;
+        pxTask->uxQueueLength = 1U;
+
+        while ((pcToken = strtok_r(NULL, " \t", &pcSave)) != NULL)
+        {
+            if ((strcmp(pcToken, "start") == 0) || (strcmp(pcToken, "later") == 0))
+            {
+                pxTask->xAtStart = (pcToken[0] == 's') ? pdTRUE : pdFALSE;
+                continue;
+            }
+
+            pcValue = strtok_r(NULL, " \t", &pcSave);
+
+            if (pcValue == NULL)
+            {
+                break;
+            }
+
+            ulValue = strtoul(pcValue, NULL, 10);
+
+            if ((strcmp(pcToken, "periodic") == 0) || (strcmp(pcToken, "sporadic") == 0))
+            {
+                pxTask->xSporadic = (pcToken[0] == 's') ? pdTRUE : pdFALSE;
+                pxTask->xPeriod = (TickType_t)ulValue;
+                pxTask->xDeadline = (TickType_t)ulValue;
+            }
+            else if (strcmp(pcToken, "deadline") == 0)
+            {
+                pxTask->xDeadline = (TickType_t)ulValue;
+            }
+            else if (strcmp(pcToken, "offset") == 0)
+            {
+                pxTask->xOffset = (TickType_t)ulValue;
+            }
+            else if (strcmp(pcToken, "priority") == 0)
+            {
+                pxTask->uxPriority = (UBaseType_t)ulValue;
+            }
+            else if (strcmp(pcToken, "queue") == 0)
+            {
+                pxTask->uxQueueLength = (UBaseType_t)ulValue;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if ((pcToken != NULL) || (pxTask->xPeriod == 0U) || (pxTask->xDeadline == 0U) ||
+            (pxTask->xOffset >= pxTask->xPeriod) || (pxTask->uxPriority >= configMAX_PRIORITIES) ||
+            (pxTask->uxQueueLength == 0U) || (pxTask->uxQueueLength > fuzzMAX_QUEUE_LENGTH))
+        {
+            break;
+        }
+    }
+
+    if (!feof(pxFile))
+    {
+        fprintf(stderr, "line %lu: not understood\n", ulLine);
+        return -1;
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+int main(int argc,
+         char **argv)
+{
+    FuzzTrial_t xFailed;
+    FuzzReport_t xReport;
+    unsigned long ulSeed = 1UL, ulTrials = 1000UL, ulTrial;
+    TickType_t xTicks = 1000U;
+    const char *pcCalls = fuzzALL_CALLS;
+    const char *pcReproducer = NULL;
+    FILE *pxFile;
+    int iOption;
+
+    while ((iOption = getopt(argc, argv, "s:n:t:c:r:")) != -1)
+    {
+        switch (iOption)
+        {
+            case 's':
+                ulSeed = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'n':
+                ulTrials = strtoul(optarg, NULL, 0);
+                break;
+
+            case 't':
+                xTicks = (TickType_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'c':
+                pcCalls = optarg;
+                break;
+
+            case 'r':
+                pcReproducer = optarg;
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-s seed] [-n trials] [-t ticks] [-c calls] [-r reproducer]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if ((optind != argc) || (xTicks == 0U) || (strspn(pcCalls, fuzzALL_CALLS) != strlen(pcCalls)))
+    {
+        fprintf(stderr, "usage: %s [-s seed] [-n trials] [-t ticks] [-c calls] [-r reproducer]\n", argv[0]);
+        return 2;
+    }
+
+    if (pcReproducer != NULL)
+    {
+        pxFile = fopen(pcReproducer, "r");
+
+        if (pxFile == NULL)
+        {
+            perror(pcReproducer);
+            return 2;
+        }
+
+        iOption = prvReadTrial(pxFile, &xFailed);
+        fclose(pxFile);
+
+        if (iOption != 0)
+        {
+            return 2;
+        }
+
+        if (prvRunTrial(&xFailed, pdTRUE, &xReport) == eFuzzPass)
+        {
+            printf("%s passed\n", pcReproducer);
+            return 0;
+        }
+
+        printf("%s: tick %lu, %s: %s\n", pcReproducer, (unsigned long)xReport.xTick,
+               pcResultNames[xReport.eResult - eFuzzOrder], xReport.cMessage);
+        return 1;
+    }
+
+    for (ulTrial = 0UL; ulTrial < ulTrials; ulTrial++)
+    {
+        prvGenerate(&xFailed, ulSeed + ulTrial, xTicks, pcCalls);
+
+        if (prvRunTrial(&xFailed, pdFALSE, &xReport) != eFuzzPass)
+        {
+            printf("seed %lu failed at tick %lu, %s: %s\nShrinking...\n", ulSeed + ulTrial,
+                   (unsigned long)xReport.xTick, pcResultNames[xReport.eResult - eFuzzOrder], xReport.cMessage);
+            prvMinimise(&xFailed, &xReport);
+            printf("\n");
+            prvWriteTrial(stdout, &xFailed, &xReport);
+            (void)prvRunTrial(&xFailed, pdTRUE, &xReport);
+            return 1;
+        }
+    }
+
+    printf("%lu trials passed\n", ulTrials);
+
+    return 0;
+}
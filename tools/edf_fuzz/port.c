@@ -0,0 +1,233 @@
+/*
+ * Host simulation port used by the EDF fuzzer.
+ *
+ * Each task runs on a host stack of its own and the kernel switches between
+ * them with swapcontext(), so tasks.c runs unmodified.  There is no real clock
+ * and nothing interrupts a task: time only passes when a task calls
+ * vPortSimulateTicks() or vPortSimulateWork(), which run the tick interrupt
+ * once for every tick of execution.  A run therefore takes the same path
+ * through the kernel every time it is repeated.
+ *
+ * Memory comes from the C library, no heap_x.c is needed.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdlib.h>
+#include <time.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "edf_scheduler.h"
+
+/* Host stack of each task.  The FreeRTOS stack is allocated as usual but not
+ * used. */
+#define portSIM_STACK_SIZE    (64U * 1024U)
+
+/* Microseconds in a tick. */
+#define portSIM_TICK_US       (1000000UL / configTICK_RATE_HZ)
+
+/* Where the FreeRTOS stack pointer would be, the first member of a TCB points
+ * to the context of the task instead. */
+typedef struct xSIM_CONTEXT
+{
+    ucontext_t xContext;
+    TaskFunction_t pxCode;
+    void *pvParameters;
+    void *pvStack;
+    UBaseType_t uxCriticalNesting; /*< Saved while the task is switched out. */
+} SimContext_t;
+
+#define prvContextOf(xTask)    (*(SimContext_t **)(xTask))
+
+/* Nesting of the running task. */
+static UBaseType_t uxCriticalNesting = 0U;
+
+/* The context vTaskStartScheduler() was called from, vTaskEndScheduler()
+ * returns to it. */
+static ucontext_t xSchedulerContext;
+
+/* Microseconds of simulated work not yet a whole tick. */
+static uint32_t ulPartialTickUs = 0UL;
+
+/* Run time counter, in microseconds. */
+configRUN_TIME_COUNTER_TYPE ulPortRunTimeCounter = 0U;
+
+#if (configUSE_SWITCH_PROFILER == 1)
+
+/* Profiler cycles when the running task last started to switch out. */
+static uint32_t ulSwitchStartCycles = 0UL;
+
+/* Report the time since ulSwitchStartCycles, once the next task has been
+ * switched in, as the port phase of the switch. */
+#define portPROFILE_SWITCH_START()    ulSwitchStartCycles = portPROFILER_GET_CYCLES()
+#define portPROFILE_SWITCH_END()      vTaskProfilePortSample(portPROFILER_GET_CYCLES() - ulSwitchStartCycles)
+
+#else
+
+#define portPROFILE_SWITCH_START()
+#define portPROFILE_SWITCH_END()
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry(void)
+{
+    SimContext_t *const pxContext = prvContextOf(xTaskGetCurrentTaskHandle());
+
+    /* A task is switched in for the first time here rather than in
+     * vPortYield(). */
+    portPROFILE_SWITCH_END();
+
+    pxContext->pxCode(pxContext->pvParameters);
+
+    /* Tasks must not return. */
+    configASSERT(pdFALSE);
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack,
+                                   TaskFunction_t pxCode,
+                                   void *pvParameters)
+{
+    SimContext_t *pxContext = calloc(1U, sizeof(SimContext_t));
+
+    configASSERT(pxContext);
+    (void)pxTopOfStack;
+
+    pxContext->pxCode = pxCode;
+    pxContext->pvParameters = pvParameters;
+    pxContext->pvStack = malloc(portSIM_STACK_SIZE);
+    configASSERT(pxContext->pvStack);
+
+    (void)getcontext(&(pxContext->xContext));
+    pxContext->xContext.uc_stack.ss_sp = pxContext->pvStack;
+    pxContext->xContext.uc_stack.ss_size = portSIM_STACK_SIZE;
+    pxContext->xContext.uc_link = NULL;
+    makecontext(&(pxContext->xContext), prvTaskEntry, 0);
+
+    return (StackType_t *)pxContext;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB(void *pxTCB)
+{
+    SimContext_t *const pxContext = prvContextOf(pxTCB);
+
+    /* A task that deleted itself is cleaned up by the idle task, so its stack
+     * is no longer in use. */
+    free(pxContext->pvStack);
+    free(pxContext);
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler(void)
+{
+    SimContext_t *const pxFirst = prvContextOf(xTaskGetCurrentTaskHandle());
+
+    uxCriticalNesting = 0U;
+    portPROFILE_SWITCH_START();
+    (void)swapcontext(&xSchedulerContext, &(pxFirst->xContext));
+
+    /* vTaskEndScheduler() was called. */
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler(void)
+{
+    (void)setcontext(&xSchedulerContext);
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield(void)
+{
+    SimContext_t *const pxFrom = prvContextOf(xTaskGetCurrentTaskHandle());
+    SimContext_t *pxTo;
+
+    portPROFILE_SWITCH_START();
+    vTaskSwitchContext();
+    pxTo = prvContextOf(xTaskGetCurrentTaskHandle());
+
+    if (pxTo != pxFrom)
+    {
+        /* Tasks can yield inside a critical section, the nesting goes with
+         * them. */
+        pxFrom->uxCriticalNesting = uxCriticalNesting;
+        uxCriticalNesting = pxTo->uxCriticalNesting;
+        (void)swapcontext(&(pxFrom->xContext), &(pxTo->xContext));
+    }
+
+    /* pxFrom is running again, switched back in by another task. */
+    portPROFILE_SWITCH_END();
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical(void)
+{
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical(void)
+{
+    configASSERT(uxCriticalNesting > 0U);
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateTicks(TickType_t xTicks)
+{
+    /* The tick interrupt is masked in a critical section. */
+    configASSERT(uxCriticalNesting == 0U);
+
+    while (xTicks > (TickType_t)0U)
+    {
+        xTicks--;
+        ulPortRunTimeCounter += (configRUN_TIME_COUNTER_TYPE)portSIM_TICK_US;
+
+        if (xTaskIncrementTick() != pdFALSE)
+        {
+            vPortYield();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateWork(uint32_t ulMicroseconds)
+{
+    /* Work shorter than a tick is carried over to the next call, whichever
+     * task makes it. */
+    ulMicroseconds += ulPartialTickUs;
+    ulPartialTickUs = ulMicroseconds % portSIM_TICK_US;
+    vPortSimulateTicks((TickType_t)(ulMicroseconds / portSIM_TICK_US));
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    return malloc(xWantedSize);
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree(void *pv)
+{
+    free(pv);
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_SWITCH_PROFILER == 1)
+
+uint32_t ulPortProfilerCycles(void)
+{
+    struct timespec xNow;
+
+    /* Host nanoseconds stand in for cycles. */
+    (void)clock_gettime(CLOCK_MONOTONIC, &xNow);
+
+    return (uint32_t)(((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec);
+}
+
+#endif /* configUSE_SWITCH_PROFILER */
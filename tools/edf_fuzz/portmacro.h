@@ -0,0 +1,104 @@
+/*
+ * Port definitions for the host simulation port used by the EDF fuzzer.  See
+ * port.c.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Type definitions. */
+#define portCHAR           char
+#define portFLOAT          float
+#define portDOUBLE         double
+#define portLONG           long
+#define portSHORT          short
+#define portSTACK_TYPE     uintptr_t
+#define portBASE_TYPE      long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if (configUSE_16_BIT_TICKS == 1)
+#error "the EDF fuzzer needs 32 bit ticks"
+#endif
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY              (TickType_t)0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC    1
+
+/* Pointers are 64 bits on most hosts. */
+#define portPOINTER_SIZE_TYPE      uintptr_t
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH       (-1)
+#define portTICK_PERIOD_MS     ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT     8
+#define portNOP()
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities.  There are no interrupts, so a yield from an ISR is the
+ * same as a yield from a task. */
+void vPortYield(void);
+
+#define portYIELD()                                vPortYield()
+#define portEND_SWITCHING_ISR(xSwitchRequired)     \
+    do                                             \
+    {                                              \
+        if ((xSwitchRequired) != pdFALSE)          \
+        {                                          \
+            vPortYield();                          \
+        }                                          \
+    } while (0)
+#define portYIELD_FROM_ISR(x)                      portEND_SWITCHING_ISR(x)
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Only the nesting is counted, nothing can
+ * interrupt a task but its own calls into the port. */
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()                       vPortEnterCritical()
+#define portEXIT_CRITICAL()                        vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()          0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)       (void)(x)
+/*-----------------------------------------------------------*/
+
+/* Each task runs on a host stack allocated by the port, freed with its TCB. */
+void vPortCleanUpTCB(void *pxTCB);
+
+#define portCLEAN_UP_TCB(pxTCB)                    vPortCleanUpTCB(pxTCB)
+/*-----------------------------------------------------------*/
+
+/* Simulated time.  vPortSimulateTicks() is the only way time passes: it runs
+ * the tick interrupt xTicks times, as if the calling task had executed for
+ * that long. */
+void vPortSimulateTicks(TickType_t xTicks);
+void vPortSimulateWork(uint32_t ulMicroseconds);
+
+/* load_generator.c advances the simulated clock instead of spinning. */
+#define portLOAD_GENERATOR_RUN(ulMicroseconds)     vPortSimulateWork(ulMicroseconds)
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters)    void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)          void vFunction(void *pvParameters)
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,159 @@
+/*
+ * Interrupt driven, batched transmit on UART0.  See uart_tx.h for the API.
+ *
+ * Writers and the interrupt share a FreeRTOS stream buffer.  A stream buffer
+ * allows one writer and one reader at a time.  Only tasks write, so writes are
+ * serialised by suspending the scheduler; interrupts stay enabled, and the
+ * stream buffer functions, which may not be called from a critical section,
+ * are not.  The reader is normally the THRE interrupt.  When the transmitter
+ * is idle no THRE interrupt is pending, and xUartTxWrite() loads the first
+ * burst itself with the THRE interrupt masked in U0IER, so the two readers
+ * never overlap.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "lpc21xx.h"
+#include "uart_tx.h"
+
+/* Depth of the UART0 transmit FIFO, the most that can be written to U0THR
+ * per THRE interrupt. */
+#define uarttxFIFO_DEPTH (16)
+
+#define uarttxLSR_THRE (0x20UL)     /* U0THR (and the FIFO) is empty. */
+#define uarttxIER_THRE (0x02UL)     /* THRE interrupt enable. */
+#define uarttxFCR_FIFO_ON (0x07UL)  /* Enable and reset both FIFOs. */
+#define uarttxVIC_CHANNEL (6UL)     /* UART0 interrupt request. */
+#define uarttxVIC_SLOT_ON (0x20UL)  /* Enable bit of a VICVectCntl register. */
+
+/* Bytes waiting to be transmitted. */
+static StreamBufferHandle_t xTxBuffer = NULL;
+
+/* Records that did not fit in xTxBuffer. */
+static volatile uint32_t ulDroppedRecords = 0UL;
+
+/*
+ * Copy a burst of at most uarttxFIFO_DEPTH bytes into the transmit FIFO.
+ */
+static void prvWriteFifo(const uint8_t *pucBurst,
+                         size_t xCount);
+
+/*
+ * UART0 THRE interrupt.  Only ever moves data out of xTxBuffer, and no task
+ * blocks waiting for space in it, so it never needs to request a context
+ * switch and can be a plain __irq function instead of going through the
+ * port's context saving wrapper.
+ */
+static void prvUartTxISR(void) __irq;
+/*-----------------------------------------------------------*/
+
+BaseType_t xUartTxInit(size_t xBufferSize)
+{
+    configASSERT(xTxBuffer == NULL);
+
+    xTxBuffer = xStreamBufferCreate(xBufferSize, (size_t)1);
+
+    if (xTxBuffer == NULL)
+    {
+        return pdFAIL;
+    }
+
+    U0FCR = uarttxFCR_FIFO_ON;
+
+    /* Vectored slot 0 is used by the tick interrupt. */
+    VICVectAddr1 = (unsigned long)prvUartTxISR;
+    VICVectCntl1 = uarttxVIC_SLOT_ON | uarttxVIC_CHANNEL;
+    VICIntEnable = (1UL << uarttxVIC_CHANNEL);
+
+    U0IER |= uarttxIER_THRE;
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xUartTxWrite(const char *pcRecord,
+                        size_t xLength)
+{
+    uint8_t ucBurst[uarttxFIFO_DEPTH];
+    size_t xCount;
+    BaseType_t xReturn;
+
+    configASSERT(xTxBuffer);
+    configASSERT(pcRecord);
+
+    vTaskSuspendAll();
+    {
+        /* Only the interrupt can change the space while the scheduler is
+         * suspended, and it only makes more. */
+        if (xStreamBufferSpacesAvailable(xTxBuffer) >= xLength)
+        {
+            (void)xStreamBufferSend(xTxBuffer, pcRecord, xLength, (TickType_t)0);
+
+            /* An idle transmitter raises no further THRE interrupt, so start
+             * it here.  The interrupt sends the rest.  It is masked while the
+             * FIFO is primed, so it cannot read from the buffer at the same
+             * time.  Nothing else writes U0IER once the scheduler runs. */
+            U0IER &= ~uarttxIER_THRE;
+
+            if ((U0LSR & uarttxLSR_THRE) != 0UL)
+            {
+                xCount = xStreamBufferReceive(xTxBuffer, ucBurst, sizeof(ucBurst), (TickType_t)0);
+                prvWriteFifo(ucBurst, xCount);
+            }
+
+            U0IER |= uarttxIER_THRE;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            ulDroppedRecords++;
+            xReturn = pdFAIL;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulUartTxGetDropCount(void)
+{
+    return ulDroppedRecords;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteFifo(const uint8_t *pucBurst,
+                         size_t xCount)
+{
+    size_t x;
+
+    for (x = 0; x < xCount; x++)
+    {
+        U0THR = pucBurst[x];
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvUartTxISR(void) __irq
+{
+    uint8_t ucBurst[uarttxFIFO_DEPTH];
+    size_t xCount;
+
+    /* Reading U0IIR clears the THRE interrupt. */
+    (void)U0IIR;
+
+    /* xUartTxWrite() may have refilled the FIFO while this interrupt was
+     * pending. */
+    if ((U0LSR & uarttxLSR_THRE) != 0UL)
+    {
+        xCount = xStreamBufferReceiveFromISR(xTxBuffer, ucBurst, sizeof(ucBurst), NULL);
+        prvWriteFifo(ucBurst, xCount);
+    }
+
+    /* Acknowledge the interrupt in the VIC. */
+    VICVectAddr = 0UL;
+}
+/*-----------------------------------------------------------*/
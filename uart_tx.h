@@ -0,0 +1,66 @@
+/*
+ * Interrupt driven, batched transmit on UART0.
+ *
+ * Tasks append records to a stream buffer and return straight away.  The
+ * UART0 transmit holding register empty (THRE) interrupt drains the stream
+ * buffer in bursts of up to one transmit FIFO (16 bytes), so the time a job
+ * spends printing no longer depends on the baud rate.
+ *
+ * The UART itself (pins, baud rate, line format) is still configured by
+ * xSerialPortInitMinimal(), which must be called first.  After
+ * xUartTxInit() all output should go through xUartTxWrite(): polled writes
+ * would interleave with the interrupt driven ones.
+ */
+
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#ifndef INC_TASK_H
+#error "include task.h must appear in source files before include uart_tx.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * BaseType_t xUartTxInit( size_t xBufferSize );
+ *
+ * Create the transmit stream buffer, xBufferSize bytes long, enable the
+ * UART0 FIFOs and install the THRE interrupt handler.  Call once, before the
+ * scheduler is started.
+ *
+ * @return pdPASS, or pdFAIL if there was not enough heap for the buffer.
+ */
+BaseType_t xUartTxInit(size_t xBufferSize);
+
+/**
+ * BaseType_t xUartTxWrite( const char *pcRecord, size_t xLength );
+ *
+ * Queue xLength bytes for transmission.  Never blocks: the record is either
+ * copied into the transmit buffer whole, or dropped and counted if there is
+ * not enough space for it.  Records from different tasks are never
+ * interleaved.  Call from a task, not from an interrupt: writers are
+ * serialised by suspending the scheduler.
+ *
+ * @return pdPASS if the record was queued, pdFAIL if it was dropped.
+ */
+BaseType_t xUartTxWrite(const char *pcRecord,
+                        size_t xLength);
+
+/**
+ * uint32_t ulUartTxGetDropCount( void );
+ *
+ * @return The number of records dropped because the transmit buffer was full.
+ */
+uint32_t ulUartTxGetDropCount(void);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* UART_TX_H */